@@ -0,0 +1,198 @@
+/**
+ * @file bench.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Small self-contained microbenchmark harness
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * A benchmark is written as
+ *
+ * @code
+ * BENCHMARK("square/macro") {
+ *   for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+ *     enpm702::bench::do_not_optimize(SQUARE(x));
+ *   }
+ * }
+ * @endcode
+ *
+ * The harness warms the code up, picks the iteration count so that one
+ * sample lasts long enough to be measured, collects several samples and
+ * reports the median and the p99 time per iteration.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace enpm702::bench {
+
+/**
+ * @brief Force the compiler to materialize a value
+ *
+ * The empty asm statement claims to read @p value, so the computation that
+ * produced it cannot be removed as dead code.
+ *
+ * @param value Value that must be computed
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Overload for non-const lvalues, which may also be modified
+ */
+template <typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__clang__)
+  asm volatile("" : "+r,m"(value) : : "memory");
+#else
+  // GCC rejects "+r,m" ("impossible constraint") on values it has folded
+  // to a constant; with memory first it picks a stack slot instead
+  asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+/**
+ * @brief Force pending writes to memory to be performed
+ *
+ * Acts as a compiler barrier: all memory may have been read or written.
+ */
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+/**
+ * @brief Handle passed to a benchmark body
+ */
+class State {
+ public:
+  explicit State(std::uint64_t iterations) : iterations_{iterations} {}
+
+  /**
+   * @brief Number of times the body must run its operation
+   */
+  std::uint64_t iterations() const { return iterations_; }
+
+  /**
+   * @brief Stop the clock, e.g. around per-sample setup or teardown
+   *
+   * Pausing a clock that is already stopped does nothing, so a body may
+   * return with the clock paused to leave its destructors untimed.
+   */
+  void pause_timing() {
+    if (running_)
+      elapsed_ += std::chrono::steady_clock::now() - start_;
+    running_ = false;
+  }
+
+  /**
+   * @brief Restart the clock after pause_timing()
+   */
+  void resume_timing() {
+    running_ = true;
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * @brief Items processed by one iteration, used to report items/s
+   */
+  void set_items_per_iteration(double items) { items_per_iteration_ = items; }
+
+  /**
+   * @brief Bytes processed by one iteration, used to report MB/s
+   */
+  void set_bytes_per_iteration(double bytes) { bytes_per_iteration_ = bytes; }
+
+  /**
+   * @brief Report an extra value (e.g. resident memory) next to the timings
+   */
+  void set_counter(std::string name, double value) {
+    for (auto& counter : counters_) {
+      if (counter.first == name) {
+        counter.second = value;
+        return;
+      }
+    }
+    counters_.emplace_back(std::move(name), value);
+  }
+
+  /**
+   * @brief Give up on this benchmark, e.g. when its input cannot be created
+   *
+   * The body should return right away; the report shows @p reason instead
+   * of timings.
+   */
+  void skip(std::string reason) { skip_reason_ = std::move(reason); }
+
+  std::chrono::steady_clock::duration elapsed() const { return elapsed_; }
+  const std::string& skip_reason() const { return skip_reason_; }
+  double items_per_iteration() const { return items_per_iteration_; }
+  double bytes_per_iteration() const { return bytes_per_iteration_; }
+  const std::vector<std::pair<std::string, double>>& counters() const {
+    return counters_;
+  }
+
+ private:
+  std::uint64_t iterations_;
+  std::chrono::steady_clock::time_point start_{};
+  std::chrono::steady_clock::duration elapsed_{};
+  bool running_{false};
+  double items_per_iteration_{0.0};
+  double bytes_per_iteration_{0.0};
+  std::vector<std::pair<std::string, double>> counters_;
+  std::string skip_reason_;
+};
+
+/**
+ * @brief Body of a benchmark
+ */
+using BenchmarkFn = std::function<void(State&)>;
+
+/**
+ * @brief Register a benchmark, e.g. one per thread count in a loop
+ *
+ * @param name Name shown in the report and matched by --filter
+ * @param fn Body of the benchmark
+ * @return true Always, so the call can initialize a static variable
+ */
+bool register_benchmark(std::string name, BenchmarkFn fn);
+
+/**
+ * @brief Parse the command line and run the registered benchmarks
+ *
+ * Supported options:
+ * - `--list`: print the benchmark names
+ * - `--filter <text>`: only run benchmarks whose name contains text
+ * - `--min-time <seconds>`: time budget per benchmark (default 0.5)
+ * - `--samples <n>`: number of samples per benchmark (default 15)
+ * - `--csv`: print the results as CSV instead of a table
+ *
+ * @param argc Argument count from main()
+ * @param argv Argument vector from main()
+ * @return int Exit status for main()
+ */
+int run_benchmarks(int argc, char* argv[]);
+
+}  // namespace enpm702::bench
+
+#define ENPM702_BENCH_CONCAT_IMPL(a, b) a##b
+#define ENPM702_BENCH_CONCAT(a, b) ENPM702_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Define and register a benchmark; the body follows the macro and
+ * receives an enpm702::bench::State named `state`
+ */
+#define BENCHMARK(name)                                                    \
+  static void ENPM702_BENCH_CONCAT(benchmark_,                             \
+                                   __LINE__)(enpm702::bench::State&);      \
+  [[maybe_unused]] static const bool ENPM702_BENCH_CONCAT(                 \
+      benchmark_registered_, __LINE__){enpm702::bench::register_benchmark( \
+      name, &ENPM702_BENCH_CONCAT(benchmark_, __LINE__))};                 \
+  static void ENPM702_BENCH_CONCAT(benchmark_, __LINE__)(                  \
+      [[maybe_unused]] enpm702::bench::State & state)
@@ -0,0 +1,81 @@
+/**
+ * @file perf_counters.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Hardware performance counters for the benchmarks
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * A benchmark body can count what the CPU did next to the time it took:
+ *
+ * @code
+ * enpm702::bench::PerfCounters perf;
+ * perf.start();
+ * // ... state.iterations() operations ...
+ * enpm702::bench::PerfSample sample{perf.stop()};
+ * if (perf.available())
+ *   state.set_counter("instr/op", sample.instructions / operations);
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace enpm702::bench {
+
+/**
+ * @brief Counts of one start()/stop() interval, in user space only
+ */
+struct PerfSample {
+  double instructions{0};
+  double cycles{0};
+  double branches{0};
+  double branch_misses{0};
+};
+
+/**
+ * @brief Instructions, cycles, branches and branch misses of the calling
+ * thread, read with perf_event_open(2) on Linux
+ *
+ * The counters need a PMU the kernel lets the process use. In containers,
+ * in most virtual machines or with a high kernel.perf_event_paranoid they
+ * are not available: available() is then false, error() tells why and
+ * stop() returns zeros, so a benchmark can still report its timings.
+ * Counts are scaled up when the kernel had to multiplex the counters.
+ */
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool available() const { return group_ >= 0; }
+
+  /**
+   * @brief Why the counters are not available (empty when they are)
+   */
+  const std::string& error() const { return error_; }
+
+  /**
+   * @brief Reset the counters and start counting
+   */
+  void start();
+
+  /**
+   * @brief Stop counting and return the counts since start()
+   */
+  PerfSample stop();
+
+ private:
+  static constexpr int kEvents{4};
+
+  int group_{-1};  // leader, the instruction counter
+  int fds_[kEvents]{-1, -1, -1, -1};
+  std::string error_;
+};
+
+}  // namespace enpm702::bench
@@ -0,0 +1,101 @@
+/**
+ * @file simd_dispatch.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Run-time choice of the vector instruction set
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * The batch kernels of the lectures (reduce.hpp, partition.hpp and
+ * small_set.hpp of the reading material, power.hpp and convert.hpp of
+ * week 2) have a scalar, an AVX2 and an AVX-512 version, compiled with
+ * `__attribute__((target(...)))` so that the programs are still built for
+ * plain x86-64. Each call picks the widest one the CPU supports, or the one
+ * asked for if it is narrower:
+ *
+ * @code
+ * switch (enpm702::resolve(simd)) {
+ *   case enpm702::SimdLevel::kAvx512: ...
+ * }
+ * @endcode
+ *
+ * Kernels may use everything their level promises: kAvx2 includes FMA and
+ * kAvx512 includes the DQ, BW and VL extensions.
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ENPM702_X86 1
+#endif
+
+/**
+ * Put around AVX-512 kernels: GCC 12 reports the _mm512_undefined_*()
+ * placeholders inside its own intrinsics as uninitialized.
+ */
+#define ENPM702_SIMD_KERNELS_BEGIN                                \
+  _Pragma("GCC diagnostic push")                                  \
+  _Pragma("GCC diagnostic ignored \"-Wuninitialized\"")           \
+  _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define ENPM702_SIMD_KERNELS_END _Pragma("GCC diagnostic pop")
+
+namespace enpm702 {
+
+/**
+ * @brief Instruction set of a batch kernel
+ */
+enum class SimdLevel {
+  kAuto,    ///< the widest supported
+  kScalar,  ///< no vector instructions
+  kAvx2,    ///< AVX2 and FMA (Haswell and later)
+  kAvx512,  ///< AVX-512 F, DQ, BW and VL (Skylake-SP and later)
+};
+
+inline const char* to_string(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return "scalar";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+    default:
+      return "auto";
+  }
+}
+
+/**
+ * @brief The widest level this CPU (and operating system) supports
+ */
+inline SimdLevel detected_simd_level() {
+#ifdef ENPM702_X86
+  static const SimdLevel level{[] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+      return SimdLevel::kAvx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return SimdLevel::kAvx2;
+    return SimdLevel::kScalar;
+  }()};
+  return level;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+/**
+ * @brief The level a kernel runs at when @p requested is asked for
+ */
+inline SimdLevel resolve(SimdLevel requested) {
+  const SimdLevel supported{detected_simd_level()};
+  if (requested == SimdLevel::kAuto)
+    return supported;
+  return std::min(requested, supported);
+}
+
+}  // namespace enpm702
@@ -0,0 +1,142 @@
+/**
+ * @file snippets.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Registry used to run numbered lecture snippets by ID
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Every numbered block of a lecture file is written as
+ *
+ * @code
+ * SNIPPET("16") {
+ *   // snippet body
+ * }
+ * @endcode
+ *
+ * and compiled once into the lecture executable. The snippet to run is
+ * then picked on the command line, e.g. `week3_cpp --run 16` or
+ * `week3_cpp --run all`, instead of uncommenting it and rebuilding.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace enpm702 {
+
+/**
+ * @brief Properties of a snippet that change how `--run all` treats it
+ */
+enum SnippetFlag : unsigned {
+  kSnippetDefault = 0U,
+  kSnippetInteractive = 1U << 0,  // reads from std::cin
+  kSnippetUndefined = 1U << 1,    // demonstrates undefined behavior
+};
+
+/**
+ * @brief Function generated by the SNIPPET macro for each snippet
+ */
+using SnippetFn = void (*)();
+
+/**
+ * @brief A registered snippet
+ */
+struct Snippet {
+  std::string_view id;
+  SnippetFn fn;
+  unsigned flags;
+};
+
+/**
+ * @brief Helper so that SNIPPET can be used with or without flags
+ *
+ * @param flags Bitwise OR of SnippetFlag values
+ * @return unsigned The flags unchanged
+ */
+constexpr unsigned snippet_flags(unsigned flags = kSnippetDefault) {
+  return flags;
+}
+
+/**
+ * @brief Process-wide list of snippets, kept in declaration order
+ */
+class SnippetRegistry {
+ public:
+  /**
+   * @brief Access the registry of the current executable
+   *
+   * @return SnippetRegistry& The unique registry
+   */
+  static SnippetRegistry& instance();
+
+  /**
+   * @brief Register a snippet
+   *
+   * @param id Identifier used with --run (e.g. "16" or "8-1")
+   * @param fn Function holding the snippet body
+   * @param flags Bitwise OR of SnippetFlag values
+   * @return true Always, so the call can initialize a static variable
+   */
+  bool add(std::string_view id, SnippetFn fn, unsigned flags);
+
+  /**
+   * @brief Look up a snippet by identifier
+   *
+   * @param id Identifier passed to --run
+   * @return const Snippet* The snippet or nullptr if it does not exist
+   */
+  const Snippet* find(std::string_view id) const;
+
+  /**
+   * @brief All snippets in declaration order
+   */
+  const std::vector<Snippet>& snippets() const { return snippets_; }
+
+ private:
+  SnippetRegistry() = default;
+  std::vector<Snippet> snippets_;
+};
+
+/**
+ * @brief Parse the command line and run the requested snippets
+ *
+ * Supported options:
+ * - `--list`: print the registered snippets
+ * - `--run <id>[,<id>...]`: run the given snippets in order
+ * - `--run all`: run every snippet that is neither interactive nor UB
+ * - `--time`: report the wall time of each snippet on std::cerr
+ * - `--input <file>`: file read by the batch snippets instead of std::cin
+ *
+ * @param argc Argument count from main()
+ * @param argv Argument vector from main()
+ * @param default_id Snippet to run when no --run option is given
+ * @return int Exit status for main()
+ */
+int run_snippets(int argc, char* argv[], std::string_view default_id = {});
+
+/**
+ * @brief File given with `--input`, or an empty view to read std::cin
+ */
+std::string_view snippet_input();
+
+}  // namespace enpm702
+
+#define ENPM702_CONCAT_IMPL(a, b) a##b
+#define ENPM702_CONCAT(a, b) ENPM702_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Define and register a snippet; the body follows the macro
+ *
+ * The optional second argument is a bitwise OR of enpm702::SnippetFlag.
+ */
+#define SNIPPET(id, ...)                                                   \
+  static void ENPM702_CONCAT(snippet_, __LINE__)();                        \
+  [[maybe_unused]] static const bool ENPM702_CONCAT(snippet_registered_,   \
+                                                    __LINE__){             \
+      enpm702::SnippetRegistry::instance().add(                            \
+          id, &ENPM702_CONCAT(snippet_, __LINE__),                         \
+          enpm702::snippet_flags(__VA_ARGS__))};                           \
+  static void ENPM702_CONCAT(snippet_, __LINE__)()
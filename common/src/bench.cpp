@@ -0,0 +1,279 @@
+/**
+ * @file bench.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Implementation of the microbenchmark harness
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace enpm702::bench {
+
+namespace {
+
+struct Benchmark {
+  std::string name;
+  BenchmarkFn fn;
+};
+
+struct Options {
+  std::string filter;
+  double min_time{0.5};  // seconds spent measuring each benchmark
+  double warmup_time{0.1};
+  int samples{15};
+  bool csv{false};
+};
+
+struct Result {
+  std::string name;
+  std::uint64_t iterations{};  // iterations per sample
+  int samples{};
+  double median_ns{};  // per iteration
+  double p99_ns{};
+  double min_ns{};
+  double items_per_iteration{};
+  double bytes_per_iteration{};
+  std::vector<std::pair<std::string, double>> counters;
+  std::string skip_reason;  // not measured when set
+};
+
+std::vector<Benchmark>& benchmarks() {
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+/**
+ * @brief Run the body once with the given iteration count
+ *
+ * @return double Measured seconds
+ */
+double run_once(const Benchmark& benchmark, std::uint64_t iterations,
+                State* last_state = nullptr) {
+  State state{iterations};
+  state.resume_timing();
+  benchmark.fn(state);
+  state.pause_timing();
+  double seconds{std::chrono::duration<double>(state.elapsed()).count()};
+  if (last_state)
+    *last_state = std::move(state);
+  return seconds;
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted samples
+ *
+ * With a handful of samples p99 is simply the slowest one.
+ */
+double percentile(const std::vector<double>& sorted, double fraction) {
+  auto rank{static_cast<std::size_t>(std::ceil(fraction * sorted.size()))};
+  return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+Result measure(const Benchmark& benchmark, const Options& options) {
+  const double sample_time{options.min_time / options.samples};
+
+  // Warm up caches, branch predictors and the CPU clock while growing the
+  // iteration count until one batch lasts at least one sample period.
+  std::uint64_t iterations{1};
+  State first_state{iterations};
+  double batch{run_once(benchmark, iterations, &first_state)};
+  if (!first_state.skip_reason().empty()) {
+    Result result;
+    result.name = benchmark.name;
+    result.skip_reason = first_state.skip_reason();
+    return result;
+  }
+  auto warmup_end{std::chrono::steady_clock::now() +
+                  std::chrono::duration<double>(options.warmup_time)};
+  while (batch < sample_time ||
+         std::chrono::steady_clock::now() < warmup_end) {
+    if (batch < sample_time) {
+      // aim slightly above the target to converge in few steps
+      double scale{batch > 0.0 ? 1.4 * sample_time / batch : 10.0};
+      iterations = std::max<std::uint64_t>(
+          iterations + 1,
+          static_cast<std::uint64_t>(iterations * std::min(scale, 10.0)));
+    }
+    batch = run_once(benchmark, iterations);
+  }
+
+  // Long-running bodies get fewer samples, but never fewer than three.
+  int samples{options.samples};
+  if (batch * samples > 2.0 * options.min_time)
+    samples = std::max(3, static_cast<int>(options.min_time / batch));
+
+  State last_state{iterations};
+  std::vector<double> per_iteration;
+  for (int i{0}; i < samples; ++i) {
+    double seconds{run_once(benchmark, iterations, &last_state)};
+    per_iteration.push_back(seconds * 1e9 / iterations);
+  }
+  std::sort(per_iteration.begin(), per_iteration.end());
+
+  Result result;
+  result.name = benchmark.name;
+  result.iterations = iterations;
+  result.samples = samples;
+  result.median_ns = percentile(per_iteration, 0.5);
+  result.p99_ns = percentile(per_iteration, 0.99);
+  result.min_ns = per_iteration.front();
+  result.items_per_iteration = last_state.items_per_iteration();
+  result.bytes_per_iteration = last_state.bytes_per_iteration();
+  result.counters = last_state.counters();
+  return result;
+}
+
+std::string format_time(double ns) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(ns < 10.0 ? 3 : (ns < 1000.0 ? 2 : 1));
+  if (ns < 1e4)
+    out << ns << " ns";
+  else if (ns < 1e7)
+    out << ns / 1e3 << " us";
+  else
+    out << ns / 1e6 << " ms";
+  return out.str();
+}
+
+std::string format_rate(double per_second, const char* unit) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2);
+  if (per_second >= 1e9)
+    out << per_second / 1e9 << " G" << unit;
+  else if (per_second >= 1e6)
+    out << per_second / 1e6 << " M" << unit;
+  else if (per_second >= 1e3)
+    out << per_second / 1e3 << " k" << unit;
+  else
+    out << per_second << ' ' << unit;
+  return out.str();
+}
+
+/**
+ * @brief Describe the machine and build so numbers can be compared
+ */
+void print_context() {
+  std::string cpu{"unknown"};
+  std::ifstream cpuinfo{"/proc/cpuinfo"};
+  for (std::string line; std::getline(cpuinfo, line);) {
+    if (line.rfind("model name", 0) == 0) {
+      cpu = line.substr(line.find(':') + 2);
+      break;
+    }
+  }
+  std::cout << "CPU:      " << cpu << " (" << std::thread::hardware_concurrency()
+            << " logical cores)\n";
+  std::cout << "Compiler: " << __VERSION__
+#ifdef __OPTIMIZE__
+            << ", optimized"
+#else
+            << ", NOT optimized"
+#endif
+            << '\n';
+}
+
+void print_table_row(const Result& result) {
+  if (!result.skip_reason.empty()) {
+    std::cout << std::left << std::setw(44) << result.name << std::right
+              << "  skipped: " << result.skip_reason << std::endl;
+    return;
+  }
+  std::cout << std::left << std::setw(44) << result.name << std::right
+            << std::setw(14) << format_time(result.median_ns) << std::setw(14)
+            << format_time(result.p99_ns) << std::setw(12) << result.iterations
+            << std::setw(5) << result.samples;
+  double seconds{result.median_ns * 1e-9};
+  if (result.items_per_iteration > 0.0)
+    std::cout << "  " << format_rate(result.items_per_iteration / seconds, "items/s");
+  if (result.bytes_per_iteration > 0.0)
+    std::cout << "  " << format_rate(result.bytes_per_iteration / seconds, "B/s");
+  for (const auto& [name, value] : result.counters)
+    std::cout << "  " << name << '=' << value;
+  std::cout << std::endl;
+}
+
+void print_csv_row(const Result& result) {
+  if (!result.skip_reason.empty()) {
+    // empty measurements, the reason in the place of the counters
+    std::cout << '"' << result.name << "\",,,,,,,,skipped="
+              << result.skip_reason << std::endl;
+    return;
+  }
+  std::cout << '"' << result.name << "\"," << result.median_ns << ','
+            << result.p99_ns << ',' << result.min_ns << ',' << result.iterations
+            << ',' << result.samples << ',' << result.items_per_iteration << ','
+            << result.bytes_per_iteration;
+  for (const auto& [name, value] : result.counters)
+    std::cout << ',' << name << '=' << value;
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+bool register_benchmark(std::string name, BenchmarkFn fn) {
+  benchmarks().push_back(Benchmark{std::move(name), std::move(fn)});
+  return true;
+}
+
+int run_benchmarks(int argc, char* argv[]) {
+  Options options;
+  for (int i{1}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--list") {
+      for (const auto& benchmark : benchmarks())
+        std::cout << benchmark.name << '\n';
+      return 0;
+    } else if (arg == "--filter" && i + 1 < argc) {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      options.min_time = std::atof(argv[++i]);
+    } else if (arg == "--samples" && i + 1 < argc) {
+      options.samples = std::max(3, std::atoi(argv[++i]));
+    } else if (arg == "--csv") {
+      options.csv = true;
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--list] [--filter <text>] [--min-time <seconds>]"
+                   " [--samples <n>] [--csv]\n";
+      return 1;
+    }
+  }
+
+  if (options.csv) {
+    std::cout << "name,median_ns,p99_ns,min_ns,iterations,samples,"
+                 "items_per_iteration,bytes_per_iteration\n";
+  } else {
+    print_context();
+    std::cout << std::left << std::setw(44) << "Benchmark" << std::right
+              << std::setw(14) << "median/iter" << std::setw(14) << "p99/iter"
+              << std::setw(12) << "iterations" << std::setw(5) << "n" << '\n'
+              << std::string(89, '-') << '\n';
+  }
+
+  for (const auto& benchmark : benchmarks()) {
+    if (benchmark.name.find(options.filter) == std::string::npos)
+      continue;
+    Result result{measure(benchmark, options)};
+    if (options.csv)
+      print_csv_row(result);
+    else
+      print_table_row(result);
+  }
+  return 0;
+}
+
+}  // namespace enpm702::bench
@@ -0,0 +1,119 @@
+/**
+ * @file perf_counters.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Implementation of the hardware performance counters
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "perf_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace enpm702::bench {
+
+#ifdef __linux__
+
+namespace {
+
+// In the order of PerfSample
+constexpr std::uint64_t kConfigs[]{
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+
+int open_counter(std::uint64_t config, int group) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group < 0 ? 1 : 0;  // the leader starts the whole group
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  for (int i{0}; i < kEvents; ++i) {
+    fds_[i] = open_counter(kConfigs[i], group_);
+    if (fds_[i] < 0) {
+      error_ = std::string{"perf_event_open: "} + std::strerror(errno);
+      if (errno == EACCES || errno == EPERM)
+        error_ += " (see /proc/sys/kernel/perf_event_paranoid)";
+      else if (errno == ENOENT || errno == EOPNOTSUPP)
+        error_ += " (no hardware counters, e.g. in a virtual machine)";
+      for (int j{0}; j < i; ++j) {
+        close(fds_[j]);
+        fds_[j] = -1;
+      }
+      group_ = -1;
+      return;
+    }
+    if (i == 0)
+      group_ = fds_[0];
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0)
+      close(fd);
+  }
+}
+
+void PerfCounters::start() {
+  if (!available())
+    return;
+  ioctl(group_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(group_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfSample PerfCounters::stop() {
+  PerfSample sample;
+  if (!available())
+    return sample;
+  ioctl(group_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  // nr, time_enabled, time_running, then one value per counter
+  std::uint64_t values[3 + kEvents]{};
+  if (read(group_, values, sizeof(values)) != sizeof(values) || values[2] == 0)
+    return sample;
+  const double scale{static_cast<double>(values[1]) /
+                     static_cast<double>(values[2])};
+  sample.instructions = static_cast<double>(values[3]) * scale;
+  sample.cycles = static_cast<double>(values[4]) * scale;
+  sample.branches = static_cast<double>(values[5]) * scale;
+  sample.branch_misses = static_cast<double>(values[6]) * scale;
+  return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+    : error_{"hardware counters are only read on Linux"} {}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfSample PerfCounters::stop() { return {}; }
+
+#endif
+
+}  // namespace enpm702::bench
@@ -0,0 +1,146 @@
+/**
+ * @file snippets.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Implementation of the snippet registry and its command line
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "snippets.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <ios>
+#include <iostream>
+#include <string>
+
+namespace enpm702 {
+
+namespace {
+
+std::string_view input_path;
+
+void print_usage(const char* program) {
+  std::cerr << "Usage: " << program
+            << " [--list] [--time] [--input <file>] [--run <id>[,<id>...] | --run all]\n";
+}
+
+void print_list() {
+  for (const auto& snippet : SnippetRegistry::instance().snippets()) {
+    std::cout << snippet.id;
+    if (snippet.flags & kSnippetInteractive)
+      std::cout << "\t(interactive)";
+    if (snippet.flags & kSnippetUndefined)
+      std::cout << "\t(undefined behavior)";
+    std::cout << '\n';
+  }
+}
+
+/**
+ * @brief Run one snippet without letting its stream settings leak
+ *
+ * Snippets such as std::fixed or std::boolalpha change the state of
+ * std::cout, which would alter the output of the snippets run after them.
+ */
+void run_one(const Snippet& snippet, bool timed) {
+  std::ios saved_state{nullptr};
+  saved_state.copyfmt(std::cout);
+
+  auto start{std::chrono::steady_clock::now()};
+  snippet.fn();
+  auto stop{std::chrono::steady_clock::now()};
+
+  std::cout.copyfmt(saved_state);
+  std::cout.flush();
+  if (timed) {
+    std::chrono::duration<double, std::milli> elapsed{stop - start};
+    std::cerr << "[snippet " << snippet.id << "] " << std::fixed
+              << std::setprecision(3) << elapsed.count() << " ms\n";
+  }
+}
+
+}  // namespace
+
+SnippetRegistry& SnippetRegistry::instance() {
+  static SnippetRegistry registry;
+  return registry;
+}
+
+bool SnippetRegistry::add(std::string_view id, SnippetFn fn, unsigned flags) {
+  snippets_.push_back(Snippet{id, fn, flags});
+  return true;
+}
+
+const Snippet* SnippetRegistry::find(std::string_view id) const {
+  for (const auto& snippet : snippets_) {
+    if (snippet.id == id)
+      return &snippet;
+  }
+  return nullptr;
+}
+
+std::string_view snippet_input() { return input_path; }
+
+int run_snippets(int argc, char* argv[], std::string_view default_id) {
+  std::vector<std::string_view> requested;
+  bool timed{false};
+
+  for (int i{1}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--list") {
+      print_list();
+      return 0;
+    } else if (arg == "--time") {
+      timed = true;
+    } else if (arg == "--input" && i + 1 < argc) {
+      input_path = argv[++i];
+    } else if (arg == "--run" && i + 1 < argc) {
+      // split a comma-separated list of identifiers
+      std::string_view ids{argv[++i]};
+      while (!ids.empty()) {
+        auto comma{ids.find(',')};
+        requested.push_back(ids.substr(0, comma));
+        ids = comma == std::string_view::npos ? std::string_view{}
+                                              : ids.substr(comma + 1);
+      }
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (requested.empty()) {
+    if (default_id.empty()) {
+      print_usage(argv[0]);
+      return 0;
+    }
+    requested.push_back(default_id);
+  }
+
+  const auto& registry{SnippetRegistry::instance()};
+  for (auto id : requested) {
+    if (id == "all") {
+      for (const auto& snippet : registry.snippets()) {
+        if (snippet.flags & (kSnippetInteractive | kSnippetUndefined)) {
+          std::cerr << "[snippet " << snippet.id << "] skipped, run it with --run "
+                    << snippet.id << '\n';
+          continue;
+        }
+        run_one(snippet, timed);
+      }
+      continue;
+    }
+    const Snippet* snippet{registry.find(id)};
+    if (!snippet) {
+      std::cerr << "Unknown snippet: " << id << " (see --list)\n";
+      return 1;
+    }
+    run_one(*snippet, timed);
+  }
+  return 0;
+}
+
+}  // namespace enpm702
@@ -0,0 +1,553 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Graph search behind the breadth-first / depth-first menu of snippet 22:
+//
+//     rm::CsrGraph graph{rm::CsrGraph::from_edges(rm::rmat_edges(20, 16), true)};
+//     rm::SearchResult bfs{rm::parallel_bfs(graph, 0)};
+//     // bfs.parent[v] is v's parent in the BFS tree, rm::kNoVertex if unreached
+//
+// The graph is stored in compressed sparse row form: the neighbors of every
+// vertex sit next to each other in one array, so a search reads memory
+// sequentially except for the jump to each neighbor. Vertices are 32-bit.
+//
+// parallel_bfs() is the direction-optimizing BFS of Beamer, Asanovic and
+// Patterson: levels with a small frontier go top-down (the frontier's
+// vertices claim their unvisited neighbors through an atomic bitmap), and
+// levels with a large frontier go bottom-up (every unvisited vertex looks
+// for a parent in the frontier and stops at the first one), which skips
+// most of the edges of a low-diameter graph.
+//
+// The searches throw std::invalid_argument when the source is not a vertex
+// of the graph, and parallel_bfs() also when the graph is not symmetric;
+// from_edges() throws it for an edge using the reserved id kNoVertex.
+namespace rm
+{
+
+constexpr std::uint32_t kNoVertex{0xffffffffu};
+
+struct Edge
+{
+    std::uint32_t from;
+    std::uint32_t to;
+};
+
+class CsrGraph
+{
+public:
+    CsrGraph() : offsets_(1, 0) {}
+
+    // Graph on vertices 0..max id; symmetric adds every edge in both
+    // directions, which the bottom-up steps of parallel_bfs() require.
+    // Throws std::invalid_argument for an edge using the id kNoVertex.
+    static CsrGraph from_edges(const std::vector<Edge> &edges, bool symmetric)
+    {
+        std::uint32_t vertices{0};
+        for (const Edge &edge : edges)
+        {
+            // kNoVertex + 1 would wrap to 0 and the vertex go uncounted
+            if (edge.from >= kNoVertex || edge.to >= kNoVertex)
+                throw std::invalid_argument{"edge " + std::to_string(edge.from) + " -> " + std::to_string(edge.to) +
+                                            " uses the reserved id " + std::to_string(kNoVertex)};
+            vertices = std::max({vertices, edge.from + 1, edge.to + 1});
+        }
+        CsrGraph graph;
+        graph.symmetric_ = symmetric;
+        graph.offsets_.assign(std::size_t{vertices} + 1, 0);
+        // counting sort of the edges by source
+        for (const Edge &edge : edges)
+        {
+            ++graph.offsets_[edge.from + 1];
+            if (symmetric)
+                ++graph.offsets_[edge.to + 1];
+        }
+        std::partial_sum(graph.offsets_.begin(), graph.offsets_.end(), graph.offsets_.begin());
+        graph.targets_.resize(graph.offsets_.back());
+        std::vector<std::uint64_t> next(graph.offsets_.begin(), graph.offsets_.end() - 1);
+        for (const Edge &edge : edges)
+        {
+            graph.targets_[next[edge.from]++] = edge.to;
+            if (symmetric)
+                graph.targets_[next[edge.to]++] = edge.from;
+        }
+        return graph;
+    }
+
+    std::uint32_t vertex_count() const { return static_cast<std::uint32_t>(offsets_.size() - 1); }
+
+    // Entries of the adjacency lists; twice the input edges when symmetric
+    std::uint64_t arc_count() const { return targets_.size(); }
+
+    bool symmetric() const { return symmetric_; }
+
+    std::uint64_t degree(std::uint32_t v) const { return offsets_[v + 1] - offsets_[v]; }
+
+    const std::uint32_t *neighbors_begin(std::uint32_t v) const { return targets_.data() + offsets_[v]; }
+    const std::uint32_t *neighbors_end(std::uint32_t v) const { return targets_.data() + offsets_[v + 1]; }
+
+private:
+    std::vector<std::uint64_t> offsets_; // neighbors of v: targets_[offsets_[v]..offsets_[v + 1])
+    std::vector<std::uint32_t> targets_;
+    bool symmetric_{false};
+};
+
+// Edges "from to" one per line, as in the SNAP and Matrix Market
+// collections; lines starting with '#' or '%' are comments. False if the
+// text holds anything else.
+inline bool parse_edge_list(std::string_view text, std::vector<Edge> &edges)
+{
+    const char *p{text.data()};
+    const char *last{p + text.size()};
+    auto skip_blanks{[&] {
+        while (p != last && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+    }};
+    while (p != last)
+    {
+        skip_blanks();
+        if (p != last && *p != '\n' && *p != '#' && *p != '%')
+        {
+            Edge edge{};
+            auto from{std::from_chars(p, last, edge.from)};
+            p = from.ptr;
+            skip_blanks();
+            auto to{std::from_chars(p, last, edge.to)};
+            p = to.ptr;
+            if (from.ec != std::errc{} || to.ec != std::errc{} || edge.from == kNoVertex || edge.to == kNoVertex)
+                return false;
+            edges.push_back(edge);
+            skip_blanks();
+            if (p != last && *p != '\n')
+                return false; // a third column, e.g. a weight
+        }
+        while (p != last && *p != '\n')
+            ++p;
+        if (p != last)
+            ++p;
+    }
+    return true;
+}
+
+// Recursive-matrix (R-MAT) random graph with 2^scale vertices and
+// edge_factor * 2^scale edges. Each edge picks one quadrant of the
+// adjacency matrix per bit with probabilities a, b, c and 1 - a - b - c;
+// the defaults are those of the Graph500 benchmark, which give the skewed
+// degrees of social and web graphs. Vertex numbers are shuffled so that
+// high-degree vertices are not all near 0.
+inline std::vector<Edge> rmat_edges(unsigned scale, unsigned edge_factor, std::uint64_t seed = 1,
+                                    double a = 0.57, double b = 0.19, double c = 0.19)
+{
+    const std::uint32_t vertices{std::uint32_t{1} << scale};
+    const std::size_t count{std::size_t{edge_factor} << scale};
+
+    // splitmix64: cheap and good enough for picking quadrants
+    auto next{[](std::uint64_t &state) {
+        std::uint64_t z{state += 0x9e3779b97f4a7c15ULL};
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }};
+    auto threshold{[](double p) { return static_cast<std::uint64_t>(p * 18446744073709551615.0); }};
+    const std::uint64_t below_a{threshold(a)};
+    const std::uint64_t below_ab{threshold(a + b)};
+    const std::uint64_t below_abc{threshold(a + b + c)};
+
+    std::vector<std::uint32_t> relabel(vertices);
+    std::iota(relabel.begin(), relabel.end(), std::uint32_t{0});
+    std::uint64_t shuffle{seed};
+    for (std::uint32_t i{vertices - 1}; i > 0; --i)
+        std::swap(relabel[i], relabel[next(shuffle) % (i + 1)]);
+
+    // blocks of edges seeded by their index, so that the graph does not
+    // depend on the number of threads
+    constexpr std::size_t kBlock{std::size_t{1} << 16};
+    const std::size_t blocks{(count + kBlock - 1) / kBlock};
+    std::vector<Edge> edges(count);
+    std::atomic<std::size_t> next_block{0};
+    auto generate{[&] {
+        for (std::size_t block{next_block++}; block < blocks; block = next_block++)
+        {
+            std::uint64_t state{seed ^ (0x632be59bd9b4e019ULL * (block + 1))};
+            for (std::size_t i{block * kBlock}; i < std::min(count, (block + 1) * kBlock); ++i)
+            {
+                std::uint32_t from{0};
+                std::uint32_t to{0};
+                for (unsigned bit{0}; bit < scale; ++bit)
+                {
+                    std::uint64_t r{next(state)};
+                    from = (from << 1) | (r >= below_ab);
+                    to = (to << 1) | ((r >= below_a && r < below_ab) || r >= below_abc);
+                }
+                edges[i] = Edge{relabel[from], relabel[to]};
+            }
+        }
+    }};
+    unsigned threads{std::max(1u, std::thread::hardware_concurrency())};
+    std::vector<std::thread> workers;
+    for (unsigned t{1}; t < threads; ++t)
+        workers.emplace_back(generate);
+    generate();
+    for (auto &worker : workers)
+        worker.join();
+    return edges;
+}
+
+namespace detail
+{
+
+inline void check_source(const CsrGraph &graph, std::uint32_t source)
+{
+    if (source >= graph.vertex_count())
+        throw std::invalid_argument{"source " + std::to_string(source) + " is not a vertex of a graph of " +
+                                    std::to_string(graph.vertex_count()) + " vertices"};
+}
+
+} // namespace detail
+
+struct SearchResult
+{
+    std::vector<std::uint32_t> parent; // the source is its own parent
+    std::uint32_t visited{0};          // vertices reached, source included
+};
+
+// Iterative depth-first search; vertices are visited in the order a
+// recursive DFS would visit them
+inline SearchResult dfs(const CsrGraph &graph, std::uint32_t source)
+{
+    detail::check_source(graph, source);
+    SearchResult result;
+    result.parent.assign(graph.vertex_count(), kNoVertex);
+    struct Frame
+    {
+        std::uint32_t vertex;
+        const std::uint32_t *next; // next neighbor to look at
+    };
+    std::vector<Frame> stack;
+    result.parent[source] = source;
+    result.visited = 1;
+    stack.push_back(Frame{source, graph.neighbors_begin(source)});
+    while (!stack.empty())
+    {
+        Frame &top{stack.back()};
+        const std::uint32_t *end{graph.neighbors_end(top.vertex)};
+        while (top.next != end && result.parent[*top.next] != kNoVertex)
+            ++top.next;
+        if (top.next == end)
+        {
+            stack.pop_back();
+            continue;
+        }
+        std::uint32_t child{*top.next++};
+        result.parent[child] = top.vertex;
+        ++result.visited;
+        stack.push_back(Frame{child, graph.neighbors_begin(child)}); // invalidates top
+    }
+    return result;
+}
+
+// Level-synchronous breadth-first search with one FIFO array
+inline SearchResult bfs(const CsrGraph &graph, std::uint32_t source)
+{
+    detail::check_source(graph, source);
+    SearchResult result;
+    result.parent.assign(graph.vertex_count(), kNoVertex);
+    std::vector<std::uint32_t> queue(graph.vertex_count());
+    std::size_t head{0};
+    std::size_t tail{0};
+    result.parent[source] = source;
+    queue[tail++] = source;
+    while (head != tail)
+    {
+        std::uint32_t u{queue[head++]};
+        for (const std::uint32_t *v{graph.neighbors_begin(u)}; v != graph.neighbors_end(u); ++v)
+        {
+            if (result.parent[*v] == kNoVertex)
+            {
+                result.parent[*v] = u;
+                queue[tail++] = *v;
+            }
+        }
+    }
+    result.visited = static_cast<std::uint32_t>(tail);
+    return result;
+}
+
+namespace detail
+{
+
+// Threads wait here until all of them arrive; the last one runs
+// on_arrival first, alone
+class Barrier
+{
+public:
+    explicit Barrier(unsigned threads) : threads_{threads} {}
+
+    template <typename F>
+    void arrive_and_wait(F on_arrival)
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        unsigned phase{phase_};
+        if (++arrived_ == threads_)
+        {
+            on_arrival();
+            arrived_ = 0;
+            ++phase_;
+            lock.unlock();
+            condition_.notify_all();
+            return;
+        }
+        condition_.wait(lock, [&] { return phase_ != phase; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    unsigned threads_;
+    unsigned arrived_{0};
+    unsigned phase_{0};
+};
+
+class AtomicBitmap
+{
+public:
+    explicit AtomicBitmap(std::size_t bits)
+        : words_{(bits + 63) / 64}, bits_{std::make_unique<std::atomic<std::uint64_t>[]>(words_)}
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (std::size_t i{0}; i < words_; ++i)
+            bits_[i].store(0, std::memory_order_relaxed);
+    }
+
+    bool test(std::uint32_t bit) const
+    {
+        return (bits_[bit / 64].load(std::memory_order_relaxed) >> (bit % 64)) & 1;
+    }
+
+    // Set bit; true if this call changed it
+    bool claim(std::uint32_t bit)
+    {
+        std::uint64_t mask{std::uint64_t{1} << (bit % 64)};
+        return !(bits_[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+    // For words only one thread writes
+    void set(std::uint32_t bit)
+    {
+        auto &word{bits_[bit / 64]};
+        word.store(word.load(std::memory_order_relaxed) | (std::uint64_t{1} << (bit % 64)),
+                   std::memory_order_relaxed);
+    }
+
+    void swap(AtomicBitmap &other)
+    {
+        std::swap(words_, other.words_);
+        std::swap(bits_, other.bits_);
+    }
+
+private:
+    std::size_t words_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> bits_;
+};
+
+} // namespace detail
+
+struct ParallelBfsOptions
+{
+    unsigned threads{0}; // 0: one per hardware thread
+    // Go bottom-up when the frontier's edges exceed the unvisited vertices'
+    // edges / alpha, and back top-down when the frontier has fewer than
+    // vertices / beta vertices; the values of Beamer et al.
+    double alpha{15.0};
+    double beta{18.0};
+};
+
+// Direction-optimizing BFS on a symmetric graph: the bottom-up steps look
+// for parents among a vertex's own neighbors
+inline SearchResult parallel_bfs(const CsrGraph &graph, std::uint32_t source,
+                                 const ParallelBfsOptions &options = ParallelBfsOptions{})
+{
+    if (!graph.symmetric())
+        throw std::invalid_argument{"parallel_bfs needs a symmetric graph"};
+    detail::check_source(graph, source);
+    const std::uint32_t n{graph.vertex_count()};
+    SearchResult result;
+    result.parent.assign(n, kNoVertex);
+    std::vector<std::uint32_t> &parent{result.parent};
+    unsigned threads{options.threads ? options.threads : std::thread::hardware_concurrency()};
+    threads = std::max(1u, threads);
+
+    detail::AtomicBitmap visited{n};
+    detail::AtomicBitmap frontier_bits{n}; // frontier of a bottom-up step
+    detail::AtomicBitmap next_bits{n};
+    std::vector<std::uint32_t> frontier{source}; // frontier of a top-down step
+    std::vector<std::vector<std::uint32_t>> next_frontiers(threads);
+    // vertices found by each thread in a bottom-up step, and the edges of
+    // the vertices found in either direction
+    std::vector<std::uint64_t> found_vertices(threads);
+    std::vector<std::uint64_t> found_edges(threads);
+
+    parent[source] = source;
+    visited.claim(source);
+    std::uint64_t unvisited_edges{graph.arc_count() - graph.degree(source)};
+    std::uint64_t frontier_edges{graph.degree(source)};
+    std::uint64_t frontier_size{1};
+    std::uint64_t reached{1};
+    bool bottom_up{false};
+    bool done{false};
+    std::atomic<std::size_t> next_block{0};
+    constexpr std::size_t kBlock{256}; // frontier vertices taken at a time
+
+    // Runs on one thread between steps: gathers what the threads found and
+    // picks the direction of the next step
+    auto finish_step{[&] {
+        std::uint64_t found{0};
+        frontier_edges = 0;
+        for (unsigned t{0}; t < threads; ++t)
+        {
+            found += bottom_up ? found_vertices[t] : next_frontiers[t].size();
+            frontier_edges += found_edges[t];
+        }
+        unvisited_edges -= frontier_edges;
+        reached += found;
+        std::uint64_t previous_size{frontier_size};
+        frontier_size = found;
+        if (bottom_up)
+        {
+            frontier_bits.swap(next_bits);
+            next_bits.clear();
+            if (frontier_size < n / options.beta && frontier_size < previous_size)
+            {
+                // back to top-down: turn the bitmap into a list
+                bottom_up = false;
+                frontier.clear();
+                for (std::uint32_t v{0}; v < n; ++v)
+                {
+                    if (frontier_bits.test(v))
+                        frontier.push_back(v);
+                }
+            }
+        }
+        else
+        {
+            frontier.clear();
+            for (unsigned t{0}; t < threads; ++t)
+            {
+                frontier.insert(frontier.end(), next_frontiers[t].begin(), next_frontiers[t].end());
+                next_frontiers[t].clear();
+            }
+            if (frontier_edges > unvisited_edges / options.alpha)
+            {
+                bottom_up = true;
+                frontier_bits.clear();
+                for (std::uint32_t v : frontier)
+                    frontier_bits.set(v);
+            }
+        }
+        std::fill(found_vertices.begin(), found_vertices.end(), 0);
+        std::fill(found_edges.begin(), found_edges.end(), 0);
+        next_block.store(0, std::memory_order_relaxed);
+        done = frontier_size == 0;
+    }};
+
+    detail::Barrier barrier{threads};
+    auto work{[&](unsigned t) {
+        // bottom-up steps give each thread a fixed range of whole bitmap
+        // words, so the bits of a word are only written by one thread
+        const std::uint32_t words{(n + 63) / 64};
+        const std::uint32_t first{static_cast<std::uint32_t>(std::uint64_t{words} * t / threads * 64)};
+        const std::uint32_t last{static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(n, std::uint64_t{words} * (t + 1) / threads * 64))};
+        while (!done)
+        {
+            if (bottom_up)
+            {
+                std::uint64_t found{0};
+                std::uint64_t edges{0};
+                for (std::uint32_t v{first}; v < last; ++v)
+                {
+                    if (visited.test(v))
+                        continue;
+                    for (const std::uint32_t *u{graph.neighbors_begin(v)}; u != graph.neighbors_end(v); ++u)
+                    {
+                        if (frontier_bits.test(*u))
+                        {
+                            parent[v] = *u;
+                            visited.set(v);
+                            next_bits.set(v);
+                            ++found;
+                            edges += graph.degree(v);
+                            break;
+                        }
+                    }
+                }
+                found_vertices[t] = found;
+                found_edges[t] = edges;
+            }
+            else
+            {
+                std::vector<std::uint32_t> &next{next_frontiers[t]};
+                std::uint64_t edges{0};
+                for (std::size_t block{next_block.fetch_add(kBlock, std::memory_order_relaxed)};
+                     block < frontier.size(); block = next_block.fetch_add(kBlock, std::memory_order_relaxed))
+                {
+                    std::size_t end{std::min(block + kBlock, frontier.size())};
+                    for (std::size_t i{block}; i < end; ++i)
+                    {
+                        std::uint32_t u{frontier[i]};
+                        for (const std::uint32_t *v{graph.neighbors_begin(u)}; v != graph.neighbors_end(u); ++v)
+                        {
+                            if (!visited.test(*v) && visited.claim(*v))
+                            {
+                                parent[*v] = u;
+                                next.push_back(*v);
+                                edges += graph.degree(*v);
+                            }
+                        }
+                    }
+                }
+                found_edges[t] = edges;
+            }
+            barrier.arrive_and_wait(finish_step);
+        }
+    }};
+    std::vector<std::thread> workers;
+    for (unsigned t{1}; t < threads; ++t)
+        workers.emplace_back(work, t);
+    work(0);
+    for (auto &worker : workers)
+        worker.join();
+    result.visited = static_cast<std::uint32_t>(reached);
+    return result;
+}
+
+// Input edges in the component a search reached, the numerator of
+// traversed edges per second (TEPS) as the Graph500 benchmark defines it
+inline std::uint64_t component_edges(const CsrGraph &graph, const SearchResult &result)
+{
+    std::uint64_t arcs{0};
+    for (std::uint32_t v{0}; v < graph.vertex_count(); ++v)
+    {
+        if (result.parent[v] != kNoVertex)
+            arcs += graph.degree(v);
+    }
+    return graph.symmetric() ? arcs / 2 : arcs;
+}
+
+} // namespace rm
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Batch input for the snippets that read integers with std::cin >> (1, 28
+// and 38). InputText holds the whole input at once, memory-mapped when it
+// is a file, and parse_ints() converts whitespace-separated integers into a
+// caller-supplied array:
+//
+//     rm::InputText input{"numbers.txt"};   // or rm::InputText{} for stdin
+//     std::vector<int> values(4096);
+//     std::string_view text{input.text()};
+//     const char *next{text.data()};
+//     while (true)
+//     {
+//         auto result{rm::parse_ints(next, text.data() + text.size(),
+//                                    values.data(), values.size())};
+//         use(values.data(), result.count);
+//         if (result.error || result.next == text.data() + text.size())
+//             break;
+//         next = result.next;           // the array was full, continue
+//     }
+//
+// The scanner looks at 64 bytes at a time with SSE2 to find where numbers
+// start, then converts each one with std::from_chars.
+namespace rm
+{
+
+struct ParseResult
+{
+    std::size_t count; // integers stored
+    const char *next;  // where parsing stopped
+    bool error;        // next points at something that is not an int
+};
+
+namespace detail
+{
+
+// Bytes up to ' ' count as whitespace, which covers ' ', \t, \n, \v, \f, \r
+inline bool is_space(char c) { return static_cast<unsigned char>(c) <= ' '; }
+
+// Convert the number at p; nullptr if it is malformed or out of range
+inline const char *parse_one(const char *p, const char *last, int &value)
+{
+    // std::cin accepts a leading '+', std::from_chars does not
+    const char *digits{p};
+    if (*digits == '+' && digits + 1 != last && digits[1] != '-')
+        ++digits;
+    auto [end, ec]{std::from_chars(digits, last, value)};
+    if (ec != std::errc{} || (end != last && !is_space(*end)))
+        return nullptr;
+    return end;
+}
+
+#if defined(__SSE2__)
+// One bit per byte of p[0..63], set for whitespace
+inline std::uint64_t whitespace_mask(const char *p)
+{
+    const __m128i space{_mm_set1_epi8(' ')};
+    std::uint64_t mask{0};
+    for (int i{0}; i < 4; ++i)
+    {
+        __m128i bytes{_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i))};
+        // unsigned bytes <= ' ' are those equal to min(byte, ' ')
+        __m128i space_or_less{_mm_cmpeq_epi8(_mm_min_epu8(bytes, space), bytes)};
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(space_or_less)))
+                << (16 * i);
+    }
+    return mask;
+}
+#endif
+
+} // namespace detail
+
+// Parse integers from [first, last) into out[0..capacity), stopping at the
+// end of the input, when out is full, or at the first malformed number
+inline ParseResult parse_ints(const char *first, const char *last, int *out, std::size_t capacity)
+{
+    std::size_t count{0};
+    const char *p{first};
+
+#if defined(__SSE2__)
+    // A number starts at a non-space byte that follows a space (or the
+    // start of the input); the bits of those bytes are found 64 at a time
+    std::uint64_t previous_space{1};
+    const char *block{first};
+    for (; last - block >= 64; block += 64)
+    {
+        std::uint64_t space{detail::whitespace_mask(block)};
+        std::uint64_t starts{~space & ((space << 1) | previous_space)};
+        previous_space = space >> 63;
+        while (starts != 0)
+        {
+            const char *start{block + __builtin_ctzll(starts)};
+            starts &= starts - 1;
+            if (count == capacity)
+                return ParseResult{count, start, false};
+            const char *end{detail::parse_one(start, last, out[count])};
+            if (!end)
+                return ParseResult{count, start, true};
+            ++count;
+            p = end;
+        }
+    }
+    if (p < block)
+        p = block; // the numbers before the tail all ended in a block
+#endif
+
+    while (true)
+    {
+        while (p != last && detail::is_space(*p))
+            ++p;
+        if (p == last)
+            return ParseResult{count, last, false};
+        if (count == capacity)
+            return ParseResult{count, p, false};
+        const char *end{detail::parse_one(p, last, out[count])};
+        if (!end)
+            return ParseResult{count, p, true};
+        ++count;
+        p = end;
+    }
+}
+
+// The whole of a file (memory-mapped) or of stdin (mapped when it is a
+// regular file, read otherwise)
+class InputText
+{
+public:
+    // Read stdin
+    InputText() { load(STDIN_FILENO); }
+
+    // Read path; an empty path or "-" means stdin
+    explicit InputText(std::string_view path)
+    {
+        if (path.empty() || path == "-")
+        {
+            load(STDIN_FILENO);
+            return;
+        }
+        std::string name{path};
+        int fd{::open(name.c_str(), O_RDONLY)};
+        if (fd < 0)
+            return;
+        load(fd);
+        ::close(fd);
+    }
+
+    InputText(const InputText &) = delete;
+    InputText &operator=(const InputText &) = delete;
+
+    ~InputText()
+    {
+        if (mapped_)
+            ::munmap(const_cast<char *>(mapped_), size_);
+    }
+
+    // False if the file could not be opened or read
+    bool ok() const { return ok_; }
+
+    std::string_view text() const
+    {
+        return mapped_ ? std::string_view{mapped_, size_}
+                       : std::string_view{copy_.data(), copy_.size()};
+    }
+
+private:
+    void load(int fd)
+    {
+        struct stat info{};
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+        {
+            size_ = static_cast<std::size_t>(info.st_size);
+            if (size_ == 0)
+            {
+                ok_ = true;
+                return;
+            }
+            void *memory{::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (memory != MAP_FAILED)
+            {
+                ::madvise(memory, size_, MADV_SEQUENTIAL);
+                mapped_ = static_cast<const char *>(memory);
+                ok_ = true;
+                return;
+            }
+        }
+        // pipes and terminals: read until end of file
+        copy_.resize(1 << 16);
+        std::size_t used{0};
+        while (true)
+        {
+            if (used == copy_.size())
+                copy_.resize(copy_.size() * 2);
+            ssize_t got{::read(fd, copy_.data() + used, copy_.size() - used)};
+            if (got == 0)
+                break;
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                copy_.clear();
+                return;
+            }
+            used += static_cast<std::size_t>(got);
+        }
+        copy_.resize(used);
+        ok_ = true;
+    }
+
+    const char *mapped_{nullptr};
+    std::size_t size_{0};
+    std::vector<char> copy_;
+    bool ok_{false};
+};
+
+} // namespace rm
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Snippets 11 to 14 and 18 pick what to do next with a switch. A bytecode
+// interpreter does the same once per instruction, and this header has a
+// small one whose program works on an accumulator and a few registers.
+// Two of its opcodes are the menus of the snippets:
+//
+// - Op::kSay is snippets 11 and 12: "one", "two" or "unknown" for acc;
+// - Op::kChoice is snippets 13 and 14: "Choice is 1" falls through to
+//   "Choice is 2", anything else is "Unknown choice".
+//
+// and Op::kBranch is the switch itself: it jumps to one of the instructions
+// that follow it, picked by acc. The machine counts the words it says
+// instead of printing them.
+//
+//     rm::Program program{{rm::Op::kSet, 0, 1}, {rm::Op::kChoice}, {rm::Op::kHalt}};
+//     rm::Machine machine{rm::run(program, rm::Dispatch::kComputedGoto)};
+//
+// The same program runs with four dispatch strategies, which only differ
+// in how the interpreter gets from one instruction to the next (all of
+// them call the same step<op>() for the work itself):
+//
+// - kSwitch: a switch in a loop. All opcodes share the one indirect jump
+//   the switch compiles to, so the branch predictor only learns which
+//   opcode is the most common;
+// - kComputedGoto: GNU labels as values. Every opcode ends with its own
+//   `goto *labels[next op]`, so the predictor learns which opcode usually
+//   follows which;
+// - kTailCall: every opcode is a function that ends by calling the handler
+//   of the next one. The call compiles to a jump, so this is threaded like
+//   computed goto, in standard C++, and acc stays in a register;
+// - kTable: a loop calling handlers through a table of function pointers.
+//   Each handler returns the next instruction and acc lives in memory.
+//
+// src/rm_dispatch_bench.cpp measures them.
+namespace rm
+{
+
+enum class Op : std::uint8_t
+{
+    kHalt,   // stop
+    kSet,    // acc = operand
+    kAdd,    // acc += operand
+    kAnd,    // acc &= operand
+    kLoad,   // acc = registers[index]
+    kStore,  // registers[index] = acc
+    kAddReg, // acc += registers[index]
+    kRandom, // acc = next pseudo-random number >> operand (0 to 63)
+    kJump,   // continue at operand
+    kLoop,   // continue at operand while --registers[index] > 0
+    kBranch, // continue at the acc-th of the operand + 1 next instructions, the last one if acc is not in [0, operand)
+    kSay,    // snippets 11 and 12
+    kChoice, // snippets 13 and 14
+    kCount,  // number of opcodes, not an instruction
+};
+
+constexpr std::size_t kOpCount{static_cast<std::size_t>(Op::kCount)};
+constexpr std::size_t kRegisters{8};
+
+struct Instruction
+{
+    Op op{Op::kHalt};
+    std::uint8_t index{0};   // register of kLoad, kStore, kAddReg and kLoop
+    std::int32_t operand{0}; // constant, shift, target or number of branches
+};
+
+using Program = std::vector<Instruction>;
+
+// What kSay and kChoice say
+enum class Word : std::uint8_t
+{
+    kOne,
+    kTwo,
+    kUnknown,
+    kChoiceIs1,
+    kChoiceIs2,
+    kUnknownChoice,
+    kCount,
+};
+
+constexpr std::size_t kWordCount{static_cast<std::size_t>(Word::kCount)};
+
+inline const char *to_string(Word word)
+{
+    switch (word)
+    {
+    case Word::kOne:
+        return "one";
+    case Word::kTwo:
+        return "two";
+    case Word::kUnknown:
+        return "unknown";
+    case Word::kChoiceIs1:
+        return "Choice is 1";
+    case Word::kChoiceIs2:
+        return "Choice is 2";
+    case Word::kUnknownChoice:
+        return "Unknown choice";
+    default:
+        return "?";
+    }
+}
+
+struct Machine
+{
+    std::int64_t acc{0};
+    std::array<std::int64_t, kRegisters> registers{};
+    std::uint64_t seed{0x2545F4914F6CDD1Du}; // of kRandom, never 0
+    std::array<std::uint64_t, kWordCount> said{}; // indexed by Word
+    std::uint64_t executed{0};                    // instructions, kHalt included
+};
+
+enum class Dispatch
+{
+    kSwitch,
+    kComputedGoto,
+    kTailCall,
+    kTable,
+};
+
+inline const char *to_string(Dispatch dispatch)
+{
+    switch (dispatch)
+    {
+    case Dispatch::kSwitch:
+        return "switch";
+    case Dispatch::kComputedGoto:
+        return "computed_goto";
+    case Dispatch::kTailCall:
+        return "tail_call";
+    case Dispatch::kTable:
+        return "table";
+    }
+    return "?";
+}
+
+// Computed goto is a GNU extension (GCC and clang)
+inline bool is_supported([[maybe_unused]] Dispatch dispatch)
+{
+#if defined(__GNUC__)
+    return true;
+#else
+    return dispatch != Dispatch::kComputedGoto;
+#endif
+}
+
+// Throws std::invalid_argument unless every instruction is valid and the
+// program cannot run past its end (it must end with kHalt or kJump).
+inline void validate(const Program &program)
+{
+    const auto fail = [](std::size_t pc, const std::string &what) {
+        throw std::invalid_argument{"instruction " + std::to_string(pc) + ": " + what};
+    };
+    if (program.empty() || (program.back().op != Op::kHalt && program.back().op != Op::kJump))
+        fail(program.size(), "the program must end with kHalt or kJump");
+    const auto size{static_cast<std::int64_t>(program.size())};
+    for (std::size_t pc{0}; pc < program.size(); ++pc)
+    {
+        const Instruction &instruction{program[pc]};
+        // also catches values cast from integers past the last opcode
+        if (static_cast<std::size_t>(instruction.op) >= kOpCount)
+            fail(pc, "unknown opcode");
+        switch (instruction.op)
+        {
+        case Op::kLoad:
+        case Op::kStore:
+        case Op::kAddReg:
+            if (instruction.index >= kRegisters)
+                fail(pc, "no register " + std::to_string(instruction.index));
+            break;
+        case Op::kRandom:
+            if (instruction.operand < 0 || instruction.operand > 63)
+                fail(pc, "shift out of range");
+            break;
+        case Op::kLoop:
+            if (instruction.index >= kRegisters)
+                fail(pc, "no register " + std::to_string(instruction.index));
+            [[fallthrough]];
+        case Op::kJump:
+            if (instruction.operand < 0 || instruction.operand >= size)
+                fail(pc, "jump out of the program");
+            break;
+        case Op::kBranch:
+            if (instruction.operand < 0 || static_cast<std::int64_t>(pc) + 1 + instruction.operand >= size)
+                fail(pc, "branches out of the program");
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+namespace detail
+{
+
+#if defined(__GNUC__)
+#define RM_INTERPRETER_INLINE __attribute__((always_inline)) inline
+#else
+#define RM_INTERPRETER_INLINE inline
+#endif
+
+// kTailCall needs the calls between handlers to be jumps, or a long
+// program overflows the stack. clang (and GCC 15) can be told so with
+// musttail; older GCC only turns them into jumps when optimizing, so its
+// handlers are optimized even in Debug builds. Sanitizers keep the calls
+// as calls: without musttail, do not run long programs with kTailCall in
+// a -fsanitize build.
+#if defined(__has_attribute)
+#if __has_attribute(musttail)
+#define RM_MUSTTAIL __attribute__((musttail))
+#endif
+#endif
+#ifdef RM_MUSTTAIL
+#define RM_TAIL_HANDLER inline
+#elif defined(__GNUC__) && !defined(__clang__)
+#define RM_MUSTTAIL
+#define RM_TAIL_HANDLER __attribute__((optimize("O2"))) inline
+#else
+#define RM_MUSTTAIL
+#define RM_TAIL_HANDLER inline
+#endif
+
+constexpr std::size_t word_index(Word word) { return static_cast<std::size_t>(word); }
+
+// One instruction: updates the machine and returns the next instruction,
+// or nullptr after kHalt
+template <Op kOp>
+RM_INTERPRETER_INLINE const Instruction *step(const Instruction *code, const Instruction *ip, Machine &machine,
+                                              std::int64_t &acc)
+{
+    if constexpr (kOp == Op::kHalt)
+        return nullptr;
+    else if constexpr (kOp == Op::kSet)
+        acc = ip->operand;
+    else if constexpr (kOp == Op::kAdd)
+        acc += ip->operand;
+    else if constexpr (kOp == Op::kAnd)
+        acc &= ip->operand;
+    else if constexpr (kOp == Op::kLoad)
+        acc = machine.registers[ip->index];
+    else if constexpr (kOp == Op::kStore)
+        machine.registers[ip->index] = acc;
+    else if constexpr (kOp == Op::kAddReg)
+        acc += machine.registers[ip->index];
+    else if constexpr (kOp == Op::kRandom)
+    {
+        // xorshift64
+        std::uint64_t seed{machine.seed};
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        machine.seed = seed;
+        acc = static_cast<std::int64_t>(seed >> ip->operand);
+    }
+    else if constexpr (kOp == Op::kJump)
+        return code + ip->operand;
+    else if constexpr (kOp == Op::kLoop)
+    {
+        if (--machine.registers[ip->index] > 0)
+            return code + ip->operand;
+    }
+    else if constexpr (kOp == Op::kBranch)
+        return ip + 1 + std::min(static_cast<std::uint64_t>(acc), static_cast<std::uint64_t>(ip->operand));
+    else if constexpr (kOp == Op::kSay)
+    {
+        switch (acc)
+        {
+        case 1:
+            ++machine.said[word_index(Word::kOne)];
+            break;
+        case 2:
+            ++machine.said[word_index(Word::kTwo)];
+            break;
+        default:
+            ++machine.said[word_index(Word::kUnknown)];
+            break;
+        }
+    }
+    else if constexpr (kOp == Op::kChoice)
+    {
+        switch (acc)
+        {
+        case 1:
+            ++machine.said[word_index(Word::kChoiceIs1)];
+            [[fallthrough]];
+        case 2:
+            ++machine.said[word_index(Word::kChoiceIs2)];
+            break;
+        default:
+            ++machine.said[word_index(Word::kUnknownChoice)];
+        }
+    }
+    return ip + 1;
+}
+
+inline void run_switch(const Instruction *code, Machine &machine)
+{
+    std::int64_t acc{machine.acc};
+    std::uint64_t executed{machine.executed};
+    const Instruction *ip{code};
+    for (;;)
+    {
+        ++executed;
+        switch (ip->op)
+        {
+        case Op::kHalt:
+            machine.acc = acc;
+            machine.executed = executed;
+            return;
+        case Op::kSet:
+            ip = step<Op::kSet>(code, ip, machine, acc);
+            break;
+        case Op::kAdd:
+            ip = step<Op::kAdd>(code, ip, machine, acc);
+            break;
+        case Op::kAnd:
+            ip = step<Op::kAnd>(code, ip, machine, acc);
+            break;
+        case Op::kLoad:
+            ip = step<Op::kLoad>(code, ip, machine, acc);
+            break;
+        case Op::kStore:
+            ip = step<Op::kStore>(code, ip, machine, acc);
+            break;
+        case Op::kAddReg:
+            ip = step<Op::kAddReg>(code, ip, machine, acc);
+            break;
+        case Op::kRandom:
+            ip = step<Op::kRandom>(code, ip, machine, acc);
+            break;
+        case Op::kJump:
+            ip = step<Op::kJump>(code, ip, machine, acc);
+            break;
+        case Op::kLoop:
+            ip = step<Op::kLoop>(code, ip, machine, acc);
+            break;
+        case Op::kBranch:
+            ip = step<Op::kBranch>(code, ip, machine, acc);
+            break;
+        case Op::kSay:
+            ip = step<Op::kSay>(code, ip, machine, acc);
+            break;
+        case Op::kChoice:
+            ip = step<Op::kChoice>(code, ip, machine, acc);
+            break;
+        case Op::kCount: // rejected by validate()
+            return;
+        }
+    }
+}
+
+#if defined(__GNUC__)
+inline void run_computed_goto(const Instruction *code, Machine &machine)
+{
+    // in the order of Op
+    static const void *const labels[kOpCount]{&&halt, &&set,   &&add,  &&and_, &&load,   &&store, &&add_reg,
+                                              &&random, &&jump, &&loop, &&branch, &&say, &&choice};
+    std::int64_t acc{machine.acc};
+    std::uint64_t executed{machine.executed};
+    const Instruction *ip{code};
+
+#define RM_NEXT(kind)                                                                                                    \
+    ip = step<kind>(code, ip, machine, acc);                                                                             \
+    ++executed;                                                                                                        \
+    goto *labels[static_cast<std::size_t>(ip->op)]
+
+    ++executed;
+    goto *labels[static_cast<std::size_t>(ip->op)];
+halt:
+    machine.acc = acc;
+    machine.executed = executed;
+    return;
+set:
+    RM_NEXT(Op::kSet);
+add:
+    RM_NEXT(Op::kAdd);
+and_:
+    RM_NEXT(Op::kAnd);
+load:
+    RM_NEXT(Op::kLoad);
+store:
+    RM_NEXT(Op::kStore);
+add_reg:
+    RM_NEXT(Op::kAddReg);
+random:
+    RM_NEXT(Op::kRandom);
+jump:
+    RM_NEXT(Op::kJump);
+loop:
+    RM_NEXT(Op::kLoop);
+branch:
+    RM_NEXT(Op::kBranch);
+say:
+    RM_NEXT(Op::kSay);
+choice:
+    RM_NEXT(Op::kChoice);
+
+#undef RM_NEXT
+}
+#endif
+
+using TailHandler = void (*)(const Instruction *code, const Instruction *ip, Machine &machine, std::int64_t acc,
+                             std::uint64_t executed);
+
+template <Op kOp>
+RM_TAIL_HANDLER void tail_handler(const Instruction *code, const Instruction *ip, Machine &machine, std::int64_t acc,
+                                  std::uint64_t executed);
+
+template <std::size_t... kOps>
+constexpr std::array<TailHandler, kOpCount> make_tail_handlers(std::index_sequence<kOps...>)
+{
+    return {&tail_handler<static_cast<Op>(kOps)>...};
+}
+
+inline constexpr std::array<TailHandler, kOpCount> kTailHandlers{
+    make_tail_handlers(std::make_index_sequence<kOpCount>{})};
+
+template <Op kOp>
+RM_TAIL_HANDLER void tail_handler(const Instruction *code, const Instruction *ip, Machine &machine, std::int64_t acc,
+                                  std::uint64_t executed)
+{
+    if constexpr (kOp == Op::kHalt)
+    {
+        machine.acc = acc;
+        machine.executed = executed;
+    }
+    else
+    {
+        ip = step<kOp>(code, ip, machine, acc);
+        RM_MUSTTAIL return kTailHandlers[static_cast<std::size_t>(ip->op)](code, ip, machine, acc, executed + 1);
+    }
+}
+
+inline void run_tail_call(const Instruction *code, Machine &machine)
+{
+    kTailHandlers[static_cast<std::size_t>(code->op)](code, code, machine, machine.acc, machine.executed + 1);
+}
+
+using TableHandler = const Instruction *(*)(const Instruction *code, const Instruction *ip, Machine &machine);
+
+template <Op kOp>
+const Instruction *table_handler(const Instruction *code, const Instruction *ip, Machine &machine)
+{
+    return step<kOp>(code, ip, machine, machine.acc);
+}
+
+template <std::size_t... kOps>
+constexpr std::array<TableHandler, kOpCount> make_table_handlers(std::index_sequence<kOps...>)
+{
+    return {&table_handler<static_cast<Op>(kOps)>...};
+}
+
+inline constexpr std::array<TableHandler, kOpCount> kTableHandlers{
+    make_table_handlers(std::make_index_sequence<kOpCount>{})};
+
+inline void run_table(const Instruction *code, Machine &machine)
+{
+    std::uint64_t executed{machine.executed};
+    const Instruction *ip{code};
+    while (ip != nullptr)
+    {
+        ++executed;
+        ip = kTableHandlers[static_cast<std::size_t>(ip->op)](code, ip, machine);
+    }
+    machine.executed = executed;
+}
+
+#undef RM_INTERPRETER_INLINE
+#undef RM_TAIL_HANDLER
+#undef RM_MUSTTAIL
+
+} // namespace detail
+
+// Runs the program from its first instruction until kHalt, starting from
+// the given machine, and returns the machine. Throws std::invalid_argument
+// for an invalid program or an unsupported strategy.
+inline Machine run(const Program &program, Dispatch dispatch, Machine machine = {})
+{
+    validate(program);
+    if (!is_supported(dispatch))
+        throw std::invalid_argument{std::string{to_string(dispatch)} + " is not supported by this compiler"};
+    switch (dispatch)
+    {
+    case Dispatch::kSwitch:
+        detail::run_switch(program.data(), machine);
+        break;
+#if defined(__GNUC__)
+    case Dispatch::kComputedGoto:
+        detail::run_computed_goto(program.data(), machine);
+        break;
+#endif
+    case Dispatch::kTailCall:
+        detail::run_tail_call(program.data(), machine);
+        break;
+    case Dispatch::kTable:
+        detail::run_table(program.data(), machine);
+        break;
+    default:
+        break;
+    }
+    return machine;
+}
+
+} // namespace rm
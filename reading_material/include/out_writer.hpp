@@ -0,0 +1,197 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+// Buffered output for loops that print millions of values (snippets 19, 21,
+// 23 and 25 scaled up). Values are formatted straight into one buffer that
+// is allocated once and handed to write(2) when it fills up, with no
+// locale, no stream state and no stdio locking:
+//
+//     rm::OutWriter out;                // stdout, 64 KiB buffer
+//     for (int n{0}; n < 10000000; ++n)
+//         out << n << ' ';
+//     out << '\n';
+//     out.flush();                      // or let the destructor do it
+//
+// OutWriter bypasses the buffers of std::cout and stdio, so flush those
+// first when mixing them on the same file descriptor.
+namespace rm
+{
+
+enum class FlushPolicy
+{
+    kWhenFull, // write(2) only when the buffer is full, on flush() and at exit
+    kEachLine, // also after every '\n', for output read by a person or a pipe
+};
+
+class OutWriter
+{
+public:
+    explicit OutWriter(int fd = STDOUT_FILENO, std::size_t capacity = 64 * 1024,
+                       FlushPolicy policy = FlushPolicy::kWhenFull)
+        : fd_{fd}, capacity_{capacity < kMaxInteger ? kMaxInteger : capacity},
+          buffer_{new char[capacity_]}, policy_{policy}
+    {
+    }
+
+    OutWriter(const OutWriter &) = delete;
+    OutWriter &operator=(const OutWriter &) = delete;
+
+    ~OutWriter() { flush(); }
+
+    OutWriter &operator<<(char c)
+    {
+        if (used_ == capacity_)
+            flush();
+        buffer_[used_++] = c;
+        if (c == '\n' && policy_ == FlushPolicy::kEachLine)
+            flush();
+        return *this;
+    }
+
+    OutWriter &operator<<(std::string_view text)
+    {
+        bool newline{policy_ == FlushPolicy::kEachLine &&
+                     text.find('\n') != std::string_view::npos};
+        while (!text.empty())
+        {
+            if (used_ == capacity_)
+                flush();
+            std::size_t count{std::min(text.size(), capacity_ - used_)};
+            std::memcpy(buffer_.get() + used_, text.data(), count);
+            used_ += count;
+            text.remove_prefix(count);
+        }
+        if (newline)
+            flush();
+        return *this;
+    }
+
+    OutWriter &operator<<(const char *text) { return *this << std::string_view{text}; }
+
+    // 1/0 like std::cout, or true/false after set_boolalpha(true)
+    OutWriter &operator<<(bool value)
+    {
+        if (boolalpha_)
+            return *this << (value ? std::string_view{"true"} : std::string_view{"false"});
+        return *this << (value ? '1' : '0');
+    }
+
+    // like std::cout, signed and unsigned char print as characters
+    OutWriter &operator<<(signed char c) { return *this << static_cast<char>(c); }
+    OutWriter &operator<<(unsigned char c) { return *this << static_cast<char>(c); }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                          !std::is_same_v<T, char> &&
+                                          !std::is_same_v<T, signed char> &&
+                                          !std::is_same_v<T, unsigned char>>>
+    OutWriter &operator<<(T value)
+    {
+        if (capacity_ - used_ < kMaxInteger)
+            flush();
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (value < 0)
+            {
+                buffer_[used_++] = '-';
+                // negate in unsigned arithmetic, which is defined for the minimum
+                used_ += format(0 - static_cast<std::uint64_t>(value), buffer_.get() + used_);
+                return *this;
+            }
+        }
+        used_ += format(static_cast<std::uint64_t>(value), buffer_.get() + used_);
+        return *this;
+    }
+
+    void set_boolalpha(bool enabled) { boolalpha_ = enabled; }
+    void set_flush_policy(FlushPolicy policy) { policy_ = policy; }
+
+    // Hand the buffered bytes to the kernel; returns false on a write error
+    bool flush()
+    {
+        std::size_t done{0};
+        while (done < used_)
+        {
+            ssize_t written{::write(fd_, buffer_.get() + done, used_ - done)};
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+            {
+                used_ = 0;
+                return false;
+            }
+            done += static_cast<std::size_t>(written);
+        }
+        used_ = 0;
+        return true;
+    }
+
+    // Number of decimal digits of value (1 for 0)
+    static int digit_count(std::uint64_t value)
+    {
+        static constexpr std::uint64_t kPowers[]{
+            1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+            10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+            100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+            100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+            100000000000000000ULL, 1000000000000000000ULL,
+            10000000000000000000ULL};
+        // log10 estimated from the bit width (1233 / 4096 ~ log10(2))
+        int bits{64 - __builtin_clzll(value | 1)};
+        int estimate{(bits * 1233) >> 12};
+        return estimate + ((value | 1) >= kPowers[estimate]);
+    }
+
+    // Write the digits of value at out, two at a time from the right;
+    // returns the number of characters written
+    static int format(std::uint64_t value, char *out)
+    {
+        static constexpr char kPairs[201]{
+            "00010203040506070809101112131415161718192021222324"
+            "25262728293031323334353637383940414243444546474849"
+            "50515253545556575859606162636465666768697071727374"
+            "75767778798081828384858687888990919293949596979899"};
+        int count{digit_count(value)};
+        char *end{out + count};
+        while (value >= 100)
+        {
+            const char *pair{kPairs + (value % 100) * 2};
+            value /= 100;
+            end -= 2;
+            end[0] = pair[0];
+            end[1] = pair[1];
+        }
+        if (value >= 10)
+        {
+            end -= 2;
+            end[0] = kPairs[value * 2];
+            end[1] = kPairs[value * 2 + 1];
+        }
+        else
+        {
+            *--end = static_cast<char>('0' + value);
+        }
+        return count;
+    }
+
+private:
+    static constexpr std::size_t kMaxInteger{21}; // sign and 20 digits
+
+    int fd_;
+    std::size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t used_{0};
+    FlushPolicy policy_;
+    bool boolalpha_{false};
+};
+
+} // namespace rm
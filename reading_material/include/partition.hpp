@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "reduce.hpp"
+
+// Snippet 4 tells odd from even with % and an if; snippets 7 and 17 tell
+// positive from negative. Asked of every value of a large array, the if
+// is a branch the CPU mispredicts whenever the answers look random, and
+// each miss costs about as much as classifying a dozen values. The
+// functions here classify without branches and write out the values (or
+// the indices) that match, in order:
+//
+//     std::vector<int> odd(values.size());
+//     odd.resize(rm::select_values(values.data(), values.size(), {rm::Property::kOdd}, odd.data()));
+//
+// The scalar kernels store every value and advance the output by 0 or 1.
+// The vector kernels compare 8 (AVX2) or 16 (AVX-512) values at once and
+// pack the matching ones together: AVX-512 with a compress instruction,
+// AVX2 with a permutation looked up from the comparison's bit mask. As in
+// reduce.hpp, the widest supported kernel is picked at run time.
+//
+// Outputs must have room for size values; they are written in full
+// vectors, never past index size. select_values() may write over its
+// input (out == data), which filters an array in place.
+namespace rm
+{
+
+enum class Property
+{
+    kOdd,
+    kEven,
+    kPositive,
+    kNegative,
+    kZero,
+    kInRange, // low <= x <= high
+};
+
+struct Filter
+{
+    Property property;
+    int low{0}; // kInRange only, low <= high
+    int high{0};
+};
+
+namespace detail
+{
+
+// One test per property, for one value and for a vector of values
+struct OddTest
+{
+    bool operator()(int x) const { return x & 1; }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        const __m256i one{_mm256_set1_epi32(1)};
+        return _mm256_cmpeq_epi32(_mm256_and_si256(v, one), one);
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_test_epi32_mask(v, _mm512_set1_epi32(1));
+    }
+#endif
+};
+
+struct EvenTest
+{
+    bool operator()(int x) const { return !(x & 1); }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        return _mm256_cmpeq_epi32(_mm256_and_si256(v, _mm256_set1_epi32(1)), _mm256_setzero_si256());
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_testn_epi32_mask(v, _mm512_set1_epi32(1));
+    }
+#endif
+};
+
+struct PositiveTest
+{
+    bool operator()(int x) const { return x > 0; }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        return _mm256_cmpgt_epi32(v, _mm256_setzero_si256());
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_cmpgt_epi32_mask(v, _mm512_setzero_si512());
+    }
+#endif
+};
+
+struct NegativeTest
+{
+    bool operator()(int x) const { return x < 0; }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        return _mm256_cmpgt_epi32(_mm256_setzero_si256(), v);
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_cmplt_epi32_mask(v, _mm512_setzero_si512());
+    }
+#endif
+};
+
+struct ZeroTest
+{
+    bool operator()(int x) const { return x == 0; }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        return _mm256_cmpeq_epi32(v, _mm256_setzero_si256());
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_cmpeq_epi32_mask(v, _mm512_setzero_si512());
+    }
+#endif
+};
+
+struct RangeTest
+{
+    int low;
+    int high;
+
+    // one unsigned comparison: x - low wraps around when x < low
+    bool operator()(int x) const
+    {
+        return static_cast<std::uint32_t>(x) - static_cast<std::uint32_t>(low) <=
+               static_cast<std::uint32_t>(high) - static_cast<std::uint32_t>(low);
+    }
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) __m256i avx2(__m256i v) const
+    {
+        // AVX2 compares signed ints only: not (x < low or x > high)
+        __m256i outside{_mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(low), v),
+                                        _mm256_cmpgt_epi32(v, _mm256_set1_epi32(high)))};
+        return _mm256_xor_si256(outside, _mm256_set1_epi32(-1));
+    }
+    __attribute__((target("avx512f"))) __mmask16 avx512(__m512i v) const
+    {
+        return _mm512_mask_cmple_epi32_mask(_mm512_cmpge_epi32_mask(v, _mm512_set1_epi32(low)), v,
+                                            _mm512_set1_epi32(high));
+    }
+#endif
+};
+
+// kernel(test) with the test of filter.property, so that the property is
+// chosen once per array and not once per value
+template <typename Kernel>
+std::size_t with_test(Filter filter, Kernel kernel)
+{
+    switch (filter.property)
+    {
+    case Property::kOdd:
+        return kernel(OddTest{});
+    case Property::kEven:
+        return kernel(EvenTest{});
+    case Property::kPositive:
+        return kernel(PositiveTest{});
+    case Property::kNegative:
+        return kernel(NegativeTest{});
+    case Property::kZero:
+        return kernel(ZeroTest{});
+    default:
+        return kernel(RangeTest{filter.low, filter.high});
+    }
+}
+
+//======== scalar: store always, advance by the test
+
+// The matching values (kIndices false) or their indices into out
+template <bool kIndices, typename Test, typename Out>
+std::size_t select_scalar(const int *data, std::size_t size, Test test, Out *out, std::size_t first = 0)
+{
+    std::size_t count{0};
+    for (std::size_t i{first}; i < size; ++i)
+    {
+        const int x{data[i]};
+        out[count] = kIndices ? static_cast<Out>(i) : static_cast<Out>(x);
+        count += test(x);
+    }
+    return count;
+}
+
+template <typename Test>
+std::size_t partition_scalar(const int *data, std::size_t size, Test test, int *matching, int *rest,
+                             std::size_t first = 0, std::size_t matched = 0)
+{
+    std::size_t other{first - matched};
+    for (std::size_t i{first}; i < size; ++i)
+    {
+        const int x{data[i]};
+        const bool hit{test(x)};
+        matching[matched] = x;
+        rest[other] = x;
+        matched += hit;
+        other += !hit;
+    }
+    return matched;
+}
+
+#ifdef ENPM702_X86
+
+//======== AVX2: permutation table indexed by the 8-bit comparison mask
+
+// For each mask, the lanes whose bit is set, first to last, then zeros
+struct alignas(32) Permutation
+{
+    std::int32_t lanes[8];
+};
+
+constexpr std::array<Permutation, 256> kCompressTable{[] {
+    std::array<Permutation, 256> table{};
+    for (unsigned mask{0}; mask < 256; ++mask)
+    {
+        int count{0};
+        for (int lane{0}; lane < 8; ++lane)
+        {
+            if (mask & (1u << lane))
+                table[mask].lanes[count++] = lane;
+        }
+    }
+    return table;
+}()};
+
+__attribute__((target("avx2"))) inline __m256i compress_avx2(__m256i v, unsigned mask)
+{
+    const __m256i permutation{_mm256_load_si256(reinterpret_cast<const __m256i *>(kCompressTable[mask].lanes))};
+    return _mm256_permutevar8x32_epi32(v, permutation);
+}
+
+__attribute__((target("avx2"))) inline unsigned lane_mask(__m256i hit)
+{
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+}
+
+template <bool kIndices, typename Test, typename Out>
+__attribute__((target("avx2,popcnt"))) std::size_t select_avx2(const int *data, std::size_t size, Test test,
+                                                               Out *out)
+{
+    std::size_t count{0};
+    __m256i index{_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)};
+    const __m256i step{_mm256_set1_epi32(8)};
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        // count <= i, so the 8 stored values end at or before data + i + 8
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        const unsigned mask{lane_mask(test.avx2(v))};
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + count), compress_avx2(kIndices ? index : v, mask));
+        count += static_cast<std::size_t>(__builtin_popcount(mask));
+        index = _mm256_add_epi32(index, step);
+    }
+    return count + select_scalar<kIndices>(data, size, test, out + count, i);
+}
+
+template <typename Test>
+__attribute__((target("avx2,popcnt"))) std::size_t partition_avx2(const int *data, std::size_t size, Test test,
+                                                                  int *matching, int *rest)
+{
+    std::size_t matched{0};
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        const unsigned mask{lane_mask(test.avx2(v))};
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(matching + matched), compress_avx2(v, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(rest + (i - matched)), compress_avx2(v, mask ^ 0xffu));
+        matched += static_cast<std::size_t>(__builtin_popcount(mask));
+    }
+    return partition_scalar(data, size, test, matching, rest, i, matched);
+}
+
+//======== AVX-512: VPCOMPRESSD, the tails with masked loads and stores
+
+ENPM702_SIMD_KERNELS_BEGIN
+
+// The compressed values are stored with a masked store rather than
+// _mm512_mask_compressstoreu_epi32, which is microcoded and much slower on
+// some processors
+template <bool kIndices, typename Test, typename Out>
+__attribute__((target("avx512f,popcnt"))) std::size_t select_avx512(const int *data, std::size_t size,
+                                                                    Test test, Out *out)
+{
+    std::size_t count{0};
+    __m512i index{_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)};
+    const __m512i step{_mm512_set1_epi32(16)};
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const __mmask16 valid{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        __m512i v{_mm512_maskz_loadu_epi32(valid, data + i)};
+        const __mmask16 mask{static_cast<__mmask16>(test.avx512(v) & valid)};
+        const unsigned hits{static_cast<unsigned>(__builtin_popcount(mask))};
+        _mm512_mask_storeu_epi32(out + count, static_cast<__mmask16>((1u << hits) - 1),
+                                 _mm512_maskz_compress_epi32(mask, kIndices ? index : v));
+        count += hits;
+        index = _mm512_add_epi32(index, step);
+    }
+    return count;
+}
+
+template <typename Test>
+__attribute__((target("avx512f,popcnt"))) std::size_t partition_avx512(const int *data, std::size_t size,
+                                                                       Test test, int *matching, int *rest)
+{
+    std::size_t matched{0};
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const std::size_t lanes{std::min<std::size_t>(16, size - i)};
+        const __mmask16 valid{tail_mask(lanes)};
+        __m512i v{_mm512_maskz_loadu_epi32(valid, data + i)};
+        const __mmask16 mask{static_cast<__mmask16>(test.avx512(v) & valid)};
+        const unsigned hits{static_cast<unsigned>(__builtin_popcount(mask))};
+        _mm512_mask_storeu_epi32(matching + matched, static_cast<__mmask16>((1u << hits) - 1),
+                                 _mm512_maskz_compress_epi32(mask, v));
+        _mm512_mask_storeu_epi32(rest + (i - matched), static_cast<__mmask16>((1u << (lanes - hits)) - 1),
+                                 _mm512_maskz_compress_epi32(static_cast<__mmask16>(~mask & valid), v));
+        matched += hits;
+    }
+    return matched;
+}
+
+ENPM702_SIMD_KERNELS_END
+
+#endif // ENPM702_X86
+
+template <bool kIndices, typename Out>
+std::size_t select(const int *data, std::size_t size, Filter filter, Out *out, SimdLevel simd)
+{
+    const SimdLevel level{resolve(simd)};
+    return with_test(filter, [&](auto test) -> std::size_t {
+#ifdef ENPM702_X86
+        if (level == SimdLevel::kAvx512)
+            return select_avx512<kIndices>(data, size, test, out);
+        if (level == SimdLevel::kAvx2)
+            return select_avx2<kIndices>(data, size, test, out);
+#endif
+        return select_scalar<kIndices>(data, size, test, out);
+    });
+}
+
+} // namespace detail
+
+// Copies the values that match filter to out, in order; returns how many
+inline std::size_t select_values(const int *data, std::size_t size, Filter filter, int *out,
+                                 SimdLevel simd = SimdLevel::kAuto)
+{
+    return detail::select<false>(data, size, filter, out, simd);
+}
+
+// Writes the indices of the values that match filter to out, in
+// increasing order; returns how many. size must be below 2^32.
+inline std::size_t select_indices(const int *data, std::size_t size, Filter filter, std::uint32_t *out,
+                                  SimdLevel simd = SimdLevel::kAuto)
+{
+    return detail::select<true>(data, size, filter, out, simd);
+}
+
+// Copies the values that match filter to matching and the others to rest,
+// both in order (a stable partition); returns how many match
+inline std::size_t partition_values(const int *data, std::size_t size, Filter filter, int *matching, int *rest,
+                                    SimdLevel simd = SimdLevel::kAuto)
+{
+    const SimdLevel level{resolve(simd)};
+    return detail::with_test(filter, [&](auto test) -> std::size_t {
+#ifdef ENPM702_X86
+        if (level == SimdLevel::kAvx512)
+            return detail::partition_avx512(data, size, test, matching, rest);
+        if (level == SimdLevel::kAvx2)
+            return detail::partition_avx2(data, size, test, matching, rest);
+#endif
+        return detail::partition_scalar(data, size, test, matching, rest);
+    });
+}
+
+} // namespace rm
@@ -0,0 +1,517 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "simd_dispatch.hpp"
+
+// Snippets 5 and 6 keep the larger of two ints. The same question asked of
+// a whole array is a reduction, and this header has the common ones for
+// int arrays:
+//
+//     std::vector<int> values(...);
+//     int largest{rm::max_value(values.data(), values.size())};
+//     std::size_t where{rm::argmax(values.data(), values.size())};
+//     std::uint64_t positive{rm::count_if(values.data(), values.size(), {rm::Compare::kGreater, 0})};
+//
+// Each reduction has a scalar, an AVX2 and an AVX-512 kernel; the widest
+// one the CPU supports is picked at run time, so the program is built for
+// plain x86-64 and still uses the vector units. Compilers vectorize min,
+// max and sum on their own but not argmax/argmin, which need the index of
+// the first extreme value: the kernels keep one candidate value and index
+// per vector lane and settle the ties at the end.
+//
+// Arrays are cut into blocks of kReduceBlock values. Threads take blocks
+// in any order but the block results are combined in array order, and
+// all results are exact (sums are 64-bit, argmax returns the first
+// index), so the answer does not depend on the number of threads or on
+// the instruction set.
+namespace rm
+{
+
+// The instruction set of a kernel, shared with the other lectures
+using enpm702::detected_simd_level;
+using enpm702::resolve;
+using enpm702::SimdLevel;
+using enpm702::to_string;
+
+enum class Compare
+{
+    kLess,
+    kLessEqual,
+    kGreater,
+    kGreaterEqual,
+    kEqual,
+    kNotEqual,
+};
+
+// x <op> value
+struct Predicate
+{
+    Compare op;
+    int value;
+};
+
+struct ReduceOptions
+{
+    unsigned threads{0};            // 0: one per hardware thread
+    SimdLevel simd{SimdLevel::kAuto}; // lowered to what the CPU supports
+};
+
+// Values per block; also the least work given to a thread
+constexpr std::size_t kReduceBlock{std::size_t{1} << 18};
+
+namespace detail
+{
+
+// The kernels of one instruction set. They work on one block, so counts
+// and indices fit in 32-bit lanes; size is at least 1.
+struct ReduceKernels
+{
+    int (*min)(const int *, std::size_t);
+    int (*max)(const int *, std::size_t);
+    std::size_t (*argmin)(const int *, std::size_t);
+    std::size_t (*argmax)(const int *, std::size_t);
+    std::int64_t (*sum)(const int *, std::size_t);
+    std::uint64_t (*count)(const int *, std::size_t, Predicate);
+};
+
+//======== scalar
+
+inline int min_scalar(const int *data, std::size_t size)
+{
+    int smallest{data[0]};
+    for (std::size_t i{1}; i < size; ++i)
+        smallest = data[i] < smallest ? data[i] : smallest;
+    return smallest;
+}
+
+inline int max_scalar(const int *data, std::size_t size)
+{
+    int largest{data[0]};
+    for (std::size_t i{1}; i < size; ++i)
+        largest = data[i] > largest ? data[i] : largest;
+    return largest;
+}
+
+// First index of the largest (kMax) or smallest value from index first on,
+// starting from the candidate best
+template <bool kMax>
+std::size_t arg_scalar(const int *data, std::size_t first, std::size_t size, std::size_t best)
+{
+    for (std::size_t i{first}; i < size; ++i)
+    {
+        if (kMax ? data[i] > data[best] : data[i] < data[best])
+            best = i;
+    }
+    return best;
+}
+
+inline std::size_t argmin_scalar(const int *data, std::size_t size)
+{
+    return arg_scalar<false>(data, 1, size, 0);
+}
+
+inline std::size_t argmax_scalar(const int *data, std::size_t size)
+{
+    return arg_scalar<true>(data, 1, size, 0);
+}
+
+inline std::int64_t sum_scalar(const int *data, std::size_t size)
+{
+    std::int64_t sum{0};
+    for (std::size_t i{0}; i < size; ++i)
+        sum += data[i];
+    return sum;
+}
+
+template <typename Test>
+std::uint64_t count_scalar(const int *data, std::size_t size, Test test)
+{
+    std::uint64_t count{0};
+    for (std::size_t i{0}; i < size; ++i)
+        count += test(data[i]);
+    return count;
+}
+
+// The switch outside the loop, so that each loop is branch-free
+inline std::uint64_t count_scalar(const int *data, std::size_t size, Predicate predicate)
+{
+    const int v{predicate.value};
+    switch (predicate.op)
+    {
+    case Compare::kLess:
+        return count_scalar(data, size, [v](int x) { return x < v; });
+    case Compare::kLessEqual:
+        return count_scalar(data, size, [v](int x) { return x <= v; });
+    case Compare::kGreater:
+        return count_scalar(data, size, [v](int x) { return x > v; });
+    case Compare::kGreaterEqual:
+        return count_scalar(data, size, [v](int x) { return x >= v; });
+    case Compare::kEqual:
+        return count_scalar(data, size, [v](int x) { return x == v; });
+    default:
+        return count_scalar(data, size, [v](int x) { return x != v; });
+    }
+}
+
+#ifdef ENPM702_X86
+
+//======== AVX2: 8 ints per vector, the tails in scalar code
+
+template <bool kMax>
+__attribute__((target("avx2"))) int extreme_avx2(const int *data, std::size_t size)
+{
+    if (size < 8)
+        return kMax ? max_scalar(data, size) : min_scalar(data, size);
+    __m256i best{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data))};
+    std::size_t i{8};
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        best = kMax ? _mm256_max_epi32(best, v) : _mm256_min_epi32(best, v);
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), best);
+    int result{kMax ? max_scalar(lanes, 8) : min_scalar(lanes, 8)};
+    for (; i < size; ++i)
+        result = (kMax ? data[i] > result : data[i] < result) ? data[i] : result;
+    return result;
+}
+
+template <bool kMax>
+__attribute__((target("avx2"))) std::size_t arg_avx2(const int *data, std::size_t size)
+{
+    if (size < 8)
+        return arg_scalar<kMax>(data, 1, size, 0);
+    // lane k holds the best of data[k], data[k + 8], ... and its index;
+    // a strict comparison keeps the first of equal values
+    __m256i best{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data))};
+    __m256i best_index{_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)};
+    __m256i index{best_index};
+    const __m256i step{_mm256_set1_epi32(8)};
+    std::size_t i{8};
+    for (; i + 8 <= size; i += 8)
+    {
+        index = _mm256_add_epi32(index, step);
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        __m256i better{kMax ? _mm256_cmpgt_epi32(v, best) : _mm256_cmpgt_epi32(best, v)};
+        best = _mm256_blendv_epi8(best, v, better);
+        best_index = _mm256_blendv_epi8(best_index, index, better);
+    }
+    alignas(32) int values[8];
+    alignas(32) int indices[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(values), best);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(indices), best_index);
+    std::size_t result{static_cast<std::size_t>(indices[0])};
+    for (int k{1}; k < 8; ++k)
+    {
+        const auto candidate{static_cast<std::size_t>(indices[k])};
+        if ((kMax ? values[k] > data[result] : values[k] < data[result]) ||
+            (values[k] == data[result] && candidate < result))
+            result = candidate;
+    }
+    return arg_scalar<kMax>(data, i, size, result);
+}
+
+__attribute__((target("avx2"))) inline std::int64_t sum_avx2(const int *data, std::size_t size)
+{
+    __m256i low{_mm256_setzero_si256()};
+    __m256i high{_mm256_setzero_si256()};
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        low = _mm256_add_epi64(low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        high = _mm256_add_epi64(high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), _mm256_add_epi64(low, high));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) inline std::uint64_t count_avx2(const int *data, std::size_t size,
+                                                                Predicate predicate)
+{
+    // AVX2 compares for > and == only: x < v is v > x, and <=, >= and !=
+    // count the complement
+    const __m256i value{_mm256_set1_epi32(predicate.value)};
+    const bool swap{predicate.op == Compare::kLess || predicate.op == Compare::kGreaterEqual};
+    const bool equal{predicate.op == Compare::kEqual || predicate.op == Compare::kNotEqual};
+    const bool complement{predicate.op == Compare::kLessEqual || predicate.op == Compare::kGreaterEqual ||
+                          predicate.op == Compare::kNotEqual};
+    __m256i counts{_mm256_setzero_si256()}; // matches per lane; a hit is -1
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+        __m256i hit{equal  ? _mm256_cmpeq_epi32(v, value)
+                    : swap ? _mm256_cmpgt_epi32(value, v)
+                           : _mm256_cmpgt_epi32(v, value)};
+        counts = _mm256_sub_epi32(counts, hit);
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), counts);
+    std::uint64_t count{0};
+    for (std::int32_t lane : lanes)
+        count += static_cast<std::uint32_t>(lane);
+    if (complement)
+        count = i - count;
+    return count + count_scalar(data + i, size - i, predicate);
+}
+
+inline int min_avx2(const int *data, std::size_t size) { return extreme_avx2<false>(data, size); }
+inline int max_avx2(const int *data, std::size_t size) { return extreme_avx2<true>(data, size); }
+inline std::size_t argmin_avx2(const int *data, std::size_t size) { return arg_avx2<false>(data, size); }
+inline std::size_t argmax_avx2(const int *data, std::size_t size) { return arg_avx2<true>(data, size); }
+
+//======== AVX-512: 16 ints per vector, the tails with masked loads
+
+ENPM702_SIMD_KERNELS_BEGIN
+
+__attribute__((target("avx512f"))) inline __mmask16 tail_mask(std::size_t remaining)
+{
+    return static_cast<__mmask16>((1u << remaining) - 1);
+}
+
+template <bool kMax>
+__attribute__((target("avx512f"))) int extreme_avx512(const int *data, std::size_t size)
+{
+    __m512i best{_mm512_set1_epi32(data[0])};
+    std::size_t i{0};
+    for (; i + 16 <= size; i += 16)
+    {
+        __m512i v{_mm512_loadu_si512(data + i)};
+        best = kMax ? _mm512_max_epi32(best, v) : _mm512_min_epi32(best, v);
+    }
+    if (i < size)
+    {
+        const __mmask16 mask{tail_mask(size - i)};
+        __m512i v{_mm512_maskz_loadu_epi32(mask, data + i)};
+        best = kMax ? _mm512_mask_max_epi32(best, mask, best, v) : _mm512_mask_min_epi32(best, mask, best, v);
+    }
+    return kMax ? _mm512_reduce_max_epi32(best) : _mm512_reduce_min_epi32(best);
+}
+
+template <bool kMax>
+__attribute__((target("avx512f"))) std::size_t arg_avx512(const int *data, std::size_t size)
+{
+    // as arg_avx2(), lanes start at data[0] with index 0 so that every
+    // lane holds a real element
+    __m512i best{_mm512_set1_epi32(data[0])};
+    __m512i best_index{_mm512_setzero_si512()};
+    __m512i index{_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)};
+    const __m512i step{_mm512_set1_epi32(16)};
+    std::size_t i{0};
+    for (; i < size; i += 16)
+    {
+        const __mmask16 mask{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        __m512i v{_mm512_maskz_loadu_epi32(mask, data + i)};
+        const __mmask16 better{kMax ? _mm512_mask_cmpgt_epi32_mask(mask, v, best)
+                                    : _mm512_mask_cmplt_epi32_mask(mask, v, best)};
+        best = _mm512_mask_mov_epi32(best, better, v);
+        best_index = _mm512_mask_mov_epi32(best_index, better, index);
+        index = _mm512_add_epi32(index, step);
+    }
+    const int extreme{kMax ? _mm512_reduce_max_epi32(best) : _mm512_reduce_min_epi32(best)};
+    const __mmask16 winners{_mm512_cmpeq_epi32_mask(best, _mm512_set1_epi32(extreme))};
+    const __m512i none{_mm512_set1_epi32(std::numeric_limits<int>::max())};
+    return static_cast<std::size_t>(_mm512_reduce_min_epi32(_mm512_mask_mov_epi32(none, winners, best_index)));
+}
+
+__attribute__((target("avx512f"))) inline std::int64_t sum_avx512(const int *data, std::size_t size)
+{
+    __m512i low{_mm512_setzero_si512()};
+    __m512i high{_mm512_setzero_si512()};
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const __mmask16 mask{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        __m512i v{_mm512_maskz_loadu_epi32(mask, data + i)};
+        low = _mm512_add_epi64(low, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        high = _mm512_add_epi64(high, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+    }
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(low, high));
+}
+
+template <int kCompare>
+__attribute__((target("avx512f,popcnt"))) std::uint64_t count_compare_avx512(const int *data, std::size_t size,
+                                                                             int value)
+{
+    const __m512i broadcast{_mm512_set1_epi32(value)};
+    std::uint64_t count{0};
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const __mmask16 mask{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        __m512i v{_mm512_maskz_loadu_epi32(mask, data + i)};
+        count += static_cast<std::uint64_t>(
+            __builtin_popcount(_mm512_mask_cmp_epi32_mask(mask, v, broadcast, kCompare)));
+    }
+    return count;
+}
+
+inline std::uint64_t count_avx512(const int *data, std::size_t size, Predicate predicate)
+{
+    switch (predicate.op)
+    {
+    case Compare::kLess:
+        return count_compare_avx512<_MM_CMPINT_LT>(data, size, predicate.value);
+    case Compare::kLessEqual:
+        return count_compare_avx512<_MM_CMPINT_LE>(data, size, predicate.value);
+    case Compare::kGreater:
+        return count_compare_avx512<_MM_CMPINT_NLE>(data, size, predicate.value);
+    case Compare::kGreaterEqual:
+        return count_compare_avx512<_MM_CMPINT_NLT>(data, size, predicate.value);
+    case Compare::kEqual:
+        return count_compare_avx512<_MM_CMPINT_EQ>(data, size, predicate.value);
+    default:
+        return count_compare_avx512<_MM_CMPINT_NE>(data, size, predicate.value);
+    }
+}
+
+inline int min_avx512(const int *data, std::size_t size) { return extreme_avx512<false>(data, size); }
+inline int max_avx512(const int *data, std::size_t size) { return extreme_avx512<true>(data, size); }
+inline std::size_t argmin_avx512(const int *data, std::size_t size) { return arg_avx512<false>(data, size); }
+inline std::size_t argmax_avx512(const int *data, std::size_t size) { return arg_avx512<true>(data, size); }
+
+ENPM702_SIMD_KERNELS_END
+
+#endif // ENPM702_X86
+
+inline const ReduceKernels &kernels(SimdLevel requested)
+{
+    static const ReduceKernels scalar{min_scalar,    max_scalar, argmin_scalar,
+                                      argmax_scalar, sum_scalar, count_scalar};
+#ifdef ENPM702_X86
+    static const ReduceKernels avx2{min_avx2, max_avx2, argmin_avx2, argmax_avx2, sum_avx2, count_avx2};
+    static const ReduceKernels avx512{min_avx512,    max_avx512, argmin_avx512,
+                                      argmax_avx512, sum_avx512, count_avx512};
+    switch (resolve(requested))
+    {
+    case SimdLevel::kAvx512:
+        return avx512;
+    case SimdLevel::kAvx2:
+        return avx2;
+    default:
+        break;
+    }
+#endif
+    return scalar;
+}
+
+// block_result(first, count) for every block, on up to options.threads
+// threads; the results in array order
+template <typename Result, typename BlockResult>
+std::vector<Result> reduce_blocks(std::size_t size, const ReduceOptions &options, BlockResult block_result)
+{
+    const std::size_t blocks{(size + kReduceBlock - 1) / kReduceBlock};
+    std::vector<Result> results(blocks);
+    unsigned threads{options.threads ? options.threads : std::thread::hardware_concurrency()};
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(threads, 1, blocks));
+    std::atomic<std::size_t> next_block{0};
+    auto work{[&] {
+        for (std::size_t block{next_block++}; block < blocks; block = next_block++)
+        {
+            const std::size_t first{block * kReduceBlock};
+            results[block] = block_result(first, std::min(kReduceBlock, size - first));
+        }
+    }};
+    std::vector<std::thread> workers;
+    for (unsigned t{1}; t < threads; ++t)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+    return results;
+}
+
+template <bool kMax>
+std::size_t arg_extreme(const int *data, std::size_t size, const ReduceOptions &options)
+{
+    if (size == 0)
+        return 0;
+    const ReduceKernels &kernel{kernels(options.simd)};
+    auto blocks{reduce_blocks<std::size_t>(size, options, [&](std::size_t first, std::size_t count) {
+        return first + (kMax ? kernel.argmax : kernel.argmin)(data + first, count);
+    })};
+    std::size_t best{blocks[0]};
+    for (std::size_t index : blocks)
+    {
+        if (kMax ? data[index] > data[best] : data[index] < data[best])
+            best = index;
+    }
+    return best;
+}
+
+} // namespace detail
+
+// The smallest value; INT_MAX if size is 0
+inline int min_value(const int *data, std::size_t size, const ReduceOptions &options = {})
+{
+    if (size == 0)
+        return std::numeric_limits<int>::max();
+    const detail::ReduceKernels &kernel{detail::kernels(options.simd)};
+    auto blocks{detail::reduce_blocks<int>(
+        size, options, [&](std::size_t first, std::size_t count) { return kernel.min(data + first, count); })};
+    return *std::min_element(blocks.begin(), blocks.end());
+}
+
+// The largest value; INT_MIN if size is 0
+inline int max_value(const int *data, std::size_t size, const ReduceOptions &options = {})
+{
+    if (size == 0)
+        return std::numeric_limits<int>::min();
+    const detail::ReduceKernels &kernel{detail::kernels(options.simd)};
+    auto blocks{detail::reduce_blocks<int>(
+        size, options, [&](std::size_t first, std::size_t count) { return kernel.max(data + first, count); })};
+    return *std::max_element(blocks.begin(), blocks.end());
+}
+
+// The index of the first smallest value; 0 if size is 0
+inline std::size_t argmin(const int *data, std::size_t size, const ReduceOptions &options = {})
+{
+    return detail::arg_extreme<false>(data, size, options);
+}
+
+// The index of the first largest value; 0 if size is 0
+inline std::size_t argmax(const int *data, std::size_t size, const ReduceOptions &options = {})
+{
+    return detail::arg_extreme<true>(data, size, options);
+}
+
+// The sum, which cannot overflow for fewer than 2^32 values
+inline std::int64_t sum(const int *data, std::size_t size, const ReduceOptions &options = {})
+{
+    if (size == 0)
+        return 0;
+    const detail::ReduceKernels &kernel{detail::kernels(options.simd)};
+    auto blocks{detail::reduce_blocks<std::int64_t>(
+        size, options, [&](std::size_t first, std::size_t count) { return kernel.sum(data + first, count); })};
+    std::int64_t total{0};
+    for (std::int64_t block : blocks)
+        total += block;
+    return total;
+}
+
+// The number of values x for which `x <op> predicate.value` holds
+inline std::uint64_t count_if(const int *data, std::size_t size, Predicate predicate,
+                              const ReduceOptions &options = {})
+{
+    if (size == 0)
+        return 0;
+    const detail::ReduceKernels &kernel{detail::kernels(options.simd)};
+    auto blocks{detail::reduce_blocks<std::uint64_t>(size, options, [&](std::size_t first, std::size_t count) {
+        return kernel.count(data + first, count, predicate);
+    })};
+    std::uint64_t total{0};
+    for (std::uint64_t block : blocks)
+        total += block;
+    return total;
+}
+
+} // namespace rm
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Prompt loops as coroutines, so that one thread can run many interactive
+// sessions at once. A session program reads with co_await instead of
+// std::cin >> and writes to the session instead of std::cout:
+//
+//     rm::SessionTask loop_again(rm::Session &session)
+//     {
+//         while (true)
+//         {
+//             session << "Loop again (y/n)? ";
+//             std::optional<char> input{co_await session.read<char>()};
+//             if (!input || *input == 'n')
+//                 co_return;
+//         }
+//     }
+//
+//     rm::SessionLoop loop;
+//     loop.add("y\ny\nn\n", loop_again);
+//     loop.run();
+//     // loop.session(0).output() holds the transcript
+//
+// read() suspends the program until its session has received a complete
+// token, as operator>> would block. SessionLoop hands every session its
+// input script one line at a time, as if a user typed it, and resumes the
+// programs that were waiting; no thread blocks and no process is started
+// per session. Needs C++20.
+namespace rm
+{
+
+class SessionTask
+{
+public:
+    struct promise_type
+    {
+        SessionTask get_return_object()
+        {
+            return SessionTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::exception_ptr exception;
+    };
+
+    SessionTask() = default;
+    explicit SessionTask(std::coroutine_handle<promise_type> handle) : handle_{handle} {}
+    SessionTask(SessionTask &&other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+    SessionTask &operator=(SessionTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    SessionTask(const SessionTask &) = delete;
+    SessionTask &operator=(const SessionTask &) = delete;
+    ~SessionTask()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    bool done() const { return !handle_ || handle_.done(); }
+
+    // Run until the program suspends or ends; rethrows what it threw
+    void resume()
+    {
+        handle_.resume();
+        if (handle_.done() && handle_.promise().exception)
+            std::rethrow_exception(handle_.promise().exception);
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// The input received so far and the output written by one session
+class Session
+{
+public:
+    template <typename T>
+    class ReadAwaiter
+    {
+    public:
+        explicit ReadAwaiter(Session &session) : session_{session} {}
+
+        bool await_ready() { return session_.has_token<T>(); }
+        void await_suspend(std::coroutine_handle<>)
+        {
+            session_.waiting_for_ = std::is_same_v<T, char> ? Token::kChar : Token::kInt;
+        }
+        std::optional<T> await_resume()
+        {
+            session_.waiting_for_ = Token::kNone;
+            return session_.extract<T>();
+        }
+
+    private:
+        Session &session_;
+    };
+
+    // Next char (whitespace skipped) or int, as std::cin >> reads them;
+    // std::nullopt at the end of the input or for malformed text, where
+    // std::cin would set failbit
+    template <typename T>
+    ReadAwaiter<T> read()
+    {
+        static_assert(std::is_same_v<T, char> || std::is_same_v<T, int>, "read<char>() or read<int>()");
+        return ReadAwaiter<T>{*this};
+    }
+
+    Session &operator<<(std::string_view text)
+    {
+        output_ += text;
+        return *this;
+    }
+    Session &operator<<(const char *text) { return *this << std::string_view{text}; }
+    Session &operator<<(char c)
+    {
+        output_ += c;
+        return *this;
+    }
+    Session &operator<<(int value)
+    {
+        char digits[16];
+        auto result{std::to_chars(digits, digits + sizeof digits, value)};
+        output_.append(digits, result.ptr);
+        return *this;
+    }
+
+    const std::string &output() const { return output_; }
+
+    // Used by SessionLoop
+    void feed(std::string_view text) { input_ += text; }
+    void close_input() { closed_ = true; }
+
+    // The program waits on a read that the input received can now answer
+    bool can_resume()
+    {
+        return waiting_for_ == Token::kChar ? has_token<char>() : waiting_for_ == Token::kInt && has_token<int>();
+    }
+
+private:
+    enum class Token
+    {
+        kNone,
+        kChar,
+        kInt
+    };
+
+    void skip_space()
+    {
+        while (position_ < input_.size() && std::isspace(static_cast<unsigned char>(input_[position_])))
+            ++position_;
+        // drop what has been read once it is most of the buffer
+        if (position_ > 4096 && position_ * 2 > input_.size())
+        {
+            input_.erase(0, position_);
+            position_ = 0;
+        }
+    }
+
+    // True when extract<T>() can answer without more input
+    template <typename T>
+    bool has_token()
+    {
+        skip_space();
+        if (closed_)
+            return true;
+        if (position_ == input_.size())
+            return false;
+        if constexpr (std::is_same_v<T, char>)
+            return true;
+        // an int may continue in the next line received, unless whitespace
+        // already ends it
+        for (std::size_t i{position_}; i < input_.size(); ++i)
+        {
+            if (std::isspace(static_cast<unsigned char>(input_[i])))
+                return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    std::optional<T> extract()
+    {
+        skip_space();
+        if (failed_ || position_ == input_.size())
+            return std::nullopt;
+        if constexpr (std::is_same_v<T, char>)
+        {
+            return input_[position_++];
+        }
+        else
+        {
+            const char *first{input_.data() + position_};
+            const char *last{input_.data() + input_.size()};
+            if (*first == '+' && first + 1 != last && first[1] != '-')
+                ++first;
+            int value{};
+            auto [end, ec]{std::from_chars(first, last, value)};
+            if (ec != std::errc{})
+            {
+                failed_ = true; // as failbit, every later read fails
+                return std::nullopt;
+            }
+            position_ = static_cast<std::size_t>(end - input_.data());
+            return value;
+        }
+    }
+
+    std::string input_;
+    std::size_t position_{0};
+    bool closed_{false};
+    bool failed_{false};
+    Token waiting_for_{Token::kNone};
+    std::string output_;
+};
+
+using SessionProgram = SessionTask (*)(Session &);
+
+// Runs sessions on the calling thread, interleaving them line by line
+class SessionLoop
+{
+public:
+    // Queue a session that will receive script, one line per step
+    void add(std::string script, SessionProgram program)
+    {
+        auto entry{std::make_unique<Entry>()};
+        entry->script = std::move(script);
+        entry->task = program(entry->session);
+        entries_.push_back(std::move(entry));
+    }
+
+    // Run every session to its end
+    void run()
+    {
+        std::vector<Entry *> waiting;
+        for (auto &entry : entries_)
+        {
+            entry->task.resume();
+            if (!entry->task.done())
+                waiting.push_back(entry.get());
+        }
+        // each pass gives one more line to every waiting session
+        std::vector<Entry *> still_waiting;
+        while (!waiting.empty())
+        {
+            for (Entry *entry : waiting)
+            {
+                entry->deliver_line();
+                if (entry->session.can_resume())
+                    entry->task.resume();
+                if (!entry->task.done())
+                    still_waiting.push_back(entry);
+            }
+            waiting.swap(still_waiting);
+            still_waiting.clear();
+        }
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    const Session &session(std::size_t index) const { return entries_[index]->session; }
+
+private:
+    struct Entry
+    {
+        void deliver_line()
+        {
+            if (next >= script.size())
+            {
+                session.close_input();
+                return;
+            }
+            std::size_t end{script.find('\n', next)};
+            end = end == std::string::npos ? script.size() : end + 1;
+            session.feed(std::string_view{script}.substr(next, end - next));
+            next = end;
+        }
+
+        Session session;
+        std::string script;
+        std::size_t next{0};
+        SessionTask task;
+    };
+
+    std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+} // namespace rm
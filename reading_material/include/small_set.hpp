@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "reduce.hpp"
+
+// Snippets 42 and 43 test membership with chains of comparisons:
+//
+//     pp == 1 || pp == 2 || pp == 4
+//     qq > 0 && qq < 6 && qq != 3
+//
+// Each link is a compare and often a branch. The same sets written as
+//
+//     rm::SmallSet<1, 2, 4>::contains(pp)
+//     rm::RangeExcept<1, 5, 3>::contains(qq)   // 1..5 without 3
+//
+// are turned at compile time into one test whatever their size:
+//
+// - values within 64 of each other: a 64-bit mask, tested with one
+//   subtraction, one comparison and one shift (x - low wraps around to a
+//   large unsigned number when x < low);
+// - values within kSmallSetTableBits of each other: a bit table in memory;
+// - farther apart: the chain of == comparisons, as written by hand.
+//
+// count_matching() and evaluate() test a whole array with AVX2 or AVX-512
+// (variable shifts for the masks, gathers for the tables), picked at run
+// time as in reduce.hpp. contains() is constexpr.
+namespace rm
+{
+
+// Largest span (high - low + 1) of a set stored as a bit table
+constexpr long long kSmallSetTableBits{4096};
+
+namespace detail
+{
+
+enum class SetKind
+{
+    kMask,
+    kTable,
+    kChain,
+};
+
+constexpr SetKind set_kind(long long span)
+{
+    return span < 64 ? SetKind::kMask : span < kSmallSetTableBits ? SetKind::kTable : SetKind::kChain;
+}
+
+constexpr std::uint32_t offset(int x, int low)
+{
+    return static_cast<std::uint32_t>(x) - static_cast<std::uint32_t>(low);
+}
+
+// The set {low + k : bit k of mask}, k < 64
+template <int kLow, std::uint64_t kMask>
+constexpr bool mask_contains(int x)
+{
+    const std::uint32_t d{offset(x, kLow)};
+    return (d < 64) & static_cast<bool>((kMask >> (d & 63)) & 1);
+}
+
+// The set {low + k : bit k of table}, 32 bits per word
+template <int kLow, std::size_t kWords>
+constexpr bool table_contains(const std::array<std::uint32_t, kWords> &table, int x)
+{
+    const std::uint32_t d{offset(x, kLow)};
+    const std::uint32_t last{kWords * 32 - 1};
+    // the clamped index keeps the load inside the table without a branch
+    return (d <= last) & static_cast<bool>((table[std::min(d, last) >> 5] >> (d & 31)) & 1);
+}
+
+#ifdef ENPM702_X86
+
+// The vector tests return all ones (AVX2) or a set bit (AVX-512) for each
+// lane that is in the set. Variable shifts by 32 or more give 0, which
+// takes care of the values outside the mask.
+
+template <int kLow, std::uint64_t kMask>
+__attribute__((target("avx2"))) __m256i mask_avx2(__m256i x)
+{
+    const __m256i d{_mm256_sub_epi32(x, _mm256_set1_epi32(kLow))};
+    __m256i bits{_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(kMask & 0xffffffffu)), d)};
+    if constexpr ((kMask >> 32) != 0)
+    {
+        const __m256i high_d{_mm256_sub_epi32(d, _mm256_set1_epi32(32))};
+        bits = _mm256_or_si256(bits, _mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(kMask >> 32)), high_d));
+    }
+    const __m256i one{_mm256_set1_epi32(1)};
+    return _mm256_cmpeq_epi32(_mm256_and_si256(bits, one), one);
+}
+
+template <int kLow, std::size_t kWords>
+__attribute__((target("avx2"))) __m256i table_avx2(const std::array<std::uint32_t, kWords> &table, __m256i x)
+{
+    const __m256i d{_mm256_sub_epi32(x, _mm256_set1_epi32(kLow))};
+    const __m256i last{_mm256_set1_epi32(static_cast<int>(kWords * 32 - 1))};
+    const __m256i clamped{_mm256_min_epu32(d, last)};
+    const __m256i words{_mm256_i32gather_epi32(reinterpret_cast<const int *>(table.data()),
+                                               _mm256_srli_epi32(clamped, 5), 4)};
+    const __m256i bits{_mm256_srlv_epi32(words, _mm256_and_si256(d, _mm256_set1_epi32(31)))};
+    const __m256i one{_mm256_set1_epi32(1)};
+    const __m256i inside{_mm256_cmpeq_epi32(clamped, d)};
+    return _mm256_and_si256(inside, _mm256_cmpeq_epi32(_mm256_and_si256(bits, one), one));
+}
+
+ENPM702_SIMD_KERNELS_BEGIN
+
+template <int kLow, std::uint64_t kMask>
+__attribute__((target("avx512f"))) __mmask16 mask_avx512(__m512i x)
+{
+    const __m512i d{_mm512_sub_epi32(x, _mm512_set1_epi32(kLow))};
+    __m512i bits{_mm512_srlv_epi32(_mm512_set1_epi32(static_cast<int>(kMask & 0xffffffffu)), d)};
+    if constexpr ((kMask >> 32) != 0)
+    {
+        const __m512i high_d{_mm512_sub_epi32(d, _mm512_set1_epi32(32))};
+        bits = _mm512_or_si512(bits, _mm512_srlv_epi32(_mm512_set1_epi32(static_cast<int>(kMask >> 32)), high_d));
+    }
+    return _mm512_test_epi32_mask(bits, _mm512_set1_epi32(1));
+}
+
+template <int kLow, std::size_t kWords>
+__attribute__((target("avx512f"))) __mmask16 table_avx512(const std::array<std::uint32_t, kWords> &table,
+                                                          __m512i x)
+{
+    const __m512i d{_mm512_sub_epi32(x, _mm512_set1_epi32(kLow))};
+    const __mmask16 inside{_mm512_cmple_epu32_mask(d, _mm512_set1_epi32(static_cast<int>(kWords * 32 - 1)))};
+    const __m512i words{
+        _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), inside, _mm512_srli_epi32(d, 5), table.data(), 4)};
+    const __m512i bits{_mm512_srlv_epi32(words, _mm512_and_si512(d, _mm512_set1_epi32(31)))};
+    return _mm512_mask_test_epi32_mask(inside, bits, _mm512_set1_epi32(1));
+}
+
+ENPM702_SIMD_KERNELS_END
+
+#endif // ENPM702_X86
+
+template <std::size_t kWords, int... kValues>
+constexpr std::array<std::uint32_t, kWords> make_table(int low)
+{
+    std::array<std::uint32_t, kWords> table{};
+    for (int value : {kValues...})
+    {
+        const std::uint32_t d{offset(value, low)};
+        table[d >> 5] |= std::uint32_t{1} << (d & 31);
+    }
+    return table;
+}
+
+} // namespace detail
+
+// The set {kValues...}
+template <int... kValues>
+struct SmallSet
+{
+    static_assert(sizeof...(kValues) > 0, "SmallSet needs at least one value");
+
+    static constexpr int kLow{std::min({kValues...})};
+    static constexpr int kHigh{std::max({kValues...})};
+    static constexpr long long kSpan{static_cast<long long>(kHigh) - kLow + 1};
+    static constexpr detail::SetKind kKind{detail::set_kind(kSpan)};
+
+    static constexpr std::uint64_t kMask{[] {
+        std::uint64_t mask{0};
+        if (kKind == detail::SetKind::kMask)
+        {
+            for (int value : {kValues...})
+                mask |= std::uint64_t{1} << detail::offset(value, kLow);
+        }
+        return mask;
+    }()};
+    static constexpr std::size_t kWords{kKind == detail::SetKind::kTable ? static_cast<std::size_t>(kSpan + 31) / 32
+                                                                         : 1};
+    static constexpr std::array<std::uint32_t, kWords> kTable{
+        kKind == detail::SetKind::kTable ? detail::make_table<kWords, kValues...>(kLow)
+                                         : std::array<std::uint32_t, kWords>{}};
+
+    static constexpr bool contains(int x)
+    {
+        if constexpr (kKind == detail::SetKind::kMask)
+            return detail::mask_contains<kLow, kMask>(x);
+        else if constexpr (kKind == detail::SetKind::kTable)
+            return detail::table_contains<kLow>(kTable, x);
+        else
+            return ((x == kValues) || ...);
+    }
+
+    constexpr bool operator()(int x) const { return contains(x); }
+
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) static __m256i avx2(__m256i x)
+    {
+        if constexpr (kKind == detail::SetKind::kMask)
+            return detail::mask_avx2<kLow, kMask>(x);
+        else if constexpr (kKind == detail::SetKind::kTable)
+            return detail::table_avx2<kLow>(kTable, x);
+        else
+        {
+            __m256i hit{_mm256_setzero_si256()};
+            ((hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(x, _mm256_set1_epi32(kValues)))), ...);
+            return hit;
+        }
+    }
+
+    __attribute__((target("avx512f"))) static __mmask16 avx512(__m512i x)
+    {
+        if constexpr (kKind == detail::SetKind::kMask)
+            return detail::mask_avx512<kLow, kMask>(x);
+        else if constexpr (kKind == detail::SetKind::kTable)
+            return detail::table_avx512<kLow>(kTable, x);
+        else
+        {
+            __mmask16 hit{0};
+            ((hit = static_cast<__mmask16>(hit | _mm512_cmpeq_epi32_mask(x, _mm512_set1_epi32(kValues)))), ...);
+            return hit;
+        }
+    }
+#endif
+};
+
+// The values kLow..kHigh except kExcluded...
+template <int kLow, int kHigh, int... kExcluded>
+struct RangeExcept
+{
+    static_assert(kLow <= kHigh, "RangeExcept needs kLow <= kHigh");
+
+    static constexpr long long kSpan{static_cast<long long>(kHigh) - kLow + 1};
+    static constexpr bool kIsMask{kSpan < 64};
+
+    static constexpr std::uint64_t kMask{[] {
+        std::uint64_t mask{0};
+        if (kIsMask)
+        {
+            mask = (std::uint64_t{1} << kSpan) - 1;
+            const int excluded[]{kExcluded..., kLow}; // never empty
+            for (std::size_t k{0}; k < sizeof...(kExcluded); ++k)
+            {
+                if (excluded[k] >= kLow && excluded[k] <= kHigh)
+                    mask &= ~(std::uint64_t{1} << detail::offset(excluded[k], kLow));
+            }
+        }
+        return mask;
+    }()};
+
+    static constexpr bool contains(int x)
+    {
+        if constexpr (kIsMask)
+            return detail::mask_contains<kLow, kMask>(x);
+        else
+            return (detail::offset(x, kLow) <= detail::offset(kHigh, kLow)) & ((x != kExcluded) & ... & true);
+    }
+
+    constexpr bool operator()(int x) const { return contains(x); }
+
+#ifdef ENPM702_X86
+    __attribute__((target("avx2"))) static __m256i avx2(__m256i x)
+    {
+        if constexpr (kIsMask)
+            return detail::mask_avx2<kLow, kMask>(x);
+        else
+        {
+            // signed compares: not (x < low or x > high or x == excluded)
+            __m256i miss{_mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(kLow), x),
+                                         _mm256_cmpgt_epi32(x, _mm256_set1_epi32(kHigh)))};
+            ((miss = _mm256_or_si256(miss, _mm256_cmpeq_epi32(x, _mm256_set1_epi32(kExcluded)))), ...);
+            return _mm256_xor_si256(miss, _mm256_set1_epi32(-1));
+        }
+    }
+
+    __attribute__((target("avx512f"))) static __mmask16 avx512(__m512i x)
+    {
+        if constexpr (kIsMask)
+            return detail::mask_avx512<kLow, kMask>(x);
+        else
+        {
+            __mmask16 hit{_mm512_cmple_epu32_mask(_mm512_sub_epi32(x, _mm512_set1_epi32(kLow)),
+                                                  _mm512_set1_epi32(static_cast<int>(detail::offset(kHigh, kLow))))};
+            ((hit = _mm512_mask_cmpneq_epi32_mask(hit, x, _mm512_set1_epi32(kExcluded))), ...);
+            return hit;
+        }
+    }
+#endif
+};
+
+namespace detail
+{
+
+#ifdef ENPM702_X86
+
+template <typename Set>
+__attribute__((target("avx2,popcnt"))) std::size_t count_avx2(const int *data, std::size_t size)
+{
+    std::size_t count{0};
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256i hit{Set::avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)))};
+        count += static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(hit))));
+    }
+    for (; i < size; ++i)
+        count += Set::contains(data[i]);
+    return count;
+}
+
+template <typename Set>
+__attribute__((target("avx2"))) void evaluate_avx2(const int *data, std::size_t size, std::uint8_t *out)
+{
+    std::size_t i{0};
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256i hit{Set::avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)))};
+        // 8 x 32-bit all-ones/zero lanes -> 8 bytes of 1/0
+        const __m128i words{_mm_packs_epi32(_mm256_castsi256_si128(hit), _mm256_extracti128_si256(hit, 1))};
+        const __m128i bytes{_mm_packs_epi16(words, words)};
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_and_si128(bytes, _mm_set1_epi8(1)));
+    }
+    for (; i < size; ++i)
+        out[i] = Set::contains(data[i]);
+}
+
+ENPM702_SIMD_KERNELS_BEGIN
+
+template <typename Set>
+__attribute__((target("avx512f,popcnt"))) std::size_t count_avx512(const int *data, std::size_t size)
+{
+    std::size_t count{0};
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const __mmask16 valid{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        const __mmask16 hit{
+            static_cast<__mmask16>(Set::avx512(_mm512_maskz_loadu_epi32(valid, data + i)) & valid)};
+        count += static_cast<std::size_t>(__builtin_popcount(hit));
+    }
+    return count;
+}
+
+template <typename Set>
+__attribute__((target("avx512f"))) void evaluate_avx512(const int *data, std::size_t size, std::uint8_t *out)
+{
+    for (std::size_t i{0}; i < size; i += 16)
+    {
+        const __mmask16 valid{i + 16 <= size ? static_cast<__mmask16>(0xffff) : tail_mask(size - i)};
+        const __mmask16 hit{Set::avx512(_mm512_maskz_loadu_epi32(valid, data + i))};
+        // VPMOVDB: 16 x 32-bit 1/0 -> 16 bytes
+        _mm512_mask_cvtepi32_storeu_epi8(out + i, valid, _mm512_maskz_set1_epi32(hit, 1));
+    }
+}
+
+ENPM702_SIMD_KERNELS_END
+
+#endif // ENPM702_X86
+
+} // namespace detail
+
+// How many values of the array are in Set
+template <typename Set>
+std::size_t count_matching(const int *data, std::size_t size, SimdLevel simd = SimdLevel::kAuto)
+{
+#ifdef ENPM702_X86
+    const SimdLevel level{resolve(simd)};
+    if (level == SimdLevel::kAvx512)
+        return detail::count_avx512<Set>(data, size);
+    if (level == SimdLevel::kAvx2)
+        return detail::count_avx2<Set>(data, size);
+#endif
+    std::size_t count{0};
+    for (std::size_t i{0}; i < size; ++i)
+        count += Set::contains(data[i]);
+    return count;
+}
+
+// out[i] = 1 if data[i] is in Set, else 0
+template <typename Set>
+void evaluate(const int *data, std::size_t size, std::uint8_t *out, SimdLevel simd = SimdLevel::kAuto)
+{
+#ifdef ENPM702_X86
+    const SimdLevel level{resolve(simd)};
+    if (level == SimdLevel::kAvx512)
+        return detail::evaluate_avx512<Set>(data, size, out);
+    if (level == SimdLevel::kAvx2)
+        return detail::evaluate_avx2<Set>(data, size, out);
+#endif
+    for (std::size_t i{0}; i < size; ++i)
+        out[i] = Set::contains(data[i]);
+}
+
+} // namespace rm
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Line, word and byte statistics of a text file, computed in parallel:
+//
+//     rm::TextStats stats;
+//     if (rm::text_stats("server.log", rm::TextStatsOptions{}, stats))
+//         std::cout << stats.lines << ' ' << stats.words << '\n';
+//
+// The file is memory-mapped and cut into chunks of chunk_size bytes. Each
+// worker thread takes the next chunk, counts the lines that start in it
+// (so chunks split at newlines and no word is cut in two), and counts its
+// words in its own open-addressing hash table. Once a chunk is done its
+// pages are dropped from the process, so memory stays around
+// threads * chunk_size plus the longest line and the vocabulary however
+// large the file is.
+// Lines, words and bytes match `wc -l -w -c`.
+namespace rm
+{
+
+struct WordCount
+{
+    std::string word;
+    std::uint64_t count;
+};
+
+struct TextStats
+{
+    std::uint64_t bytes{0};
+    std::uint64_t lines{0}; // newline characters, as wc -l
+    std::uint64_t words{0}; // runs of non-whitespace, as wc -w
+    std::array<std::uint64_t, 256> histogram{};
+    std::vector<WordCount> top_words; // most frequent first
+};
+
+struct TextStatsOptions
+{
+    unsigned threads{0};                  // 0: one per hardware thread
+    std::size_t top_k{10};                // number of words in top_words
+    std::size_t chunk_size{16u << 20};    // bytes given to a worker at a time
+};
+
+namespace detail
+{
+
+// The whitespace of the C locale's isspace(), which wc uses
+constexpr std::array<bool, 256> kTextSpace{[] {
+    std::array<bool, 256> space{};
+    for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+        space[c] = true;
+    return space;
+}()};
+
+inline std::uint64_t hash_word(const char *data, std::size_t size)
+{
+    std::uint64_t hash{0x9e3779b97f4a7c15ULL ^ size};
+    while (size >= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+        data += 8;
+        size -= 8;
+    }
+    std::uint64_t tail{0};
+    std::memcpy(&tail, data, size);
+    hash = (hash ^ tail) * 0xc4ceb9fe1a85ec53ULL;
+    return hash ^ (hash >> 29);
+}
+
+// Word -> count, linear probing; the words are copied into one string so
+// that the table does not point into the mapping
+class WordTable
+{
+public:
+    WordTable() : slots_(1024) {}
+
+    void add(const char *data, std::size_t size, std::uint64_t count = 1)
+    {
+        add(data, size, hash_word(data, size), count);
+    }
+
+    void add(const char *data, std::size_t size, std::uint64_t hash, std::uint64_t count)
+    {
+        std::size_t mask{slots_.size() - 1};
+        for (std::size_t i{hash & mask};; i = (i + 1) & mask)
+        {
+            Slot &slot{slots_[i]};
+            if (slot.count == 0)
+            {
+                slot = Slot{hash, text_.size(), static_cast<std::uint32_t>(size), count};
+                text_.append(data, size);
+                if (++used_ * 2 > slots_.size())
+                    grow();
+                return;
+            }
+            if (slot.hash == hash && slot.size == size &&
+                std::memcmp(text_.data() + slot.offset, data, size) == 0)
+            {
+                slot.count += count;
+                return;
+            }
+        }
+    }
+
+    // Add every word of other to this table
+    void merge(const WordTable &other)
+    {
+        for (const Slot &slot : other.slots_)
+        {
+            if (slot.count != 0)
+                add(other.text_.data() + slot.offset, slot.size, slot.hash, slot.count);
+        }
+    }
+
+    std::vector<WordCount> top(std::size_t k) const
+    {
+        std::vector<const Slot *> used;
+        used.reserve(used_);
+        for (const Slot &slot : slots_)
+        {
+            if (slot.count != 0)
+                used.push_back(&slot);
+        }
+        auto word{[this](const Slot *slot) {
+            return std::string_view{text_.data() + slot->offset, slot->size};
+        }};
+        k = std::min(k, used.size());
+        std::partial_sort(used.begin(), used.begin() + static_cast<std::ptrdiff_t>(k), used.end(),
+                          [&](const Slot *a, const Slot *b) {
+                              return a->count != b->count ? a->count > b->count : word(a) < word(b);
+                          });
+        std::vector<WordCount> result;
+        for (std::size_t i{0}; i < k; ++i)
+            result.push_back(WordCount{std::string{word(used[i])}, used[i]->count});
+        return result;
+    }
+
+private:
+    struct Slot
+    {
+        std::uint64_t hash;
+        std::size_t offset;
+        std::uint32_t size;
+        std::uint64_t count; // 0 for an empty slot
+    };
+
+    void grow()
+    {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        std::size_t mask{slots_.size() - 1};
+        for (const Slot &slot : old)
+        {
+            if (slot.count == 0)
+                continue;
+            std::size_t i{slot.hash & mask};
+            while (slots_[i].count != 0)
+                i = (i + 1) & mask;
+            slots_[i] = slot;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::string text_;
+    std::size_t used_{0};
+};
+
+// Counts of one worker
+struct PartialStats
+{
+    std::uint64_t words{0};
+    std::array<std::uint64_t, 256> histogram{};
+    WordTable table;
+
+    void scan(const char *data, std::size_t size)
+    {
+        const char *word{nullptr};
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            auto c{static_cast<unsigned char>(data[i])};
+            ++histogram[c];
+            if (kTextSpace[c])
+            {
+                if (word)
+                {
+                    table.add(word, static_cast<std::size_t>(data + i - word));
+                    ++words;
+                    word = nullptr;
+                }
+            }
+            else if (!word)
+            {
+                word = data + i;
+            }
+        }
+        if (word)
+        {
+            table.add(word, static_cast<std::size_t>(data + size - word));
+            ++words;
+        }
+    }
+};
+
+inline void drop_pages(const char *begin, const char *end)
+{
+    const auto page{static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE))};
+    auto first{reinterpret_cast<std::uintptr_t>(begin) & ~(page - 1)};
+    auto last{reinterpret_cast<std::uintptr_t>(end) & ~(page - 1)};
+    if (last > first)
+        ::madvise(reinterpret_cast<void *>(first), last - first, MADV_DONTNEED);
+}
+
+} // namespace detail
+
+// Statistics of the file at path; false if it cannot be opened or mapped
+inline bool text_stats(const char *path, const TextStatsOptions &options, TextStats &stats)
+{
+    int fd{::open(path, O_RDONLY)};
+    if (fd < 0)
+        return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    stats = TextStats{};
+    const auto size{static_cast<std::size_t>(info.st_size)};
+    stats.bytes = size;
+    if (size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+    void *memory{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    ::close(fd);
+    if (memory == MAP_FAILED)
+        return false;
+    const char *data{static_cast<const char *>(memory)};
+    ::madvise(memory, size, MADV_SEQUENTIAL);
+
+    const std::size_t chunk_size{std::max<std::size_t>(options.chunk_size, 4096)};
+    const std::size_t chunks{(size + chunk_size - 1) / chunk_size};
+    unsigned threads{options.threads ? options.threads : std::thread::hardware_concurrency()};
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(threads, 1, chunks));
+
+    // the lines of a chunk are those that start in it; a line starts at 0
+    // and after each '\n'. The search stops at the end of the chunk, so that
+    // files of very long lines are still read about once; size means that
+    // no line starts in the chunk.
+    auto line_start{[&](std::size_t chunk) -> std::size_t {
+        const std::size_t position{chunk * chunk_size};
+        if (position == 0)
+            return 0;
+        const std::size_t limit{std::min(position + chunk_size, size)};
+        const void *newline{std::memchr(data + position - 1, '\n', limit - position)};
+        return newline ? static_cast<std::size_t>(static_cast<const char *>(newline) - data) + 1 : size;
+    }};
+
+    std::vector<detail::PartialStats> partials(threads);
+    std::atomic<std::size_t> next_chunk{0};
+    auto work{[&](detail::PartialStats &partial) {
+        for (std::size_t chunk{next_chunk++}; chunk < chunks; chunk = next_chunk++)
+        {
+            const std::size_t begin{line_start(chunk)};
+            if (begin == size)
+                continue;
+            // the last line runs on to the next chunk where one starts
+            std::size_t end{size};
+            for (std::size_t next{chunk + 1}; next < chunks && end == size; ++next)
+                end = line_start(next);
+            partial.scan(data + begin, end - begin);
+            detail::drop_pages(data + begin, data + end);
+        }
+    }};
+    std::vector<std::thread> workers;
+    for (unsigned t{1}; t < threads; ++t)
+        workers.emplace_back(work, std::ref(partials[t]));
+    work(partials[0]);
+    for (auto &worker : workers)
+        worker.join();
+    ::munmap(memory, size);
+
+    for (std::size_t t{0}; t < partials.size(); ++t)
+    {
+        stats.words += partials[t].words;
+        for (std::size_t c{0}; c < 256; ++c)
+            stats.histogram[c] += partials[t].histogram[c];
+        if (t > 0)
+            partials[0].table.merge(partials[t].table);
+    }
+    stats.lines = stats.histogram['\n'];
+    stats.top_words = partials[0].table.top(options.top_k);
+    return true;
+}
+
+// The same statistics the straightforward way: std::getline and a
+// std::unordered_map, one thread
+inline TextStats naive_text_stats(std::istream &in, std::size_t top_k)
+{
+    TextStats stats;
+    std::unordered_map<std::string, std::uint64_t> counts;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!in.eof())
+        {
+            ++stats.lines;
+            ++stats.histogram['\n'];
+            ++stats.bytes;
+        }
+        stats.bytes += line.size();
+        std::string word;
+        for (char c : line)
+        {
+            ++stats.histogram[static_cast<unsigned char>(c)];
+            if (detail::kTextSpace[static_cast<unsigned char>(c)])
+            {
+                if (!word.empty())
+                {
+                    ++counts[word];
+                    ++stats.words;
+                    word.clear();
+                }
+            }
+            else
+            {
+                word += c;
+            }
+        }
+        if (!word.empty())
+        {
+            ++counts[word];
+            ++stats.words;
+        }
+    }
+    std::vector<WordCount> all;
+    all.reserve(counts.size());
+    for (auto &entry : counts)
+        all.push_back(WordCount{entry.first, entry.second});
+    top_k = std::min(top_k, all.size());
+    std::partial_sort(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(top_k), all.end(),
+                      [](const WordCount &a, const WordCount &b) {
+                          return a.count != b.count ? a.count > b.count : a.word < b.word;
+                      });
+    all.resize(top_k);
+    stats.top_words = std::move(all);
+    return stats;
+}
+
+} // namespace rm
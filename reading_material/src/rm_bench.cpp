@@ -0,0 +1,666 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "graph_search.hpp"
+#include "int_parser.hpp"
+#include "out_writer.hpp"
+#include "partition.hpp"
+#include "reduce.hpp"
+#include "text_stats.hpp"
+
+using enpm702::bench::do_not_optimize;
+
+// Run with `rm_bench` (see `rm_bench --list`).
+
+namespace
+{
+std::vector<int> random_ints(std::size_t count)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{-1000, 1000};
+    std::vector<int> values(count);
+    for (auto &value : values)
+        value = distribution(generator);
+    return values;
+}
+} // namespace
+
+//==============
+//======== 4
+//==============
+// Counting odd numbers with % and a branch
+BENCHMARK("parity/modulo_branch")
+{
+    static const std::vector<int> values{random_ints(1 << 16)};
+    state.set_items_per_iteration(values.size());
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        int odd{0};
+        for (int x : values)
+        {
+            if (x % 2)
+                ++odd;
+        }
+        do_not_optimize(odd);
+    }
+}
+
+//==============
+//======== 5
+//==============
+// Larger value with the conditional operator
+BENCHMARK("larger_value/conditional")
+{
+    static const std::vector<int> values{random_ints(1 << 16)};
+    state.set_items_per_iteration(values.size());
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        int larger_value{values[0]};
+        for (int x : values)
+            larger_value = x > larger_value ? x : larger_value;
+        do_not_optimize(larger_value);
+    }
+}
+
+//==============
+//======== 25
+//==============
+// Nested i * j loop, summed instead of printed
+BENCHMARK("nested_loop/sum_products")
+{
+    int rows{5};
+    int columns{10};
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        do_not_optimize(rows);
+        do_not_optimize(columns);
+        int sum{0};
+        for (auto i{1}; i <= rows; ++i)
+        {
+            for (auto j{1}; j <= columns; ++j)
+                sum += i * j;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+//==============
+//======== 19, 21, 23, 25
+//==============
+// The counter loops scaled to 10^7 integers, ten per line, written to
+// /dev/null through std::cout, printf and rm::OutWriter
+namespace
+{
+constexpr int kPrintedInts{10000000};
+
+// Point stdout at /dev/null for the lifetime of the object
+class StdoutToDevNull
+{
+public:
+    StdoutToDevNull() : saved_{::dup(STDOUT_FILENO)}
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+        int null{::open("/dev/null", O_WRONLY)};
+        ::dup2(null, STDOUT_FILENO);
+        ::close(null);
+    }
+
+    ~StdoutToDevNull()
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+        ::dup2(saved_, STDOUT_FILENO);
+        ::close(saved_);
+    }
+
+private:
+    int saved_;
+};
+} // namespace
+
+BENCHMARK("output/cout_1e7_ints")
+{
+    StdoutToDevNull redirect;
+    state.set_items_per_iteration(kPrintedInts);
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        for (int i{0}; i < kPrintedInts; ++i)
+            std::cout << i << (i % 10 == 9 ? '\n' : ' ');
+        std::cout.flush();
+    }
+}
+
+BENCHMARK("output/printf_1e7_ints")
+{
+    StdoutToDevNull redirect;
+    state.set_items_per_iteration(kPrintedInts);
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        for (int i{0}; i < kPrintedInts; ++i)
+            std::printf("%d%c", i, i % 10 == 9 ? '\n' : ' ');
+        std::fflush(stdout);
+    }
+}
+
+BENCHMARK("output/out_writer_1e7_ints")
+{
+    StdoutToDevNull redirect;
+    state.set_items_per_iteration(kPrintedInts);
+    rm::OutWriter out;
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        for (int i{0}; i < kPrintedInts; ++i)
+            out << i << (i % 10 == 9 ? '\n' : ' ');
+        out.flush();
+    }
+}
+
+//==============
+//======== 1, 28, 38
+//==============
+// Reading 10^6 whitespace-separated integers (about 7 MB) as std::cin >>
+// does, with strtol, and in batch with rm::parse_ints
+namespace
+{
+const std::string &integer_text()
+{
+    static const std::string text{[] {
+        std::ostringstream out;
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int> distribution{-1000000, 1000000};
+        for (int i{0}; i < 1000000; ++i)
+            out << distribution(generator) << (i % 10 == 9 ? '\n' : ' ');
+        return out.str();
+    }()};
+    return text;
+}
+} // namespace
+
+BENCHMARK("parse/istream_1e6_ints")
+{
+    const std::string &text{integer_text()};
+    state.set_bytes_per_iteration(static_cast<double>(text.size()));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        state.pause_timing();
+        std::istringstream in{text};
+        state.resume_timing();
+        long long sum{0};
+        int value{};
+        while (in >> value)
+            sum += value;
+        do_not_optimize(sum);
+    }
+}
+
+BENCHMARK("parse/strtol_1e6_ints")
+{
+    const std::string &text{integer_text()};
+    state.set_bytes_per_iteration(static_cast<double>(text.size()));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        long long sum{0};
+        const char *p{text.c_str()};
+        char *end{};
+        while (true)
+        {
+            long value{std::strtol(p, &end, 10)};
+            if (end == p)
+                break;
+            sum += value;
+            p = end;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+BENCHMARK("parse/parse_ints_1e6_ints")
+{
+    const std::string &text{integer_text()};
+    std::vector<int> values(1 << 16);
+    state.set_bytes_per_iteration(static_cast<double>(text.size()));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        long long sum{0};
+        const char *next{text.data()};
+        const char *last{text.data() + text.size()};
+        while (true)
+        {
+            auto result{rm::parse_ints(next, last, values.data(), values.size())};
+            for (std::size_t i{0}; i < result.count; ++i)
+                sum += values[i];
+            if (result.error || result.next == last)
+                break;
+            next = result.next;
+        }
+        do_not_optimize(sum);
+    }
+}
+
+//==============
+//======== text statistics
+//==============
+// Lines, words and top-10 words of a 256 MiB log-like file: `wc -lw`,
+// std::getline + std::unordered_map, and rm::text_stats on 1..N threads
+namespace
+{
+constexpr std::size_t kTextFileSize{std::size_t{256} << 20};
+
+// The generated file, removed at exit; on failure path is empty and error
+// says why
+struct TextFile
+{
+    TextFile()
+    {
+        char name[]{"/tmp/rm_bench_text_XXXXXX"};
+        int fd{::mkstemp(name)};
+        if (fd < 0)
+        {
+            error = std::string{"cannot create a temporary file: "} + std::strerror(errno);
+            return;
+        }
+        ::close(fd);
+        path = name;
+        // words drawn from a skewed vocabulary of 50000, 4 to 16 per line
+        std::vector<std::string> vocabulary;
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int> letter{'a', 'z'};
+        std::uniform_int_distribution<int> length{1, 12};
+        for (int i{0}; i < 50000; ++i)
+        {
+            std::string word(static_cast<std::size_t>(length(generator)), ' ');
+            for (char &c : word)
+                c = static_cast<char>(letter(generator));
+            vocabulary.push_back(word);
+        }
+        std::uniform_real_distribution<double> uniform{0.0, 1.0};
+        std::uniform_int_distribution<int> words_per_line{4, 16};
+        std::string text;
+        text.reserve(kTextFileSize + 256);
+        while (text.size() < kTextFileSize)
+        {
+            for (int w{words_per_line(generator)}; w > 0; --w)
+            {
+                double u{uniform(generator)};
+                text += vocabulary[static_cast<std::size_t>(u * u * u * 49999.0)];
+                text += w > 1 ? ' ' : '\n';
+            }
+        }
+        if (!std::ofstream{path, std::ios::binary}.write(text.data(), static_cast<std::streamsize>(text.size())))
+        {
+            error = "cannot write " + path;
+            std::remove(path.c_str());
+            path.clear();
+        }
+    }
+    ~TextFile()
+    {
+        if (!path.empty())
+            std::remove(path.c_str());
+    }
+    std::string path;
+    std::string error;
+};
+
+const TextFile &text_file()
+{
+    static const TextFile file;
+    return file;
+}
+
+void text_stats_parallel(enpm702::bench::State &state, unsigned threads)
+{
+    state.pause_timing();
+    const TextFile &file{text_file()};
+    state.resume_timing();
+    if (file.path.empty())
+    {
+        state.skip(file.error);
+        return;
+    }
+    state.set_bytes_per_iteration(static_cast<double>(kTextFileSize));
+    rm::TextStatsOptions options;
+    options.threads = threads;
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        rm::TextStats stats;
+        rm::text_stats(file.path.c_str(), options, stats);
+        do_not_optimize(stats.words);
+    }
+}
+
+[[maybe_unused]] const bool text_stats_registered{[] {
+    unsigned hardware{std::max(1u, std::thread::hardware_concurrency())};
+    for (unsigned threads{1}; threads < hardware; threads *= 2)
+    {
+        enpm702::bench::register_benchmark("text_stats/text_stats/threads:" + std::to_string(threads),
+                                           [threads](auto &state) { text_stats_parallel(state, threads); });
+    }
+    enpm702::bench::register_benchmark("text_stats/text_stats/threads:" + std::to_string(hardware),
+                                       [hardware](auto &state) { text_stats_parallel(state, hardware); });
+    return true;
+}()};
+} // namespace
+
+// The coreutils reference; words only, no frequencies
+BENCHMARK("text_stats/wc")
+{
+    state.pause_timing();
+    const TextFile &file{text_file()};
+    const std::string command{"wc -lw " + file.path + " > /dev/null"};
+    state.resume_timing();
+    if (file.path.empty())
+    {
+        state.skip(file.error);
+        return;
+    }
+    state.set_bytes_per_iteration(static_cast<double>(kTextFileSize));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+        do_not_optimize(std::system(command.c_str()));
+}
+
+BENCHMARK("text_stats/getline_unordered_map")
+{
+    state.pause_timing();
+    const TextFile &file{text_file()};
+    state.resume_timing();
+    if (file.path.empty())
+    {
+        state.skip(file.error);
+        return;
+    }
+    state.set_bytes_per_iteration(static_cast<double>(kTextFileSize));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        std::ifstream in{file.path, std::ios::binary};
+        rm::TextStats stats{rm::naive_text_stats(in, 10)};
+        do_not_optimize(stats.words);
+    }
+}
+
+//==============
+//======== 22
+//==============
+// The searches behind the snippet 22 menu on an R-MAT graph with 2^18
+// vertices and 2^22 edges; items/s is traversed edges per second
+namespace
+{
+const rm::CsrGraph &rmat_graph()
+{
+    static const rm::CsrGraph graph{rm::CsrGraph::from_edges(rm::rmat_edges(18, 16), true)};
+    return graph;
+}
+
+template <typename Search>
+void graph_search(enpm702::bench::State &state, Search search)
+{
+    state.pause_timing();
+    const rm::CsrGraph &graph{rmat_graph()};
+    std::uint32_t source{0};
+    for (std::uint32_t v{1}; v < graph.vertex_count(); ++v)
+    {
+        if (graph.degree(v) > graph.degree(source))
+            source = v;
+    }
+    state.set_items_per_iteration(static_cast<double>(rm::component_edges(graph, rm::bfs(graph, source))));
+    state.resume_timing();
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        rm::SearchResult result{search(graph, source)};
+        do_not_optimize(result.visited);
+        state.pause_timing();
+        result = rm::SearchResult{}; // freeing the parent array is not part of the search
+        state.resume_timing();
+    }
+}
+} // namespace
+
+BENCHMARK("graph/dfs")
+{
+    graph_search(state, [](const rm::CsrGraph &graph, std::uint32_t source) { return rm::dfs(graph, source); });
+}
+
+BENCHMARK("graph/bfs")
+{
+    graph_search(state, [](const rm::CsrGraph &graph, std::uint32_t source) { return rm::bfs(graph, source); });
+}
+
+BENCHMARK("graph/parallel_bfs")
+{
+    graph_search(state,
+                 [](const rm::CsrGraph &graph, std::uint32_t source) { return rm::parallel_bfs(graph, source); });
+}
+
+//==============
+//======== 6-reduce
+//==============
+// Reductions of 2^16 ints (in L2) and 2^24 ints (64 MiB, from memory):
+// the loops a compiler makes of snippet 5, the standard algorithms, and
+// reduce.hpp with each instruction set and 1..N threads
+namespace
+{
+const std::vector<int> &reduce_values(std::size_t size)
+{
+    static const std::vector<int> small{random_ints(std::size_t{1} << 16)};
+    static const std::vector<int> large{random_ints(std::size_t{1} << 24)};
+    return size == small.size() ? small : large;
+}
+
+template <typename Reduce>
+void reduction(enpm702::bench::State &state, std::size_t size, Reduce reduce)
+{
+    state.pause_timing();
+    const std::vector<int> &values{reduce_values(size)};
+    state.resume_timing();
+    state.set_items_per_iteration(static_cast<double>(values.size()));
+    state.set_bytes_per_iteration(static_cast<double>(values.size() * sizeof(int)));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        auto result{reduce(values.data(), values.size())};
+        do_not_optimize(result);
+    }
+}
+
+[[maybe_unused]] const bool reduce_registered{[] {
+    using enpm702::bench::register_benchmark;
+    const std::pair<const char *, std::size_t> sizes[]{{"64k", std::size_t{1} << 16}, {"16m", std::size_t{1} << 24}};
+    std::vector<rm::SimdLevel> levels{rm::SimdLevel::kScalar};
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx2)
+        levels.push_back(rm::SimdLevel::kAvx2);
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx512)
+        levels.push_back(rm::SimdLevel::kAvx512);
+    std::vector<unsigned> thread_counts;
+    const unsigned hardware{std::max(1u, std::thread::hardware_concurrency())};
+    for (unsigned threads{1}; threads < hardware; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(hardware);
+
+    for (const auto &[size_name, size] : sizes)
+    {
+        const std::string suffix{std::string{"/"} + size_name};
+        register_benchmark("reduce/argmax/loop" + suffix, [size = size](auto &state) {
+            reduction(state, size, [](const int *data, std::size_t count) {
+                std::size_t where{0};
+                for (std::size_t i{1}; i < count; ++i)
+                    where = data[i] > data[where] ? i : where;
+                return where;
+            });
+        });
+        register_benchmark("reduce/argmax/std_max_element" + suffix, [size = size](auto &state) {
+            reduction(state, size,
+                      [](const int *data, std::size_t count) { return std::max_element(data, data + count); });
+        });
+        register_benchmark("reduce/max/loop" + suffix, [size = size](auto &state) {
+            reduction(state, size, [](const int *data, std::size_t count) {
+                int larger_value{data[0]};
+                for (std::size_t i{1}; i < count; ++i)
+                    larger_value = data[i] > larger_value ? data[i] : larger_value;
+                return larger_value;
+            });
+        });
+        register_benchmark("reduce/count_if/std_count_if" + suffix, [size = size](auto &state) {
+            reduction(state, size, [](const int *data, std::size_t count) {
+                return std::count_if(data, data + count, [](int x) { return x > 0; });
+            });
+        });
+
+        for (rm::SimdLevel level : levels)
+        {
+            // a thread per 2^18 values at most: more threads only on the large array
+            for (unsigned threads : thread_counts)
+            {
+                if (threads > 1 && size < rm::kReduceBlock * threads)
+                    continue;
+                const rm::ReduceOptions options{threads, level};
+                const std::string name{std::string{"/"} + rm::to_string(level) + suffix + "/threads:" +
+                                       std::to_string(threads)};
+                register_benchmark("reduce/max" + name, [size = size, options](auto &state) {
+                    reduction(state, size, [&](const int *data, std::size_t count) {
+                        return rm::max_value(data, count, options);
+                    });
+                });
+                register_benchmark("reduce/argmax" + name, [size = size, options](auto &state) {
+                    reduction(state, size,
+                              [&](const int *data, std::size_t count) { return rm::argmax(data, count, options); });
+                });
+                register_benchmark("reduce/sum" + name, [size = size, options](auto &state) {
+                    reduction(state, size,
+                              [&](const int *data, std::size_t count) { return rm::sum(data, count, options); });
+                });
+                register_benchmark("reduce/count_if" + name, [size = size, options](auto &state) {
+                    reduction(state, size, [&](const int *data, std::size_t count) {
+                        return rm::count_if(data, count, {rm::Compare::kGreater, 0}, options);
+                    });
+                });
+            }
+        }
+    }
+    return true;
+}()};
+} // namespace
+
+//==============
+//======== 4-partition
+//==============
+// Gathering the odd values (and their indices, and partitioning by parity)
+// of 2^20 ints when half are odd and when 99% are odd: a branch, the
+// branchless scalar kernel and the vector kernels of partition.hpp.
+// The branch only costs when it is mispredicted, at the 50/50 split.
+namespace
+{
+const std::vector<int> &parity_values(int odd_percent)
+{
+    static const auto make{[](int percent) {
+        std::mt19937 generator{7};
+        std::uniform_int_distribution<int> value{-1000000, 1000000};
+        std::uniform_int_distribution<int> roll{0, 99};
+        std::vector<int> values(std::size_t{1} << 20);
+        for (int &x : values)
+            x = (value(generator) & ~1) + (roll(generator) < percent ? 1 : 0);
+        return values;
+    }};
+    static const std::vector<int> half{make(50)};
+    static const std::vector<int> most{make(99)};
+    return odd_percent == 50 ? half : most;
+}
+
+template <typename Filter>
+void filter_stage(enpm702::bench::State &state, int odd_percent, Filter filter)
+{
+    state.pause_timing();
+    const std::vector<int> &values{parity_values(odd_percent)};
+    std::vector<int> matching(values.size());
+    std::vector<int> rest(values.size());
+    state.resume_timing();
+    state.set_items_per_iteration(static_cast<double>(values.size()));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        std::size_t count{filter(values.data(), values.size(), matching.data(), rest.data())};
+        do_not_optimize(count);
+        enpm702::bench::clobber_memory();
+    }
+}
+
+[[maybe_unused]] const bool partition_registered{[] {
+    using enpm702::bench::register_benchmark;
+    std::vector<rm::SimdLevel> levels{rm::SimdLevel::kScalar};
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx2)
+        levels.push_back(rm::SimdLevel::kAvx2);
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx512)
+        levels.push_back(rm::SimdLevel::kAvx512);
+    const rm::Filter odd{rm::Property::kOdd};
+
+    for (int percent : {50, 99})
+    {
+        const std::string split{"/odd_" + std::to_string(percent)};
+        register_benchmark("partition/select" + split + "/branchy", [percent](auto &state) {
+            filter_stage(state, percent, [](const int *data, std::size_t size, int *out, int *) {
+                std::size_t count{0};
+                for (std::size_t i{0}; i < size; ++i)
+                {
+                    if (data[i] % 2)
+                        out[count++] = data[i];
+                }
+                return count;
+            });
+        });
+        register_benchmark("partition/partition" + split + "/branchy", [percent](auto &state) {
+            filter_stage(state, percent, [](const int *data, std::size_t size, int *matching, int *rest) {
+                std::size_t matched{0};
+                std::size_t other{0};
+                for (std::size_t i{0}; i < size; ++i)
+                {
+                    if (data[i] % 2)
+                        matching[matched++] = data[i];
+                    else
+                        rest[other++] = data[i];
+                }
+                return matched;
+            });
+        });
+        for (rm::SimdLevel level : levels)
+        {
+            const std::string kernel{level == rm::SimdLevel::kScalar ? "branchless" : rm::to_string(level)};
+            const std::string name{split + "/" + kernel};
+            register_benchmark("partition/select" + name, [percent, level, odd](auto &state) {
+                filter_stage(state, percent, [&](const int *data, std::size_t size, int *out, int *) {
+                    return rm::select_values(data, size, odd, out, level);
+                });
+            });
+            register_benchmark("partition/select_indices" + name, [percent, level, odd](auto &state) {
+                filter_stage(state, percent, [&](const int *data, std::size_t size, int *out, int *) {
+                    return rm::select_indices(data, size, odd, reinterpret_cast<std::uint32_t *>(out), level);
+                });
+            });
+            register_benchmark("partition/partition" + name, [percent, level, odd](auto &state) {
+                filter_stage(state, percent, [&](const int *data, std::size_t size, int *matching, int *rest) {
+                    return rm::partition_values(data, size, odd, matching, rest, level);
+                });
+            });
+        }
+    }
+    return true;
+}()};
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return enpm702::bench::run_benchmarks(argc, argv);
+}
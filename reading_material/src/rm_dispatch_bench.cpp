@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "interpreter.hpp"
+#include "perf_counters.hpp"
+
+using enpm702::bench::do_not_optimize;
+
+// The dispatch strategies of include/interpreter.hpp on three programs:
+//
+// - <program>/<strategy>: one run of the program, kRounds times around its
+//   loop.
+//
+// Next to the time, each benchmark reports what one instruction of the
+// program cost the CPU when the hardware counters can be read:
+//
+// - instr/op: machine instructions per bytecode instruction;
+// - br_miss/op: mispredicted branches per bytecode instruction;
+// - ipc: machine instructions per cycle.
+//
+// The programs are
+//
+// - arith: the same six arithmetic instructions around a loop. Every
+//   strategy predicts this one, the difference is the work around each
+//   dispatch;
+// - cycle: the menus of snippets 11 to 14 with choice 0, 1, 2, 3, 0, ...:
+//   a repeating pattern that a predictor with history can learn;
+// - menu: the same menus with random choices, where no dispatch can be
+//   predicted much better than one in four.
+
+namespace
+{
+constexpr std::int32_t kRounds{1 << 16};
+
+using rm::Op;
+
+rm::Program arith_program()
+{
+    return {
+        {Op::kSet, 0, kRounds}, // 0: r0 = kRounds
+        {Op::kStore, 0, 0},
+        {Op::kLoad, 1, 0}, // 2: loop
+        {Op::kAdd, 0, 3},
+        {Op::kAnd, 0, 0xffff},
+        {Op::kAddReg, 2, 0},
+        {Op::kStore, 1, 0},
+        {Op::kLoop, 0, 2},
+        {Op::kHalt},
+    };
+}
+
+// The menus of snippets 11 to 14 for a choice in acc (0 to 3), picked with
+// kBranch like the switch of snippet 18. Like the cases of a switch
+// without break, each block falls through into the next one.
+rm::Program menu_program(bool random)
+{
+    return {
+        {Op::kSet, 0, kRounds}, // 0: r0 = kRounds
+        {Op::kStore, 0, 0},
+        random ? rm::Instruction{Op::kRandom, 0, 62} : rm::Instruction{Op::kLoad, 0, 0}, // 2: loop
+        {Op::kAnd, 0, 3},
+        {Op::kBranch, 0, 3}, // 4: switch (choice)
+        {Op::kJump, 0, 9},   // case 0
+        {Op::kJump, 0, 11},  // case 1
+        {Op::kJump, 0, 13},  // case 2
+        {Op::kJump, 0, 15},  // default
+        {Op::kSay},          // 9: "unknown" (snippet 11)
+        {Op::kJump, 0, 17},
+        {Op::kSet, 0, 1}, // 11: "one" (snippet 12)
+        {Op::kSay},
+        {Op::kSet, 0, 1}, // 13: "Choice is 1", "Choice is 2" (snippets 13 and 14)
+        {Op::kChoice},
+        {Op::kSet, 0, 2}, // 15: "Choice is 2"
+        {Op::kChoice},
+        {Op::kLoop, 0, 2}, // 17
+        {Op::kHalt},
+    };
+}
+
+void register_program(const std::string &name, const rm::Program &program)
+{
+    const std::uint64_t executed{rm::run(program, rm::Dispatch::kSwitch).executed};
+    for (rm::Dispatch dispatch :
+         {rm::Dispatch::kSwitch, rm::Dispatch::kComputedGoto, rm::Dispatch::kTailCall, rm::Dispatch::kTable})
+    {
+        if (!rm::is_supported(dispatch))
+            continue;
+        enpm702::bench::register_benchmark(
+            name + '/' + rm::to_string(dispatch), [program, dispatch, executed](auto &state) {
+                state.set_items_per_iteration(static_cast<double>(executed));
+                state.pause_timing(); // opening the counters takes a few system calls
+                enpm702::bench::PerfCounters perf;
+                perf.start();
+                state.resume_timing();
+                for (std::uint64_t n{0}; n < state.iterations(); ++n)
+                {
+                    rm::Machine machine{rm::run(program, dispatch)};
+                    do_not_optimize(machine.acc);
+                }
+                state.pause_timing();
+                const enpm702::bench::PerfSample sample{perf.stop()};
+                if (perf.available() && sample.cycles > 0)
+                {
+                    const double operations{static_cast<double>(executed * state.iterations())};
+                    state.set_counter("instr/op", sample.instructions / operations);
+                    state.set_counter("br_miss/op", sample.branch_misses / operations);
+                    state.set_counter("ipc", sample.instructions / sample.cycles);
+                }
+            });
+    }
+}
+
+[[maybe_unused]] const bool registered{[] {
+    register_program("arith", arith_program());
+    register_program("cycle", menu_program(false));
+    register_program("menu", menu_program(true));
+    return true;
+}()};
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    enpm702::bench::PerfCounters perf;
+    if (!perf.available())
+        std::cerr << "Hardware counters unavailable, timings only: " << perf.error() << '\n';
+    return enpm702::bench::run_benchmarks(argc, argv);
+}
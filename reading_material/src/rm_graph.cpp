@@ -0,0 +1,190 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "graph_search.hpp"
+#include "int_parser.hpp"
+
+// Traversed edges per second of the searches of graph_search.hpp, in the
+// manner of the Graph500 benchmark: build a graph, search from several
+// random roots, report the harmonic mean of edges / time.
+//
+//     rm_graph [--scale S] [--edge-factor E] [--input EDGES] [--threads N]
+//              [--roots R] [--validate]
+//
+// The graph is R-MAT with 2^S vertices and E * 2^S edges (default S = 20,
+// E = 16), or the edge list in EDGES; it is made symmetric. --validate
+// checks that every search reaches the same vertices as the serial BFS and
+// that both BFS trees give every vertex the same depth.
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+void usage(const char *program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--scale S] [--edge-factor E] [--input EDGES] [--threads N] [--roots R] "
+                 "[--validate]\n",
+                 program);
+}
+
+bool option_value(int argc, char *argv[], int &i, unsigned &value)
+{
+    if (i + 1 >= argc)
+        return false;
+    char *end{};
+    unsigned long parsed{std::strtoul(argv[++i], &end, 10)};
+    if (*end != '\0' || parsed == 0 || parsed > 1000000)
+        return false;
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+// Depth of every vertex in a search tree; kNoVertex if unreached
+std::vector<std::uint32_t> depths(const rm::SearchResult &result)
+{
+    std::vector<std::uint32_t> depth(result.parent.size(), rm::kNoVertex);
+    std::vector<std::uint32_t> path;
+    for (std::uint32_t v{0}; v < result.parent.size(); ++v)
+    {
+        // walk up to a vertex of known depth, then fill in the path
+        std::uint32_t u{v};
+        while (result.parent[u] != rm::kNoVertex && depth[u] == rm::kNoVertex && result.parent[u] != u)
+        {
+            path.push_back(u);
+            u = result.parent[u];
+        }
+        if (result.parent[u] == rm::kNoVertex)
+        {
+            path.clear();
+            continue;
+        }
+        if (depth[u] == rm::kNoVertex)
+            depth[u] = 0; // the root
+        for (auto it{path.rbegin()}; it != path.rend(); ++it)
+        {
+            depth[*it] = depth[u] + 1;
+            u = *it;
+        }
+        path.clear();
+    }
+    return depth;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned scale{20};
+    unsigned edge_factor{16};
+    unsigned roots{16};
+    rm::ParallelBfsOptions options;
+    const char *input{nullptr};
+    bool validate{false};
+    for (int i{1}; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--scale") == 0 && option_value(argc, argv, i, scale) && scale <= 31)
+            continue;
+        if (std::strcmp(argv[i], "--edge-factor") == 0 && option_value(argc, argv, i, edge_factor))
+            continue;
+        if (std::strcmp(argv[i], "--threads") == 0 && option_value(argc, argv, i, options.threads))
+            continue;
+        if (std::strcmp(argv[i], "--roots") == 0 && option_value(argc, argv, i, roots))
+            continue;
+        if (std::strcmp(argv[i], "--input") == 0 && i + 1 < argc)
+        {
+            input = argv[++i];
+            continue;
+        }
+        if (std::strcmp(argv[i], "--validate") == 0)
+        {
+            validate = true;
+            continue;
+        }
+        usage(argv[0]);
+        return 2;
+    }
+
+    auto start{Clock::now()};
+    std::vector<rm::Edge> edges;
+    if (input)
+    {
+        rm::InputText text{input};
+        if (!text.ok() || !rm::parse_edge_list(text.text(), edges))
+        {
+            std::fprintf(stderr, "%s: cannot read an edge list from %s\n", argv[0], input);
+            return 1;
+        }
+    }
+    else
+    {
+        edges = rm::rmat_edges(scale, edge_factor);
+    }
+    rm::CsrGraph graph{rm::CsrGraph::from_edges(edges, true)};
+    std::vector<rm::Edge>{}.swap(edges);
+    std::printf("graph: %u vertices, %llu edges, built in %.2f s\n", graph.vertex_count(),
+                static_cast<unsigned long long>(graph.arc_count() / 2),
+                std::chrono::duration<double>(Clock::now() - start).count());
+    if (graph.vertex_count() == 0)
+        return 0;
+
+    // roots with at least one edge, as the Graph500 picks them
+    std::vector<std::uint32_t> sources;
+    std::uint64_t pick{12345};
+    for (std::uint64_t tries{0}; sources.size() < roots && tries < 100ull * roots; ++tries)
+    {
+        pick = pick * 6364136223846793005ULL + 1442695040888963407ULL;
+        auto v{static_cast<std::uint32_t>((pick >> 33) % graph.vertex_count())};
+        if (graph.degree(v) > 0)
+            sources.push_back(v);
+    }
+
+    struct Search
+    {
+        const char *name;
+        rm::SearchResult (*run)(const rm::CsrGraph &, std::uint32_t, const rm::ParallelBfsOptions &);
+    };
+    const Search searches[]{
+        {"dfs", [](const rm::CsrGraph &g, std::uint32_t s, const rm::ParallelBfsOptions &) { return rm::dfs(g, s); }},
+        {"bfs", [](const rm::CsrGraph &g, std::uint32_t s, const rm::ParallelBfsOptions &) { return rm::bfs(g, s); }},
+        {"parallel_bfs", [](const rm::CsrGraph &g, std::uint32_t s, const rm::ParallelBfsOptions &o) {
+             return rm::parallel_bfs(g, s, o);
+         }},
+    };
+    std::printf("%-14s %12s %12s %14s\n", "search", "mean ms", "vertices", "TEPS (hmean)");
+    bool valid{true};
+    for (const Search &search : searches)
+    {
+        double seconds_total{0.0};
+        double inverse_teps_total{0.0};
+        std::uint64_t visited_total{0};
+        for (std::uint32_t source : sources)
+        {
+            auto begin{Clock::now()};
+            rm::SearchResult result{search.run(graph, source, options)};
+            double seconds{std::chrono::duration<double>(Clock::now() - begin).count()};
+            seconds_total += seconds;
+            visited_total += result.visited;
+            inverse_teps_total += seconds / static_cast<double>(std::max<std::uint64_t>(1, rm::component_edges(graph, result)));
+            if (validate)
+            {
+                rm::SearchResult reference{rm::bfs(graph, source)};
+                bool same{reference.visited == result.visited};
+                if (same && std::strcmp(search.name, "dfs") != 0)
+                    same = depths(reference) == depths(result);
+                if (!same)
+                {
+                    std::printf("%s from %u differs from the serial BFS\n", search.name, source);
+                    valid = false;
+                }
+            }
+        }
+        std::printf("%-14s %12.3f %12llu %14.4g\n", search.name, 1e3 * seconds_total / sources.size(),
+                    static_cast<unsigned long long>(visited_total / sources.size()),
+                    sources.size() / inverse_teps_total);
+    }
+    return valid ? 0 : 1;
+}
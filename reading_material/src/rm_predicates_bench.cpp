@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "small_set.hpp"
+
+using enpm702::bench::do_not_optimize;
+
+// The chains of comparisons of snippets 42 and 43, and two larger ones,
+// written by hand and as rm::SmallSet / rm::RangeExcept. Each benchmark
+// counts the members among 2^16 ints:
+//
+// - <set>/<input>/chain: the hand-written || / && chain;
+// - <set>/<input>/set: Set::contains() in the same loop;
+// - <set>/<input>/<isa>: rm::count_matching<Set>() with that instruction set.
+//
+// <input> is random (uniform around the set) or skewed (95% one value that
+// is not in the set, where the chain's branches are predicted well).
+//
+// This file is built twice, as rm_predicates_bench_O2 and
+// rm_predicates_bench_O3: -O3 vectorizes some of the chains by itself.
+
+namespace
+{
+constexpr std::size_t kValues{std::size_t{1} << 16};
+
+std::vector<int> make_input(bool skewed, int low, int high)
+{
+    std::mt19937 generator{11};
+    std::uniform_int_distribution<int> uniform{low, high};
+    std::uniform_int_distribution<int> percent{0, 99};
+    std::vector<int> values(kValues);
+    for (int &x : values)
+        x = skewed && percent(generator) < 95 ? low - 1 : uniform(generator);
+    return values;
+}
+
+template <typename Count>
+void count_members(enpm702::bench::State &state, const std::vector<int> &values, Count count)
+{
+    state.set_items_per_iteration(static_cast<double>(values.size()));
+    for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    {
+        std::size_t members{count(values.data(), values.size())};
+        do_not_optimize(members);
+    }
+}
+
+// Registers the chain, the set and the vector versions of one predicate
+template <typename Set, typename Chain>
+void register_predicate(const std::string &name, int low, int high, Chain chain)
+{
+    using enpm702::bench::register_benchmark;
+    std::vector<rm::SimdLevel> levels;
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx2)
+        levels.push_back(rm::SimdLevel::kAvx2);
+    if (rm::detected_simd_level() >= rm::SimdLevel::kAvx512)
+        levels.push_back(rm::SimdLevel::kAvx512);
+    for (bool skewed : {false, true})
+    {
+        const std::string prefix{name + (skewed ? "/skewed/" : "/random/")};
+        const std::vector<int> values{make_input(skewed, low, high)};
+        register_benchmark(prefix + "chain", [values, chain](auto &state) {
+            count_members(state, values, [chain](const int *data, std::size_t size) {
+                std::size_t members{0};
+                for (std::size_t i{0}; i < size; ++i)
+                {
+                    if (chain(data[i]))
+                        ++members;
+                }
+                return members;
+            });
+        });
+        register_benchmark(prefix + "set", [values](auto &state) {
+            count_members(state, values, [](const int *data, std::size_t size) {
+                std::size_t members{0};
+                for (std::size_t i{0}; i < size; ++i)
+                    members += Set::contains(data[i]);
+                return members;
+            });
+        });
+        for (rm::SimdLevel level : levels)
+        {
+            register_benchmark(prefix + rm::to_string(level), [values, level](auto &state) {
+                count_members(state, values, [level](const int *data, std::size_t size) {
+                    return rm::count_matching<Set>(data, size, level);
+                });
+            });
+        }
+    }
+}
+
+[[maybe_unused]] const bool registered{[] {
+    // snippet 42
+    register_predicate<rm::SmallSet<1, 2, 4>>("small_set/1_2_4", -2, 7,
+                                              [](int pp) { return pp == 1 || pp == 2 || pp == 4; });
+    // snippet 43
+    register_predicate<rm::RangeExcept<1, 5, 3>>("range_except/1_5_not_3", -2, 8,
+                                                 [](int qq) { return qq > 0 && qq < 6 && qq != 3; });
+    // eight values within 64: still one mask
+    register_predicate<rm::SmallSet<3, 7, 12, 19, 28, 35, 47, 60>>("small_set/8_values", 0, 63, [](int x) {
+        return x == 3 || x == 7 || x == 12 || x == 19 || x == 28 || x == 35 || x == 47 || x == 60;
+    });
+    // twelve values over 1000: a bit table
+    register_predicate<rm::SmallSet<10, 95, 180, 260, 333, 420, 512, 600, 701, 802, 900, 999>>(
+        "small_set/12_values_table", 0, 1023, [](int x) {
+            return x == 10 || x == 95 || x == 180 || x == 260 || x == 333 || x == 420 || x == 512 || x == 600 ||
+                   x == 701 || x == 802 || x == 900 || x == 999;
+        });
+    return true;
+}()};
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    return enpm702::bench::run_benchmarks(argc, argv);
+}
@@ -0,0 +1,296 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "int_parser.hpp"
+#include "session.hpp"
+
+// Replays scripted sessions of the prompt loops of rm.cpp (snippets 15,
+// 20, 22, 27 and 28) through rm::SessionLoop, all on one thread:
+//
+//     rm_sessions [--generate N] [--seed S] [--corpus FILE] [--print]
+//
+// --generate makes N random sessions (10000 by default); --corpus reads
+// them from FILE instead, where a line "== <snippet>" starts each session
+// and the lines after it are what the user types:
+//
+//     == 28
+//     5
+//     -1
+//
+// --print writes every transcript after its "== <snippet>" line; it is the
+// text `rm_cpp --run <snippet>` prints for the same input.
+//
+// The loops below are those of rm.cpp with std::cin >> replaced by
+// co_await session.read<T>(). At the end of the input, or when a read
+// fails, the session ends where the blocking snippet would spin forever.
+
+namespace
+{
+rm::SessionTask snippet_15(rm::Session &session)
+{
+    int j{2};
+    session << "Do you want to double the value of variable j? (y/n) ";
+    std::optional<char> input{co_await session.read<char>()};
+    if (!input)
+        co_return;
+    switch (*input)
+    {
+    case 'y':
+    case 'Y':
+        j *= 2; // double the number
+        break;
+    case 'n':
+    case 'N':
+        break; // not doing anything
+    default:
+        session << "unknown input\n";
+        break;
+    }
+    session << "Value of j: " << j << '\n';
+}
+
+rm::SessionTask snippet_20(rm::Session &session)
+{
+    while (true)
+    { // infinite loop
+        session << "Loop again (y/n)? ";
+        std::optional<char> input2{co_await session.read<char>()};
+        if (!input2)
+            co_return;
+        if (*input2 == 'n')
+        {
+            session << "Stopping the loop\n";
+            break;
+        }
+    }
+}
+
+rm::SessionTask snippet_22(rm::Session &session)
+{
+    int selection{};
+    do
+    {
+        session << "Which approach do you want to use (1 or 2)?:\n";
+        session << "1) Breadth-first search\n";
+        session << "2) Depth-first search\n";
+        session << "Please select an approach: ";
+        std::optional<int> input{co_await session.read<int>()};
+        if (!input)
+            co_return;
+        selection = *input;
+    } while (selection != 1 && selection != 2);
+
+    switch (selection)
+    {
+    case 1:
+        session << "You selected: Breadth-first\n";
+        break;
+    case 2:
+        session << "You selected: Depth-first search\n";
+        break;
+    }
+}
+
+rm::SessionTask snippet_27(rm::Session &session)
+{
+    while (true)
+    { // infinite loop
+        session << "Loop again (y/n)? ";
+        std::optional<char> input3{co_await session.read<char>()};
+        if (!input3)
+            co_return;
+        if (*input3 == 'n')
+            break;
+    }
+    // execution will continue here after the break
+    session << "Resuming program execution\n";
+}
+
+rm::SessionTask snippet_28(rm::Session &session)
+{
+    do
+    {
+        session << "Enter a number (-1 to exit): ";
+        std::optional<int> num{co_await session.read<int>()};
+        if (!num)
+            co_return;
+        if (*num == -1)
+        {
+            break; // Exit the loop when -1 is entered
+        }
+        session << "You entered: " << *num << '\n';
+    } while (true); // Infinite loop, but we have a break condition inside
+    session << "You chose to exit.\n";
+}
+
+struct Program
+{
+    const char *id;
+    rm::SessionProgram run;
+};
+
+constexpr Program kPrograms[]{
+    {"15", snippet_15}, {"20", snippet_20}, {"22", snippet_22}, {"27", snippet_27}, {"28", snippet_28},
+};
+
+const Program *find_program(std::string_view id)
+{
+    for (const Program &program : kPrograms)
+    {
+        if (id == program.id)
+            return &program;
+    }
+    return nullptr;
+}
+
+struct Script
+{
+    const Program *program;
+    std::string input;
+};
+
+// What a user of each snippet might type
+std::vector<Script> generate_scripts(std::size_t count, std::uint64_t seed)
+{
+    std::mt19937_64 generator{seed};
+    auto below{[&](int n) { return static_cast<int>(generator() % static_cast<std::uint64_t>(n)); }};
+    std::vector<Script> scripts(count);
+    for (Script &script : scripts)
+    {
+        script.program = &kPrograms[below(5)];
+        std::string &input{script.input};
+        switch (script.program->id[1])
+        {
+        case '5': // 15
+            input += "yYnNx"[below(5)];
+            input += '\n';
+            break;
+        case '0': // 20
+        case '7': // 27
+            for (int i{below(20)}; i > 0; --i)
+                input += "y\n";
+            input += "n\n";
+            break;
+        case '2': // 22
+            for (int i{below(4)}; i > 0; --i)
+                input += std::to_string(below(10) + 3) + '\n';
+            input += below(2) ? "1\n" : "2\n";
+            break;
+        case '8': // 28
+            for (int i{below(20)}; i > 0; --i)
+                input += std::to_string(below(2000) - 999) + '\n';
+            input += "-1\n";
+            break;
+        }
+    }
+    return scripts;
+}
+
+bool read_corpus(const char *path, std::vector<Script> &scripts)
+{
+    rm::InputText text{path};
+    if (!text.ok())
+        return false;
+    std::string_view rest{text.text()};
+    while (!rest.empty())
+    {
+        std::size_t end{rest.find('\n')};
+        std::string_view line{rest.substr(0, end)};
+        rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+        if (line.substr(0, 3) == "== ")
+        {
+            const Program *program{find_program(line.substr(3))};
+            if (!program)
+            {
+                std::fprintf(stderr, "unknown snippet in \"%.*s\"\n", static_cast<int>(line.size()), line.data());
+                return false;
+            }
+            scripts.push_back(Script{program, {}});
+        }
+        else if (!scripts.empty())
+        {
+            scripts.back().input.append(line.data(), line.size());
+            scripts.back().input += '\n';
+        }
+        else if (!line.empty())
+        {
+            std::fprintf(stderr, "%s must start with a \"== <snippet>\" line\n", path);
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t count{10000};
+    std::uint64_t seed{1};
+    const char *corpus{nullptr};
+    bool print{false};
+    for (int i{1}; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--generate") == 0 && i + 1 < argc)
+            count = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--corpus") == 0 && i + 1 < argc)
+            corpus = argv[++i];
+        else if (std::strcmp(argv[i], "--print") == 0)
+            print = true;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--generate N] [--seed S] [--corpus FILE] [--print]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Script> scripts;
+    if (corpus)
+    {
+        if (!read_corpus(corpus, scripts))
+        {
+            std::fprintf(stderr, "%s: cannot read %s\n", argv[0], corpus);
+            return 1;
+        }
+    }
+    else
+    {
+        scripts = generate_scripts(count, seed);
+    }
+
+    auto start{std::chrono::steady_clock::now()};
+    rm::SessionLoop loop;
+    for (Script &script : scripts)
+        loop.add(std::move(script.input), script.program->run);
+    loop.run();
+    std::chrono::duration<double> seconds{std::chrono::steady_clock::now() - start};
+
+    std::size_t output_bytes{0};
+    for (std::size_t i{0}; i < loop.size(); ++i)
+    {
+        const std::string &output{loop.session(i).output()};
+        output_bytes += output.size();
+        if (print)
+        {
+            std::printf("== %s\n", scripts[i].program->id);
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            if (!output.empty() && output.back() != '\n')
+                std::putchar('\n'); // a session that ended at a prompt
+        }
+    }
+    if (!print)
+    {
+        std::printf("%zu sessions, %zu bytes of output, %.3f ms (%.0f sessions/s)\n", loop.size(), output_bytes,
+                    seconds.count() * 1e3, static_cast<double>(loop.size()) / seconds.count());
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#include "out_writer.hpp"
+#include "text_stats.hpp"
+
+// Line, word and byte statistics of a text file, like `wc -lwc` plus the
+// most frequent words and the byte histogram:
+//
+//     rm_text_stats [--threads N] [--top K] [--chunk-mib M] [--histogram]
+//                   [--naive] FILE
+//
+// --naive reads the file with std::getline and counts the words in a
+// std::unordered_map on one thread, for comparison.
+
+namespace
+{
+void usage(const char *program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--threads N] [--top K] [--chunk-mib M] [--histogram] [--naive] FILE\n",
+                 program);
+}
+
+// The value of option argv[i], which must be a positive number
+bool option_value(int argc, char *argv[], int &i, std::size_t &value)
+{
+    if (i + 1 >= argc)
+        return false;
+    char *end{};
+    unsigned long long parsed{std::strtoull(argv[++i], &end, 10)};
+    if (*end != '\0' || parsed == 0)
+        return false;
+    value = static_cast<std::size_t>(parsed);
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    rm::TextStatsOptions options;
+    bool histogram{false};
+    bool naive{false};
+    const char *path{nullptr};
+    for (int i{1}; i < argc; ++i)
+    {
+        std::size_t value{};
+        if (std::strcmp(argv[i], "--threads") == 0 && option_value(argc, argv, i, value))
+            options.threads = static_cast<unsigned>(value);
+        else if (std::strcmp(argv[i], "--top") == 0 && option_value(argc, argv, i, value))
+            options.top_k = value;
+        else if (std::strcmp(argv[i], "--chunk-mib") == 0 && option_value(argc, argv, i, value))
+            options.chunk_size = value << 20;
+        else if (std::strcmp(argv[i], "--histogram") == 0)
+            histogram = true;
+        else if (std::strcmp(argv[i], "--naive") == 0)
+            naive = true;
+        else if (argv[i][0] != '-' && !path)
+            path = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!path)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    rm::TextStats stats;
+    if (naive)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (!in)
+        {
+            std::fprintf(stderr, "%s: cannot read %s\n", argv[0], path);
+            return 1;
+        }
+        stats = rm::naive_text_stats(in, options.top_k);
+    }
+    else if (!rm::text_stats(path, options, stats))
+    {
+        std::fprintf(stderr, "%s: cannot read %s\n", argv[0], path);
+        return 1;
+    }
+
+    rm::OutWriter out;
+    out << stats.lines << ' ' << stats.words << ' ' << stats.bytes << ' ' << path << '\n';
+    for (const auto &word : stats.top_words)
+        out << word.count << '\t' << std::string_view{word.word} << '\n';
+    if (histogram)
+    {
+        for (int c{0}; c < 256; ++c)
+        {
+            if (stats.histogram[c] == 0)
+                continue;
+            if (std::isprint(c) && c != ' ')
+                out << static_cast<char>(c);
+            else
+                out << "\\x" << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 15];
+            out << '\t' << stats.histogram[c] << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file constexpr_tables.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Lookup tables computed by the compiler
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippets 19 and 20 of week2.cpp separate values known at run time from
+ * constexpr values known at compile time. A whole table can be a constexpr
+ * value too: make_table() fills a std::array in a constexpr function, and
+ * the tables below are `inline constexpr` variables the compiler emits into
+ * .rodata. They are mapped with the executable, so no code runs at startup
+ * and there is no first-use check, unlike a table filled by a static
+ * initializer or by a function-local static.
+ *
+ * @code
+ * static_assert(week2::crc32("123456789") == 0xCBF43926);
+ * std::int16_t root_half{week2::sin_q15(week2::kAngleSteps / 8)};  // sin(45 deg)
+ * std::uint64_t mega{week2::power<10>(6)};
+ * @endcode
+ *
+ * Whether a lookup beats computing the value depends on the value: a
+ * square is one multiplication and gains nothing, pow10, sin and CRC32 are
+ * several times faster from a table, and popcount is only worth a table
+ * where the popcnt instruction cannot be used. week2_bench measures both
+ * sides.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace week2 {
+
+/**
+ * @brief A table of @p N values, value i being @p generator(i)
+ *
+ * Called in a constant expression, e.g. to initialize a constexpr variable,
+ * it runs in the compiler. @p generator must then be usable in constant
+ * expressions (lambdas are, when their body is).
+ */
+template <typename T, std::size_t N, typename Generator>
+constexpr std::array<T, N> make_table(Generator generator) {
+  std::array<T, N> table{};
+  for (std::size_t i{0}; i < N; ++i)
+    table[i] = static_cast<T>(generator(i));
+  return table;
+}
+
+//======== squares (snippet 18's SQUARE(x))
+
+constexpr std::size_t kSquareCount{4096};
+
+inline constexpr std::array<std::uint32_t, kSquareCount> kSquares{
+    make_table<std::uint32_t, kSquareCount>([](std::size_t x) { return x * x; })};
+
+/**
+ * @brief x * x from the table, for x < kSquareCount
+ */
+constexpr std::uint32_t square_of(std::uint32_t x) { return kSquares[x]; }
+
+//======== integer powers
+
+/**
+ * @brief The largest exponent e for which base^e fits in 64 bits
+ */
+constexpr std::size_t max_exponent(std::uint64_t base) {
+  if (base < 2)
+    return 64;  // 0^e and 1^e never overflow; keep 65 entries
+  std::size_t exponent{0};
+  for (std::uint64_t value{1}; value <= std::numeric_limits<std::uint64_t>::max() / base; value *= base)
+    ++exponent;
+  return exponent;
+}
+
+/**
+ * @brief base^0 to base^max_exponent(base)
+ */
+template <std::uint64_t Base>
+inline constexpr std::array<std::uint64_t, max_exponent(Base) + 1> kPowers{
+    make_table<std::uint64_t, max_exponent(Base) + 1>([](std::size_t exponent) {
+      std::uint64_t value{1};
+      for (std::size_t i{0}; i < exponent; ++i)
+        value *= Base;
+      return value;
+    })};
+
+/**
+ * @brief Base^exponent, for exponent <= max_exponent(Base)
+ */
+template <std::uint64_t Base>
+constexpr std::uint64_t power(unsigned exponent) {
+  return kPowers<Base>[exponent];
+}
+
+/**
+ * @brief 1e0 to 1e22, the powers of ten a double holds exactly
+ */
+inline constexpr std::array<double, 23> kPowersOf10{
+    make_table<double, 23>([](std::size_t exponent) {
+      double value{1.0};
+      for (std::size_t i{0}; i < exponent; ++i)
+        value *= 10.0;  // exact: every step fits in 53 bits
+      return value;
+    })};
+
+/**
+ * @brief 10^exponent, for 0 <= exponent <= 22, exactly as std::pow gives it
+ */
+constexpr double pow10(int exponent) { return kPowersOf10[static_cast<std::size_t>(exponent)]; }
+
+//======== fixed-point sine and cosine
+
+/**
+ * @brief Steps in a full turn: angles are given as multiples of 2 pi / kAngleSteps
+ */
+constexpr std::uint32_t kAngleSteps{4096};
+
+/**
+ * @brief Pi to double precision; snippet 18's PI (3.14159) is off by 2.7e-6
+ */
+constexpr double kPi{3.14159265358979323846};
+
+namespace detail {
+
+// sin(x) for 0 <= x <= pi / 2: the Taylor series converges in a few terms
+constexpr double sin_series(double x) {
+  double term{x};
+  double sum{x};
+  for (int n{1}; n < 12; ++n) {
+    term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+    sum += term;
+  }
+  return sum;
+}
+
+// Angles are split into quadrants in integer steps, so the series is only
+// evaluated on [0, pi / 2] and sin stays exactly odd and periodic
+constexpr std::int16_t sin_step(std::size_t step) {
+  constexpr std::size_t kQuarter{kAngleSteps / 4};
+  const std::size_t quadrant{step / kQuarter};
+  const std::size_t offset{step % kQuarter};
+  const std::size_t reduced{quadrant % 2 == 0 ? offset : kQuarter - offset};
+  double value{sin_series(static_cast<double>(reduced) * (2.0 * kPi / kAngleSteps))};
+  if (quadrant >= 2)
+    value = -value;
+  // Q15 rounded to nearest: 32767 is 1.0
+  return static_cast<std::int16_t>(value >= 0 ? value * 32767.0 + 0.5 : value * 32767.0 - 0.5);
+}
+
+}  // namespace detail
+
+/**
+ * @brief sin(2 pi i / kAngleSteps) in Q15 (32767 is 1.0)
+ */
+inline constexpr std::array<std::int16_t, kAngleSteps> kSinQ15{
+    make_table<std::int16_t, kAngleSteps>(detail::sin_step)};
+
+/**
+ * @brief sin of @p angle steps in Q15; any angle, wrapped to one turn
+ */
+constexpr std::int16_t sin_q15(std::uint32_t angle) { return kSinQ15[angle % kAngleSteps]; }
+
+/**
+ * @brief cos of @p angle steps in Q15, read from the sine table a quarter
+ * turn ahead
+ */
+constexpr std::int16_t cos_q15(std::uint32_t angle) {
+  return kSinQ15[(angle + kAngleSteps / 4) % kAngleSteps];
+}
+
+/**
+ * @brief sin(@p radians) from the table, at the nearest step
+ *
+ * Within 8e-4 of std::sin (half a step, plus the Q15 rounding). Meant for
+ * |radians| below about 1e12.
+ */
+inline double table_sin(double radians) {
+  const double steps{std::floor(radians * (kAngleSteps / (2.0 * kPi)) + 0.5)};
+  // the cast wraps negative angles modulo 2^32, a multiple of kAngleSteps
+  return sin_q15(static_cast<std::uint32_t>(static_cast<std::int64_t>(steps))) / 32767.0;
+}
+
+/**
+ * @brief cos(@p radians) from the table, at the nearest step
+ */
+inline double table_cos(double radians) {
+  const double steps{std::floor(radians * (kAngleSteps / (2.0 * kPi)) + 0.5)};
+  return cos_q15(static_cast<std::uint32_t>(static_cast<std::int64_t>(steps))) / 32767.0;
+}
+
+//======== CRC32
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) of every byte
+ */
+inline constexpr std::array<std::uint32_t, 256> kCrc32Table{
+    make_table<std::uint32_t, 256>([](std::size_t byte) {
+      std::uint32_t crc{static_cast<std::uint32_t>(byte)};
+      for (int bit{0}; bit < 8; ++bit)
+        crc = (crc >> 1) ^ ((crc & 1u) != 0 ? 0xEDB88320u : 0u);
+      return crc;
+    })};
+
+/**
+ * @brief CRC-32 of @p bytes, as zlib's crc32() computes it
+ *
+ * Works at compile time on literals. Pass the previous result as @p crc to
+ * continue over several buffers; wrap other byte buffers in a string_view.
+ */
+constexpr std::uint32_t crc32(std::string_view bytes, std::uint32_t crc = 0) {
+  crc = ~crc;
+  for (char c : bytes)
+    crc = (crc >> 8) ^ kCrc32Table[(crc ^ static_cast<unsigned char>(c)) & 0xFFu];
+  return ~crc;
+}
+
+//======== popcount
+
+inline constexpr std::array<std::uint8_t, 256> kPopcount8{
+    make_table<std::uint8_t, 256>([](std::size_t byte) {
+      int count{0};
+      for (; byte != 0; byte &= byte - 1)
+        ++count;
+      return count;
+    })};
+
+/**
+ * @brief Number of bits set in @p x, one table lookup per byte
+ */
+constexpr int popcount(std::uint64_t x) {
+  int count{0};
+  for (int byte{0}; byte < 8; ++byte, x >>= 8)
+    count += kPopcount8[x & 0xFFu];
+  return count;
+}
+
+}  // namespace week2
@@ -0,0 +1,517 @@
+/**
+ * @file convert.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Conversions between floating-point and integer arrays
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippets 11 and 13 of week2.cpp convert a double to an int, which drops
+ * the fraction: `static_cast<int>(3.5)` is 3. If the value does not fit in
+ * an int, or is NaN, the conversion is undefined behavior. to_int() does
+ * the same conversions with every result defined, for one value or for
+ * whole arrays:
+ *
+ * @code
+ * std::int32_t a{week2::to_int<std::int32_t>(3.5)};  // 3
+ * std::int32_t b{week2::to_int<std::int32_t>(3.5, {week2::Rounding::kNearestEven})};  // 4
+ * std::int8_t c{week2::to_int<std::int8_t>(300.0, {week2::Rounding::kTruncate,
+ *                                                  week2::Overflow::kSaturate})};  // 127
+ *
+ * week2::to_int(doubles.data(), ints.data(), doubles.size());
+ * week2::to_float(ints.data(), doubles.data(), ints.size());
+ * @endcode
+ *
+ * float and double convert to std::int8_t, int16_t, int32_t or int64_t:
+ *
+ * - Rounding::kTruncate drops the fraction, like static_cast;
+ *   Rounding::kNearestEven rounds halves to even (2.5 to 2, 3.5 to 4);
+ * - Overflow::kMinValue turns values out of range, infinities and NaN into
+ *   the lowest value of the type, which is what the x86 instructions give
+ *   for 32 and 64-bit results; Overflow::kSaturate clamps them to the
+ *   lowest or highest value and turns NaN into 0.
+ *
+ * to_float() converts the other way, rounding to nearest as static_cast
+ * does (only 64-bit integers beyond 2^53, or 32-bit ones beyond 2^24 into
+ * float, round).
+ *
+ * The array versions use AVX2 or AVX-512 (see simd_dispatch.hpp) and give
+ * exactly the results of the single-value versions. AVX2 has no 64-bit
+ * integer conversions, so int64_t arrays are converted one value at a time
+ * at that level. All rounding assumes the default floating-point
+ * environment (round to nearest) and no -ffast-math.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "simd_dispatch.hpp"
+
+namespace week2 {
+
+/**
+ * @brief How the fraction is removed
+ */
+enum class Rounding {
+  kTruncate,     ///< toward zero, like static_cast
+  kNearestEven,  ///< to nearest, halves to even
+};
+
+/**
+ * @brief What values out of range and NaN become
+ */
+enum class Overflow {
+  kMinValue,  ///< the lowest value of the type, NaN included
+  kSaturate,  ///< the lowest or highest value; NaN becomes 0
+};
+
+struct ConvertMode {
+  Rounding rounding{Rounding::kTruncate};
+  Overflow overflow{Overflow::kMinValue};
+};
+
+namespace detail {
+
+template <typename Int, typename Float>
+constexpr bool is_conversion_v = std::is_floating_point_v<Float> && std::is_integral_v<Int> &&
+                                 std::is_signed_v<Int> && sizeof(Float) <= 8 && sizeof(Int) <= 8;
+
+// Nearest integer, halves to even: adding and subtracting 2^52 (2^23 for
+// float) leaves no fraction bits, and the addition rounds as the FPU does
+template <typename Float>
+Float round_half_even(Float x) {
+  constexpr Float kShift{Float{1} / std::numeric_limits<Float>::epsilon()};
+  const Float magnitude{std::fabs(x)};
+  if (!(magnitude < kShift))
+    return x;  // already an integer, or infinite, or NaN
+  return std::copysign((magnitude + kShift) - kShift, x);
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow, typename Float>
+Int to_int(Float x) {
+  constexpr Int kMin{std::numeric_limits<Int>::min()};
+  constexpr Int kMax{std::numeric_limits<Int>::max()};
+  constexpr Float kLow{static_cast<Float>(kMin)};  // a power of two: exact
+  constexpr Float kBelowLow{kLow - 1};              // kLow itself when 1 is below its precision
+  const Float whole{kRounding == Rounding::kNearestEven ? round_half_even(x) : x};
+  // whole truncates into [kMin, kMax]; false for NaN
+  if (whole < -kLow && (whole > kBelowLow || whole == kLow))
+    return static_cast<Int>(whole);
+  if constexpr (kOverflow == Overflow::kMinValue) {
+    return kMin;
+  } else {
+    if (std::isnan(x))
+      return 0;
+    return x < 0 ? kMin : kMax;
+  }
+}
+
+// Calls function(rounding, overflow) with both as std::integral_constant,
+// so that each mode gets its own kernels
+template <typename Function>
+void with_mode(ConvertMode mode, Function function) {
+  using Truncate = std::integral_constant<Rounding, Rounding::kTruncate>;
+  using NearestEven = std::integral_constant<Rounding, Rounding::kNearestEven>;
+  using MinValue = std::integral_constant<Overflow, Overflow::kMinValue>;
+  using Saturate = std::integral_constant<Overflow, Overflow::kSaturate>;
+  if (mode.rounding == Rounding::kTruncate) {
+    if (mode.overflow == Overflow::kMinValue)
+      function(Truncate{}, MinValue{});
+    else
+      function(Truncate{}, Saturate{});
+  } else {
+    if (mode.overflow == Overflow::kMinValue)
+      function(NearestEven{}, MinValue{});
+    else
+      function(NearestEven{}, Saturate{});
+  }
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow, typename Float>
+void to_int_scalar(const Float* in, Int* out, std::size_t size) {
+  for (std::size_t i{0}; i < size; ++i)
+    out[i] = to_int<Int, kRounding, kOverflow>(in[i]);
+}
+
+template <typename Float, typename Int>
+void to_float_scalar(const Int* in, Float* out, std::size_t size) {
+  for (std::size_t i{0}; i < size; ++i)
+    out[i] = static_cast<Float>(in[i]);
+}
+
+#ifdef ENPM702_X86
+
+// The vector kernels compute every lane as to_int() does: the value is
+// rounded if asked, converted with the truncating instruction, and the
+// lanes whose rounded value is out of range (or NaN) get the fallback.
+// Results narrower than 32 bits are converted to 32 bits first, then
+// narrowed, which is exact since they are in range by then.
+
+//======== AVX2: 8 values per step
+
+__attribute__((target("avx2"))) inline __m256 round_avx2(__m256 x) {
+  return _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx2"))) inline __m256d round_avx2(__m256d x) {
+  return _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+// All ones in the lanes of whole that truncate into Int's range
+template <typename Int>
+__attribute__((target("avx2"))) inline __m256 in_range_avx2(__m256 whole) {
+  constexpr float kLow{static_cast<float>(std::numeric_limits<Int>::min())};
+  return _mm256_and_ps(_mm256_cmp_ps(whole, _mm256_set1_ps(-kLow), _CMP_LT_OQ),
+                       _mm256_or_ps(_mm256_cmp_ps(whole, _mm256_set1_ps(kLow - 1), _CMP_GT_OQ),
+                                    _mm256_cmp_ps(whole, _mm256_set1_ps(kLow), _CMP_EQ_OQ)));
+}
+
+template <typename Int>
+__attribute__((target("avx2"))) inline __m256d in_range_avx2(__m256d whole) {
+  constexpr double kLow{static_cast<double>(std::numeric_limits<Int>::min())};
+  return _mm256_and_pd(_mm256_cmp_pd(whole, _mm256_set1_pd(-kLow), _CMP_LT_OQ),
+                       _mm256_or_pd(_mm256_cmp_pd(whole, _mm256_set1_pd(kLow - 1), _CMP_GT_OQ),
+                                    _mm256_cmp_pd(whole, _mm256_set1_pd(kLow), _CMP_EQ_OQ)));
+}
+
+// One 32-bit mask lane per 64-bit mask lane of two vectors
+__attribute__((target("avx2"))) inline __m256i narrow_masks_avx2(__m256d low, __m256d high) {
+  const __m256i even{_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)};
+  return _mm256_set_m128i(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(high), even)),
+                          _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(low), even)));
+}
+
+// converted where in_range is set, the fallback of Int elsewhere
+template <typename Int, Overflow kOverflow>
+__attribute__((target("avx2"))) inline __m256i fix_avx2(__m256i converted, __m256i in_range, __m256i negative,
+                                                        __m256i nan) {
+  const __m256i low{_mm256_set1_epi32(std::numeric_limits<Int>::min())};
+  __m256i fallback{low};
+  if constexpr (kOverflow == Overflow::kSaturate) {
+    fallback = _mm256_blendv_epi8(_mm256_set1_epi32(std::numeric_limits<Int>::max()), low, negative);
+    fallback = _mm256_andnot_si256(nan, fallback);
+  }
+  return _mm256_blendv_epi8(fallback, converted, in_range);
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx2"))) inline __m256i to_int32_avx2(const float* in) {
+  const __m256 x{_mm256_loadu_ps(in)};
+  const __m256 whole{kRounding == Rounding::kNearestEven ? round_avx2(x) : x};
+  return fix_avx2<Int, kOverflow>(_mm256_cvttps_epi32(whole), _mm256_castps_si256(in_range_avx2<Int>(whole)),
+                                  _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ)),
+                                  _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q)));
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx2"))) inline __m256i to_int32_avx2(const double* in) {
+  const __m256d low{_mm256_loadu_pd(in)};
+  const __m256d high{_mm256_loadu_pd(in + 4)};
+  const __m256d whole_low{kRounding == Rounding::kNearestEven ? round_avx2(low) : low};
+  const __m256d whole_high{kRounding == Rounding::kNearestEven ? round_avx2(high) : high};
+  const __m256i converted{_mm256_set_m128i(_mm256_cvttpd_epi32(whole_high), _mm256_cvttpd_epi32(whole_low))};
+  const __m256d zero{_mm256_setzero_pd()};
+  return fix_avx2<Int, kOverflow>(
+      converted, narrow_masks_avx2(in_range_avx2<Int>(whole_low), in_range_avx2<Int>(whole_high)),
+      narrow_masks_avx2(_mm256_cmp_pd(low, zero, _CMP_LT_OQ), _mm256_cmp_pd(high, zero, _CMP_LT_OQ)),
+      narrow_masks_avx2(_mm256_cmp_pd(low, low, _CMP_UNORD_Q), _mm256_cmp_pd(high, high, _CMP_UNORD_Q)));
+}
+
+// Stores 8 int32 lanes, all within Int's range, as Int
+template <typename Int>
+__attribute__((target("avx2"))) inline void store_avx2(Int* out, __m256i values) {
+  if constexpr (sizeof(Int) == 4) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+  } else {
+    const __m128i words{_mm_packs_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1))};
+    if constexpr (sizeof(Int) == 2)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), words);
+    else
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi16(words, words));
+  }
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow, typename Float>
+__attribute__((target("avx2"))) void to_int_avx2(const Float* in, Int* out, std::size_t size) {
+  std::size_t i{0};
+  if constexpr (sizeof(Int) <= 4) {
+    for (; i + 8 <= size; i += 8)
+      store_avx2(out + i, to_int32_avx2<Int, kRounding, kOverflow>(in + i));
+  }
+  for (; i < size; ++i)
+    out[i] = to_int<Int, kRounding, kOverflow>(in[i]);
+}
+
+// 8 integers, sign-extended to 32 bits
+template <typename Int>
+__attribute__((target("avx2"))) inline __m256i load_int32_avx2(const Int* in) {
+  if constexpr (sizeof(Int) == 1)
+    return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)));
+  else if constexpr (sizeof(Int) == 2)
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+  else
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+}
+
+template <typename Float, typename Int>
+__attribute__((target("avx2"))) void to_float_avx2(const Int* in, Float* out, std::size_t size) {
+  std::size_t i{0};
+  if constexpr (sizeof(Int) <= 4) {
+    for (; i + 8 <= size; i += 8) {
+      const __m256i values{load_int32_avx2(in + i)};
+      if constexpr (std::is_same_v<Float, float>) {
+        _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(values));
+      } else {
+        _mm256_storeu_pd(out + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(values)));
+        _mm256_storeu_pd(out + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)));
+      }
+    }
+  }
+  for (; i < size; ++i)
+    out[i] = static_cast<Float>(in[i]);
+}
+
+//======== AVX-512: 16 values per step, 8 for 64-bit integers
+
+ENPM702_SIMD_KERNELS_BEGIN
+
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512 round_avx512(__m512 x) {
+  return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512d round_avx512(__m512d x) {
+  return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m256 round_avx512(__m256 x) {
+  return _mm256_roundscale_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+template <typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __mmask16 in_range_avx512(__m512 whole) {
+  constexpr float kLow{static_cast<float>(std::numeric_limits<Int>::min())};
+  return _mm512_cmp_ps_mask(whole, _mm512_set1_ps(-kLow), _CMP_LT_OQ) &
+         (_mm512_cmp_ps_mask(whole, _mm512_set1_ps(kLow - 1), _CMP_GT_OQ) |
+          _mm512_cmp_ps_mask(whole, _mm512_set1_ps(kLow), _CMP_EQ_OQ));
+}
+
+template <typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __mmask8 in_range_avx512(__m512d whole) {
+  constexpr double kLow{static_cast<double>(std::numeric_limits<Int>::min())};
+  return _mm512_cmp_pd_mask(whole, _mm512_set1_pd(-kLow), _CMP_LT_OQ) &
+         (_mm512_cmp_pd_mask(whole, _mm512_set1_pd(kLow - 1), _CMP_GT_OQ) |
+          _mm512_cmp_pd_mask(whole, _mm512_set1_pd(kLow), _CMP_EQ_OQ));
+}
+
+template <typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __mmask8 in_range_avx512(__m256 whole) {
+  constexpr float kLow{static_cast<float>(std::numeric_limits<Int>::min())};
+  return _mm256_cmp_ps_mask(whole, _mm256_set1_ps(-kLow), _CMP_LT_OQ) &
+         (_mm256_cmp_ps_mask(whole, _mm256_set1_ps(kLow - 1), _CMP_GT_OQ) |
+          _mm256_cmp_ps_mask(whole, _mm256_set1_ps(kLow), _CMP_EQ_OQ));
+}
+
+template <typename Int, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i fix32_avx512(
+    __m512i converted, __mmask16 in_range, __mmask16 negative, __mmask16 nan) {
+  const __m512i low{_mm512_set1_epi32(std::numeric_limits<Int>::min())};
+  __m512i fallback{low};
+  if constexpr (kOverflow == Overflow::kSaturate) {
+    fallback = _mm512_mask_blend_epi32(negative, _mm512_set1_epi32(std::numeric_limits<Int>::max()), low);
+    fallback = _mm512_maskz_mov_epi32(static_cast<__mmask16>(~nan), fallback);
+  }
+  return _mm512_mask_blend_epi32(in_range, fallback, converted);
+}
+
+template <typename Int, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i fix64_avx512(
+    __m512i converted, __mmask8 in_range, __mmask8 negative, __mmask8 nan) {
+  const __m512i low{_mm512_set1_epi64(std::numeric_limits<Int>::min())};
+  __m512i fallback{low};
+  if constexpr (kOverflow == Overflow::kSaturate) {
+    fallback = _mm512_mask_blend_epi64(negative, _mm512_set1_epi64(std::numeric_limits<Int>::max()), low);
+    fallback = _mm512_maskz_mov_epi64(static_cast<__mmask8>(~nan), fallback);
+  }
+  return _mm512_mask_blend_epi64(in_range, fallback, converted);
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i to_int32_avx512(const float* in) {
+  const __m512 x{_mm512_loadu_ps(in)};
+  const __m512 whole{kRounding == Rounding::kNearestEven ? round_avx512(x) : x};
+  return fix32_avx512<Int, kOverflow>(_mm512_cvttps_epi32(whole), in_range_avx512<Int>(whole),
+                                      _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ),
+                                      _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q));
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i to_int32_avx512(const double* in) {
+  const __m512d low{_mm512_loadu_pd(in)};
+  const __m512d high{_mm512_loadu_pd(in + 8)};
+  const __m512d whole_low{kRounding == Rounding::kNearestEven ? round_avx512(low) : low};
+  const __m512d whole_high{kRounding == Rounding::kNearestEven ? round_avx512(high) : high};
+  const __m512i converted{
+      _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvttpd_epi32(whole_low)), _mm512_cvttpd_epi32(whole_high), 1)};
+  const __m512d zero{_mm512_setzero_pd()};
+  return fix32_avx512<Int, kOverflow>(
+      converted, _mm512_kunpackb(in_range_avx512<Int>(whole_high), in_range_avx512<Int>(whole_low)),
+      _mm512_kunpackb(_mm512_cmp_pd_mask(high, zero, _CMP_LT_OQ), _mm512_cmp_pd_mask(low, zero, _CMP_LT_OQ)),
+      _mm512_kunpackb(_mm512_cmp_pd_mask(high, high, _CMP_UNORD_Q), _mm512_cmp_pd_mask(low, low, _CMP_UNORD_Q)));
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i to_int64_avx512(const double* in) {
+  const __m512d x{_mm512_loadu_pd(in)};
+  const __m512d whole{kRounding == Rounding::kNearestEven ? round_avx512(x) : x};
+  return fix64_avx512<Int, kOverflow>(_mm512_cvttpd_epi64(whole), in_range_avx512<Int>(whole),
+                                      _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_LT_OQ),
+                                      _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q));
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i to_int64_avx512(const float* in) {
+  const __m256 x{_mm256_loadu_ps(in)};
+  const __m256 whole{kRounding == Rounding::kNearestEven ? round_avx512(x) : x};
+  return fix64_avx512<Int, kOverflow>(_mm512_cvttps_epi64(whole), in_range_avx512<Int>(whole),
+                                      _mm256_cmp_ps_mask(x, _mm256_setzero_ps(), _CMP_LT_OQ),
+                                      _mm256_cmp_ps_mask(x, x, _CMP_UNORD_Q));
+}
+
+// Stores 16 int32 lanes (8 int64 lanes for 64-bit Int), all within Int's
+// range, as Int
+template <typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline void store_avx512(Int* out, __m512i values) {
+  if constexpr (sizeof(Int) >= 4)
+    _mm512_storeu_si512(out, values);
+  else if constexpr (sizeof(Int) == 2)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvtepi32_epi16(values));
+  else
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm512_cvtepi32_epi8(values));
+}
+
+template <typename Int, Rounding kRounding, Overflow kOverflow, typename Float>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) void to_int_avx512(const Float* in, Int* out,
+                                                                                  std::size_t size) {
+  std::size_t i{0};
+  if constexpr (sizeof(Int) == 8) {
+    for (; i + 8 <= size; i += 8)
+      store_avx512(out + i, to_int64_avx512<Int, kRounding, kOverflow>(in + i));
+  } else {
+    for (; i + 16 <= size; i += 16)
+      store_avx512(out + i, to_int32_avx512<Int, kRounding, kOverflow>(in + i));
+  }
+  for (; i < size; ++i)
+    out[i] = to_int<Int, kRounding, kOverflow>(in[i]);
+}
+
+// 16 integers, sign-extended to 32 bits
+template <typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) inline __m512i load_int32_avx512(const Int* in) {
+  if constexpr (sizeof(Int) == 1)
+    return _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+  else if constexpr (sizeof(Int) == 2)
+    return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)));
+  else
+    return _mm512_loadu_si512(in);
+}
+
+template <typename Float, typename Int>
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) void to_float_avx512(const Int* in, Float* out,
+                                                                                    std::size_t size) {
+  std::size_t i{0};
+  if constexpr (sizeof(Int) == 8) {
+    for (; i + 8 <= size; i += 8) {
+      const __m512i values{_mm512_loadu_si512(in + i)};
+      if constexpr (std::is_same_v<Float, float>)
+        _mm256_storeu_ps(out + i, _mm512_cvtepi64_ps(values));
+      else
+        _mm512_storeu_pd(out + i, _mm512_cvtepi64_pd(values));
+    }
+  } else {
+    for (; i + 16 <= size; i += 16) {
+      const __m512i values{load_int32_avx512(in + i)};
+      if constexpr (std::is_same_v<Float, float>) {
+        _mm512_storeu_ps(out + i, _mm512_cvtepi32_ps(values));
+      } else {
+        _mm512_storeu_pd(out + i, _mm512_cvtepi32_pd(_mm512_castsi512_si256(values)));
+        _mm512_storeu_pd(out + i + 8, _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(values, 1)));
+      }
+    }
+  }
+  for (; i < size; ++i)
+    out[i] = static_cast<Float>(in[i]);
+}
+
+ENPM702_SIMD_KERNELS_END
+
+#endif  // ENPM702_X86
+
+}  // namespace detail
+
+/**
+ * @brief @p x converted to Int as @p mode says; defined for every @p x
+ */
+template <typename Int, typename Float>
+Int to_int(Float x, ConvertMode mode = {}) {
+  static_assert(detail::is_conversion_v<Int, Float>, "to_int converts float or double to a signed integer");
+  Int result{};
+  detail::with_mode(mode, [&](auto rounding, auto overflow) {
+    result = detail::to_int<Int, decltype(rounding)::value, decltype(overflow)::value>(x);
+  });
+  return result;
+}
+
+/**
+ * @brief out[i] = to_int<Int>(in[i], mode) for i in [0, size)
+ */
+template <typename Int, typename Float>
+void to_int(const Float* in, Int* out, std::size_t size, ConvertMode mode = {},
+            enpm702::SimdLevel simd = enpm702::SimdLevel::kAuto) {
+  static_assert(detail::is_conversion_v<Int, Float>, "to_int converts float or double to a signed integer");
+  detail::with_mode(mode, [&](auto rounding, auto overflow) {
+    constexpr Rounding kRounding{decltype(rounding)::value};
+    constexpr Overflow kOverflow{decltype(overflow)::value};
+    switch (enpm702::resolve(simd)) {
+#ifdef ENPM702_X86
+      case enpm702::SimdLevel::kAvx512:
+        detail::to_int_avx512<Int, kRounding, kOverflow>(in, out, size);
+        return;
+      case enpm702::SimdLevel::kAvx2:
+        detail::to_int_avx2<Int, kRounding, kOverflow>(in, out, size);
+        return;
+#endif
+      default:
+        detail::to_int_scalar<Int, kRounding, kOverflow>(in, out, size);
+        return;
+    }
+  });
+}
+
+/**
+ * @brief out[i] = static_cast<Float>(in[i]) for i in [0, size)
+ */
+template <typename Float, typename Int>
+void to_float(const Int* in, Float* out, std::size_t size, enpm702::SimdLevel simd = enpm702::SimdLevel::kAuto) {
+  static_assert(detail::is_conversion_v<Int, Float>, "to_float converts a signed integer to float or double");
+  switch (enpm702::resolve(simd)) {
+#ifdef ENPM702_X86
+    case enpm702::SimdLevel::kAvx512:
+      detail::to_float_avx512(in, out, size);
+      return;
+    case enpm702::SimdLevel::kAvx2:
+      detail::to_float_avx2(in, out, size);
+      return;
+#endif
+    default:
+      detail::to_float_scalar(in, out, size);
+      return;
+  }
+}
+
+}  // namespace week2
@@ -0,0 +1,138 @@
+/**
+ * @file float_format.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Locale-free float to text conversion matching iostream output
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippets 8-1 and 9-2 of week2.cpp print floating-point values through
+ * std::setprecision, std::fixed and std::scientific. Each such `<<` goes
+ * through the stream's locale facets and a printf-style conversion.
+ * format_float() writes the same characters into a caller-provided buffer,
+ * with no allocation and no locale:
+ *
+ * @code
+ * char buffer[64];
+ * char* end{week2::format_float(buffer, buffer + 64, 0.33333333333f,
+ *                               week2::FloatStyle::kGeneral, 9)};
+ * // "0.333333343", as std::cout << std::setprecision(9) prints it
+ * @endcode
+ *
+ * The conversions are std::to_chars, which libstdc++ implements with the
+ * Ryu algorithms: shortest round-trip output and exact fixed/scientific
+ * output at any precision, several times faster than printf.
+ */
+
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <ios>
+#include <type_traits>
+
+namespace week2 {
+
+/**
+ * @brief Output format, as selected on a stream
+ */
+enum class FloatStyle {
+  kGeneral,     ///< default floatfield: %g, precision = significant digits
+  kFixed,       ///< std::fixed: %f, precision = digits after the point
+  kScientific,  ///< std::scientific: %e, precision = digits after the point
+  kShortest,    ///< shortest text that reads back to the same value
+};
+
+/**
+ * @brief Write @p value into [first, last)
+ *
+ * @param precision As set by std::setprecision; ignored by kShortest, and a
+ * negative value means 6 as for streams
+ * @return char* One past the last character written, or nullptr if the
+ * buffer is too small (no terminating '\0' is written)
+ */
+template <typename T>
+char* format_float(char* first, char* last, T value, FloatStyle style,
+                   int precision = 6) {
+  static_assert(std::is_floating_point_v<T>, "format_float formats float, double, long double");
+  if (precision < 0)
+    precision = 6;
+  std::to_chars_result result{};
+  switch (style) {
+    case FloatStyle::kGeneral:
+      result = std::to_chars(first, last, value, std::chars_format::general, precision);
+      break;
+    case FloatStyle::kFixed:
+      result = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+      break;
+    case FloatStyle::kScientific:
+      result = std::to_chars(first, last, value, std::chars_format::scientific, precision);
+      break;
+    case FloatStyle::kShortest:
+      result = std::to_chars(first, last, value);
+      break;
+  }
+  return result.ec == std::errc{} ? result.ptr : nullptr;
+}
+
+/**
+ * @brief Write @p value as `stream << value` would, ignoring the width
+ *
+ * Honors floatfield, precision, uppercase and showpos. The rarely used
+ * showpoint and hexfloat fall back to snprintf, which is what the stream
+ * itself calls, so the output stays identical.
+ */
+template <typename T>
+char* format_float(char* first, char* last, T value, const std::ios_base& stream) {
+  const std::ios_base::fmtflags flags{stream.flags()};
+  const std::ios_base::fmtflags floatfield{flags & std::ios_base::floatfield};
+  const bool hexfloat{floatfield == (std::ios_base::fixed | std::ios_base::scientific)};
+  const int precision{static_cast<int>(stream.precision())};
+
+  if (hexfloat || (flags & std::ios_base::showpoint)) {
+    char format[16];
+    char* f{format};
+    *f++ = '%';
+    if (flags & std::ios_base::showpos)
+      *f++ = '+';
+    if (flags & std::ios_base::showpoint)
+      *f++ = '#';
+    if (!hexfloat) {
+      *f++ = '.';
+      *f++ = '*';
+    }
+    if constexpr (std::is_same_v<T, long double>)
+      *f++ = 'L';
+    const bool upper{(flags & std::ios_base::uppercase) != 0};
+    *f++ = hexfloat ? (upper ? 'A' : 'a')
+           : floatfield == std::ios_base::fixed      ? (upper ? 'F' : 'f')
+           : floatfield == std::ios_base::scientific ? (upper ? 'E' : 'e')
+                                                     : (upper ? 'G' : 'g');
+    *f = '\0';
+    const auto size{static_cast<std::size_t>(last - first)};
+    const int count{hexfloat ? std::snprintf(first, size, format, value)
+                             : std::snprintf(first, size, format, precision < 0 ? 6 : precision, value)};
+    return count >= 0 && static_cast<std::size_t>(count) < size ? first + count : nullptr;
+  }
+
+  char* out{first};
+  if ((flags & std::ios_base::showpos) && !std::signbit(value)) {
+    if (out == last)
+      return nullptr;
+    *out++ = '+';
+  }
+  const FloatStyle style{floatfield == std::ios_base::fixed        ? FloatStyle::kFixed
+                         : floatfield == std::ios_base::scientific ? FloatStyle::kScientific
+                                                                   : FloatStyle::kGeneral};
+  char* end{format_float(out, last, value, style, precision)};
+  if (end && (flags & std::ios_base::uppercase)) {
+    for (char* c{out}; c != end; ++c)
+      *c = static_cast<char>(std::toupper(static_cast<unsigned char>(*c)));
+  }
+  return end;
+}
+
+}  // namespace week2
@@ -0,0 +1,305 @@
+/**
+ * @file power.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Typed integer powers and polynomials, of one value or of arrays
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * SQUARE(x) of snippet 18 is text substitution: SQUARE(i++) increments i
+ * twice and the result has whatever type the expression happens to have.
+ * ipow<N>(x) is a function template instead: x is evaluated once, the
+ * result has the type of x, and the multiplications are picked at compile
+ * time by exponentiation by squaring (x^8 is three multiplications).
+ *
+ * @code
+ * double area{week2::square(radius) * week2::kPi};
+ * double x7{week2::ipow<7>(x)};  // 4 multiplications
+ *
+ * inline constexpr std::array<double, 4> kCubic{1.0, -0.5, 0.25, 2.0};
+ * double y{week2::poly<kCubic>(x)};  // 1 - 0.5 x + 0.25 x^2 + 2 x^3
+ *
+ * week2::ipow_batch<7>(in.data(), out.data(), in.size());
+ * week2::poly_batch<kCubic>(in.data(), out.data(), in.size());
+ * @endcode
+ *
+ * Floating-point template arguments only arrive in C++20, so poly<> takes
+ * its coefficients as a reference to a constexpr array with static storage
+ * duration, lowest degree first.
+ *
+ * The batch versions evaluate whole arrays with AVX2 or AVX-512 (see
+ * simd_dispatch.hpp). ipow_batch<N>() does the same multiplications in the
+ * same order as ipow<N>(), so its results are identical. poly_batch<>()
+ * uses FMA, which rounds once per Horner step instead of twice, so it can
+ * differ from poly<>() in the last bit (and is slightly more accurate).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "simd_dispatch.hpp"
+
+namespace week2 {
+
+/**
+ * @brief x^N by exponentiation by squaring, unrolled at compile time
+ */
+template <unsigned N, typename T>
+constexpr T ipow(T x) {
+  static_assert(std::is_arithmetic_v<T>, "ipow raises numbers");
+  if constexpr (N == 0) {
+    return T{1};
+  } else if constexpr (N == 1) {
+    return x;
+  } else if constexpr (N % 2 == 0) {
+    const T half{ipow<N / 2>(x)};
+    return static_cast<T>(half * half);
+  } else {
+    return static_cast<T>(x * ipow<N - 1>(x));
+  }
+}
+
+/**
+ * @brief x * x, the typed replacement of SQUARE(x)
+ */
+template <typename T>
+constexpr T square(T x) {
+  return ipow<2>(x);
+}
+
+/**
+ * @brief Coefficients[0] + Coefficients[1] x + ... with Horner's rule
+ *
+ * One multiply-add per coefficient, each waiting for the previous one.
+ */
+template <const auto& Coefficients, typename T>
+constexpr T poly(T x) {
+  constexpr std::size_t kCount{std::size(Coefficients)};
+  if constexpr (kCount == 0) {
+    return T{0};
+  } else {
+    T result{static_cast<T>(Coefficients[kCount - 1])};
+    for (std::size_t i{kCount - 1}; i > 0; --i)
+      result = result * x + static_cast<T>(Coefficients[i - 1]);
+    return result;
+  }
+}
+
+namespace detail {
+
+template <typename T, std::size_t K>
+constexpr T estrin(const std::array<T, K>& coefficients, T x) {
+  if constexpr (K == 0) {
+    return T{0};
+  } else if constexpr (K == 1) {
+    return coefficients[0];
+  } else {
+    std::array<T, (K + 1) / 2> pairs{};
+    for (std::size_t i{0}; i < K / 2; ++i)
+      pairs[i] = coefficients[2 * i] + coefficients[2 * i + 1] * x;
+    if constexpr (K % 2 == 1)
+      pairs[K / 2] = coefficients[K - 1];
+    return estrin(pairs, x * x);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief The same polynomial as poly<>() with Estrin's scheme
+ *
+ * Pairs of terms are combined with x, then pairs of pairs with x^2, and so
+ * on: a few more multiplications than Horner's rule, but independent ones,
+ * so a degree-d polynomial takes about log2(d) dependent steps instead of
+ * d. Rounds differently from poly<>().
+ */
+template <const auto& Coefficients, typename T>
+constexpr T poly_estrin(T x) {
+  constexpr std::size_t kCount{std::size(Coefficients)};
+  std::array<T, kCount> coefficients{};
+  for (std::size_t i{0}; i < kCount; ++i)
+    coefficients[i] = static_cast<T>(Coefficients[i]);
+  return detail::estrin(coefficients, x);
+}
+
+namespace detail {
+
+template <unsigned N>
+void ipow_scalar(const double* in, double* out, std::size_t size) {
+  for (std::size_t i{0}; i < size; ++i)
+    out[i] = ipow<N>(in[i]);
+}
+
+template <const auto& Coefficients>
+void poly_scalar(const double* in, double* out, std::size_t size) {
+  for (std::size_t i{0}; i < size; ++i)
+    out[i] = poly<Coefficients>(in[i]);
+}
+
+#ifdef ENPM702_X86
+
+// ipow<N>() and poly<>() on 4 doubles
+
+template <unsigned N>
+__attribute__((target("avx2,fma"))) inline __m256d ipow_avx2(__m256d x) {
+  if constexpr (N == 0) {
+    return _mm256_set1_pd(1.0);
+  } else if constexpr (N == 1) {
+    return x;
+  } else if constexpr (N % 2 == 0) {
+    const __m256d half{ipow_avx2<N / 2>(x)};
+    return _mm256_mul_pd(half, half);
+  } else {
+    return _mm256_mul_pd(x, ipow_avx2<N - 1>(x));
+  }
+}
+
+template <const auto& Coefficients>
+__attribute__((target("avx2,fma"))) inline __m256d poly_avx2(__m256d x) {
+  constexpr std::size_t kCount{std::size(Coefficients)};
+  if constexpr (kCount == 0) {
+    return _mm256_setzero_pd();
+  } else {
+    __m256d result{_mm256_set1_pd(Coefficients[kCount - 1])};
+    for (std::size_t i{kCount - 1}; i > 0; --i)
+      result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(Coefficients[i - 1]));
+    return result;
+  }
+}
+
+// Applies kernel to in[0, size) four values at a time; the last 1 to 3
+// values are loaded and stored under a mask. The kernel is a template
+// argument so that it is inlined.
+template <__m256d (*kernel)(__m256d)>
+__attribute__((target("avx2,fma"))) inline void map_avx2(const double* in, double* out, std::size_t size) {
+  std::size_t i{0};
+  for (; i + 8 <= size; i += 8) {
+    const __m256d a{kernel(_mm256_loadu_pd(in + i))};
+    const __m256d b{kernel(_mm256_loadu_pd(in + i + 4))};
+    _mm256_storeu_pd(out + i, a);
+    _mm256_storeu_pd(out + i + 4, b);
+  }
+  for (; i + 4 <= size; i += 4)
+    _mm256_storeu_pd(out + i, kernel(_mm256_loadu_pd(in + i)));
+  if (i < size) {
+    const __m256i mask{_mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(size - i)),
+                                          _mm256_setr_epi64x(0, 1, 2, 3))};
+    _mm256_maskstore_pd(out + i, mask, kernel(_mm256_maskload_pd(in + i, mask)));
+  }
+}
+
+template <unsigned N>
+__attribute__((target("avx2,fma"))) void ipow_batch_avx2(const double* in, double* out, std::size_t size) {
+  map_avx2<ipow_avx2<N>>(in, out, size);
+}
+
+template <const auto& Coefficients>
+__attribute__((target("avx2,fma"))) void poly_batch_avx2(const double* in, double* out, std::size_t size) {
+  map_avx2<poly_avx2<Coefficients>>(in, out, size);
+}
+
+// The same on 8 doubles
+
+template <unsigned N>
+__attribute__((target("avx512f"))) inline __m512d ipow_avx512(__m512d x) {
+  if constexpr (N == 0) {
+    return _mm512_set1_pd(1.0);
+  } else if constexpr (N == 1) {
+    return x;
+  } else if constexpr (N % 2 == 0) {
+    const __m512d half{ipow_avx512<N / 2>(x)};
+    return _mm512_mul_pd(half, half);
+  } else {
+    return _mm512_mul_pd(x, ipow_avx512<N - 1>(x));
+  }
+}
+
+template <const auto& Coefficients>
+__attribute__((target("avx512f"))) inline __m512d poly_avx512(__m512d x) {
+  constexpr std::size_t kCount{std::size(Coefficients)};
+  if constexpr (kCount == 0) {
+    return _mm512_setzero_pd();
+  } else {
+    __m512d result{_mm512_set1_pd(Coefficients[kCount - 1])};
+    for (std::size_t i{kCount - 1}; i > 0; --i)
+      result = _mm512_fmadd_pd(result, x, _mm512_set1_pd(Coefficients[i - 1]));
+    return result;
+  }
+}
+
+template <__m512d (*kernel)(__m512d)>
+__attribute__((target("avx512f"))) inline void map_avx512(const double* in, double* out, std::size_t size) {
+  std::size_t i{0};
+  for (; i + 16 <= size; i += 16) {
+    const __m512d a{kernel(_mm512_loadu_pd(in + i))};
+    const __m512d b{kernel(_mm512_loadu_pd(in + i + 8))};
+    _mm512_storeu_pd(out + i, a);
+    _mm512_storeu_pd(out + i + 8, b);
+  }
+  for (; i < size; i += 8) {
+    const auto mask{static_cast<__mmask8>(size - i >= 8 ? 0xFFu : (1u << (size - i)) - 1)};
+    _mm512_mask_storeu_pd(out + i, mask, kernel(_mm512_maskz_loadu_pd(mask, in + i)));
+  }
+}
+
+template <unsigned N>
+__attribute__((target("avx512f"))) void ipow_batch_avx512(const double* in, double* out, std::size_t size) {
+  map_avx512<ipow_avx512<N>>(in, out, size);
+}
+
+template <const auto& Coefficients>
+__attribute__((target("avx512f"))) void poly_batch_avx512(const double* in, double* out, std::size_t size) {
+  map_avx512<poly_avx512<Coefficients>>(in, out, size);
+}
+
+#endif  // ENPM702_X86
+
+}  // namespace detail
+
+/**
+ * @brief out[i] = ipow<N>(in[i]) for i in [0, size); @p out may be @p in
+ */
+template <unsigned N>
+void ipow_batch(const double* in, double* out, std::size_t size, enpm702::SimdLevel simd = enpm702::SimdLevel::kAuto) {
+  switch (enpm702::resolve(simd)) {
+#ifdef ENPM702_X86
+    case enpm702::SimdLevel::kAvx512:
+      detail::ipow_batch_avx512<N>(in, out, size);
+      return;
+    case enpm702::SimdLevel::kAvx2:
+      detail::ipow_batch_avx2<N>(in, out, size);
+      return;
+#endif
+    default:
+      detail::ipow_scalar<N>(in, out, size);
+      return;
+  }
+}
+
+/**
+ * @brief out[i] = poly<Coefficients>(in[i]) for i in [0, size), with FMA
+ * when vectorized; @p out may be @p in
+ */
+template <const auto& Coefficients>
+void poly_batch(const double* in, double* out, std::size_t size, enpm702::SimdLevel simd = enpm702::SimdLevel::kAuto) {
+  switch (enpm702::resolve(simd)) {
+#ifdef ENPM702_X86
+    case enpm702::SimdLevel::kAvx512:
+      detail::poly_batch_avx512<Coefficients>(in, out, size);
+      return;
+    case enpm702::SimdLevel::kAvx2:
+      detail::poly_batch_avx2<Coefficients>(in, out, size);
+      return;
+#endif
+    default:
+      detail::poly_scalar<Coefficients>(in, out, size);
+      return;
+  }
+}
+
+}  // namespace week2
@@ -1,386 +1,581 @@
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
 #include <typeinfo>  // needed for typeid
+#include <vector>
+
+#include "constexpr_tables.hpp"
+#include "convert.hpp"
+#include "float_format.hpp"
+#include "power.hpp"
+#include "snippets.hpp"
 #define SQUARE(x) ((x) * (x))
 #define PI 3.14159
 
-int main() {
-  //==============
-  //======== 1
-  //==============
-  //   std::cout << "hello, world\n";
-
-  //==============
-  //======== 2
-  //==============
-  //   int break1;   // OK
-  //   int break_1;  // OK
-  //   int Break1;   // OK
-  //   int BREAK;    // OK
-  //   int _break1;  // OK
-  //   int 1Break;   // Error: expected unqualified-id before numeric constant
-
-  //==============
-  //======== 3
-  //==============
-  //   int number = 20;
-  // //   std::cout << sizeof(number) << '\n'; // 4 bytes on my machine
-  // //   std::cout << sizeof(int) << '\n';    // 4 bytes on my machine
-  //   std::cout << &number << '\n'; //
-
-  //==============
-  //======== 4
-  //==============
-  //     int number;                  // declaration
-  //     number = 1;                  // assignment
-  //     std::cout << number << '\n'; // 1
-  //     number = 2;                  // assignment
-  //     std::cout << number << '\n'; // 2
-
-  //==============
-  //======== 5
-  //==============
-  // int a{};                                                      //
-  // initialized to 0 std::cout << a << '\n'; // 0 double b{}; // initialized to
-  // 0.0 std::cout << b << '\n';                                       // 0
-  // std::cout << std::fixed << std::setprecision(1) << b << '\n'; // 0.0
-
-  //==============
-  //======== 6
-  //==============
-  // int a{};   // the value of a will be replaced later
-  // int b{0};  // we plan to use the value of b
-  // a = b + 3; // value of b is used and a is assigned a new value
-
-  //==============
-  //======== 7
-  //==============
-  //   int number;                  // uninitialized
-  //   std::cout << number << '\n'; // garbage
-
-  //==============
-  //======== 8
-  //==============
-  // std::cout << "Type\t\tSize (bytes)\tMin Value\t\tMax Value\n";
-  // std::cout <<
-  // "--------------------------------------------------------------------\n";
-
-  // std::cout << "char\t\t" << sizeof(char)
-  //           << "\t\t" << int(std::numeric_limits<char>::min())
-  //           << "\t\t\t" << int(std::numeric_limits<char>::max()) << '\n';
-
-  // std::cout << "unsigned char\t" << sizeof(unsigned char)
-  //           << "\t\t" << int(std::numeric_limits<unsigned char>::min())
-  //           << "\t\t\t" << int(std::numeric_limits<unsigned char>::max()) <<
-  //           '\n';
-
-  // std::cout << "int\t\t" << sizeof(int)
-  //           << "\t\t" << std::numeric_limits<int>::min()
-  //           << "\t\t" << std::numeric_limits<int>::max() << '\n';
-
-  // std::cout << "unsigned int\t" << sizeof(unsigned int)
-  //           << "\t\t" << std::numeric_limits<unsigned int>::min()
-  //           << "\t\t\t" << std::numeric_limits<unsigned int>::max() << '\n';
-
-  // std::cout << "short\t\t" << sizeof(short)
-  //           << "\t\t" << std::numeric_limits<short>::min()
-  //           << "\t\t\t" << std::numeric_limits<short>::max() << '\n';
-
-  // std::cout << "unsigned short\t" << sizeof(unsigned short)
-  //           << "\t\t" << std::numeric_limits<unsigned short>::min()
-  //           << "\t\t\t" << std::numeric_limits<unsigned short>::max() <<
-  //           '\n';
-
-  // std::cout << "long\t\t" << sizeof(long)
-  //           << "\t\t" << std::numeric_limits<long>::min()
-  //           << "\t" << std::numeric_limits<long>::max() << '\n';
-
-  // std::cout << "unsigned long\t" << sizeof(unsigned long)
-  //           << "\t\t" << std::numeric_limits<unsigned long>::min()
-  //           << "\t\t\t" << std::numeric_limits<unsigned long>::max() << '\n';
-
-  // std::cout << "long long\t" << sizeof(long long)
-  //           << "\t\t" << std::numeric_limits<long long>::min()
-  //           << "\t" << std::numeric_limits<long long>::max() << '\n';
-
-  // std::cout << "ull\t\t" << sizeof(unsigned long long)
-  //           << "\t\t" << std::numeric_limits<unsigned long long>::min()
-  //           << "\t\t\t" << std::numeric_limits<unsigned long long>::max() <<
-  //           '\n';
-
-  //</> 8-1
-  //=====================
-  // std::cout << std::fixed << std::scientific << std::setprecision(10);
-  // // std::scientific -- Display the result in scientific notation
-  // // std::fixed and std::precision -- By combining std::fixed with
-  // std::setprecision,
-  // // you can control the number of decimal places that are shown.
-  // // For example, std::setprecision(2) with std::fixed will display the
-  // number with
-  // // exactly two digits after the decimal point.
-  // std::cout << "Type\t\tSize (bytes)\tMin Value\t\t\tLowest Value\t\t\tMax
-  // Value\n"; std::cout <<
-  // "--------------------------------------------------------------------------------------------------------\n";
-
-  // std::cout << "float\t\t" << sizeof(float)
-  //           << "\t\t" << std::numeric_limits<float>::min()
-  //           << "\t\t" << std::numeric_limits<float>::lowest()
-  //           << "\t\t" << std::numeric_limits<float>::max() << '\n';
-
-  // std::cout << "\ndouble\t\t" << sizeof(double)
-  //           << "\t\t" << std::numeric_limits<double>::min()
-  //           << "\t\t" << std::numeric_limits<double>::lowest()
-  //           << "\t\t" << std::numeric_limits<double>::max() << '\n';
-
-  // std::cout << "\nlong double\t" << sizeof(long double)
-  //           << "\t\t" << std::numeric_limits<long double>::min()
-  //           << "\t\t" << std::numeric_limits<long double>::lowest()
-  //           << "\t\t" << std::numeric_limits<long double>::max() << '\n';
-
-  //==============
-  //======== 9-1
-  //==============
-  //   std::cout << 1.05 << '\n';  // this is a double
-  //   std::cout << 1.05f << '\n'; // this is a float
-  //   std::cout << 1f << '\n';    // error
-  //   std::cout << 1.0f << '\n';  // OK
-  // u_int8_t var;
-
-  //==============
-  //======== 9-2
-  //==============
-  // std::cout << std::setprecision(9);             // show 9 digits of
-  // precision std::cout << 0.33333333333f << '\n';           // 0.333333343
-  // std::cout << std::setprecision(15) << '\n';    // show 15 digits of
-  // precision std::cout << 8.3642343534322323232322 << '\n';
-  // // 8.36423435343223 (15 digits)
-
-  //==============
-  //======== 10-1
-  //==============
-  // bool is_today_sunny{true};
-  // bool is_today_cloudy{false};
-  // std::cout << is_today_sunny << '\n';  // 1
-  // std::cout << is_today_cloudy << '\n'; // 0
-
-  //==============
-  //======== 10-2
-  //==============
-  // bool is_today_sunny{true};
-  // bool is_today_cloudy{false};
-  // std::cout << std::boolalpha << is_today_sunny << '\n';  // true
-  // std::cout << std::boolalpha << true << '\n';            // true
-  // std::cout << std::noboolalpha << true << '\n';          // 1
-  // std::cout << std::boolalpha << is_today_cloudy << '\n'; // false
-  // std::cout << std::boolalpha << false << '\n';           // false
-  // std::cout << std::noboolalpha << false << '\n';         // 0
-
-  //==============
-  //======== 11
-  //==============
+// Run a snippet with `week2_cpp --run <id>` (see `week2_cpp --list`).
+// Snippets that do not compile on purpose stay commented out.
+using enpm702::kSnippetInteractive;
+using enpm702::kSnippetUndefined;
+
+//==============
+//======== 1
+//==============
+SNIPPET("1") {
+  std::cout << "hello, world\n";
+}
+
+//==============
+//======== 2
+//==============
+//   int break1;   // OK
+//   int break_1;  // OK
+//   int Break1;   // OK
+//   int BREAK;    // OK
+//   int _break1;  // OK
+//   int 1Break;   // Error: expected unqualified-id before numeric constant
+
+//==============
+//======== 3
+//==============
+SNIPPET("3") {
+  int number = 20;
+  //   std::cout << sizeof(number) << '\n'; // 4 bytes on my machine
+  //   std::cout << sizeof(int) << '\n';    // 4 bytes on my machine
+  std::cout << &number << '\n';  //
+}
+
+//==============
+//======== 4
+//==============
+SNIPPET("4") {
+  int number;                   // declaration
+  number = 1;                   // assignment
+  std::cout << number << '\n';  // 1
+  number = 2;                   // assignment
+  std::cout << number << '\n';  // 2
+}
+
+//==============
+//======== 5
+//==============
+SNIPPET("5") {
+  int a{};                                                       // initialized to 0
+  std::cout << a << '\n';                                        // 0
+  double b{};                                                    // initialized to 0.0
+  std::cout << b << '\n';                                        // 0
+  std::cout << std::fixed << std::setprecision(1) << b << '\n';  // 0.0
+}
+
+//==============
+//======== 6
+//==============
+SNIPPET("6") {
+  [[maybe_unused]] int a{};  // the value of a will be replaced later
+  int b{0};   // we plan to use the value of b
+  a = b + 3;  // value of b is used and a is assigned a new value
+}
+
+//==============
+//======== 7
+//==============
+// reads an uninitialized int on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+SNIPPET("7", kSnippetUndefined) {
+  int number;                   // uninitialized
+  std::cout << number << '\n';  // garbage
+}
+#pragma GCC diagnostic pop
+
+//==============
+//======== 8
+//==============
+SNIPPET("8") {
+  std::cout << "Type\t\tSize (bytes)\tMin Value\t\tMax Value\n";
+  std::cout << "--------------------------------------------------------------------\n";
+
+  std::cout << "char\t\t" << sizeof(char)
+            << "\t\t" << int(std::numeric_limits<char>::min())
+            << "\t\t\t" << int(std::numeric_limits<char>::max()) << '\n';
+
+  std::cout << "unsigned char\t" << sizeof(unsigned char)
+            << "\t\t" << int(std::numeric_limits<unsigned char>::min())
+            << "\t\t\t" << int(std::numeric_limits<unsigned char>::max()) << '\n';
+
+  std::cout << "int\t\t" << sizeof(int)
+            << "\t\t" << std::numeric_limits<int>::min()
+            << "\t\t" << std::numeric_limits<int>::max() << '\n';
+
+  std::cout << "unsigned int\t" << sizeof(unsigned int)
+            << "\t\t" << std::numeric_limits<unsigned int>::min()
+            << "\t\t\t" << std::numeric_limits<unsigned int>::max() << '\n';
+
+  std::cout << "short\t\t" << sizeof(short)
+            << "\t\t" << std::numeric_limits<short>::min()
+            << "\t\t\t" << std::numeric_limits<short>::max() << '\n';
+
+  std::cout << "unsigned short\t" << sizeof(unsigned short)
+            << "\t\t" << std::numeric_limits<unsigned short>::min()
+            << "\t\t\t" << std::numeric_limits<unsigned short>::max() << '\n';
+
+  std::cout << "long\t\t" << sizeof(long)
+            << "\t\t" << std::numeric_limits<long>::min()
+            << "\t" << std::numeric_limits<long>::max() << '\n';
+
+  std::cout << "unsigned long\t" << sizeof(unsigned long)
+            << "\t\t" << std::numeric_limits<unsigned long>::min()
+            << "\t\t\t" << std::numeric_limits<unsigned long>::max() << '\n';
+
+  std::cout << "long long\t" << sizeof(long long)
+            << "\t\t" << std::numeric_limits<long long>::min()
+            << "\t" << std::numeric_limits<long long>::max() << '\n';
+
+  std::cout << "ull\t\t" << sizeof(unsigned long long)
+            << "\t\t" << std::numeric_limits<unsigned long long>::min()
+            << "\t\t\t" << std::numeric_limits<unsigned long long>::max() << '\n';
+}
+
+//</> 8-1
+//=====================
+SNIPPET("8-1") {
+  std::cout << std::fixed << std::scientific << std::setprecision(10);
+  // std::scientific -- Display the result in scientific notation
+  // std::fixed and std::precision -- By combining std::fixed with
+  // std::setprecision, you can control the number of decimal places that
+  // are shown. For example, std::setprecision(2) with std::fixed will display
+  // the number with exactly two digits after the decimal point.
+  std::cout << "Type\t\tSize (bytes)\tMin Value\t\t\tLowest Value\t\t\tMax Value\n";
+  std::cout << "--------------------------------------------------------------------------------------------------------\n";
+
+  std::cout << "float\t\t" << sizeof(float)
+            << "\t\t" << std::numeric_limits<float>::min()
+            << "\t\t" << std::numeric_limits<float>::lowest()
+            << "\t\t" << std::numeric_limits<float>::max() << '\n';
+
+  std::cout << "\ndouble\t\t" << sizeof(double)
+            << "\t\t" << std::numeric_limits<double>::min()
+            << "\t\t" << std::numeric_limits<double>::lowest()
+            << "\t\t" << std::numeric_limits<double>::max() << '\n';
+
+  std::cout << "\nlong double\t" << sizeof(long double)
+            << "\t\t" << std::numeric_limits<long double>::min()
+            << "\t\t" << std::numeric_limits<long double>::lowest()
+            << "\t\t" << std::numeric_limits<long double>::max() << '\n';
+}
+
+//==============
+//======== 9-1
+//==============
+//   std::cout << 1.05 << '\n';  // this is a double
+//   std::cout << 1.05f << '\n'; // this is a float
+//   std::cout << 1f << '\n';    // error
+//   std::cout << 1.0f << '\n';  // OK
+// u_int8_t var;
+
+//==============
+//======== 9-2
+//==============
+SNIPPET("9-2") {
+  std::cout << std::setprecision(9);              // show 9 digits of precision
+  std::cout << 0.33333333333f << '\n';            // 0.333333343
+  std::cout << std::setprecision(15) << '\n';     // show 15 digits of precision
+  std::cout << 8.3642343534322323232322 << '\n';  // 8.36423435343223 (15 digits)
+}
+
+//=====================
+// Snippets 8-1 and 9-2 through week2::format_float() (see float_format.hpp),
+// checked against what the stream itself prints
+namespace {
+
+// Formats value with the flags and precision of stream, both ways; returns
+// true when the two texts are the same
+template <typename T>
+bool same_as_stream(std::ostringstream& stream, T value, bool show) {
+  stream.str("");
+  stream << value;
+  char buffer[128];
+  char* end{week2::format_float(buffer, buffer + sizeof(buffer), value, stream)};
+  const std::string formatted{buffer, end ? end : buffer};
+  if (show)
+    std::cout << std::setw(24) << stream.str() << "  " << formatted << '\n';
+  return end && formatted == stream.str();
+}
+
+template <typename T>
+std::size_t count_mismatches(std::ostringstream& stream, const std::vector<T>& values) {
+  std::size_t mismatches{0};
+  for (T value : values) {
+    if (!same_as_stream(stream, value, false))
+      ++mismatches;
+  }
+  return mismatches;
+}
+
+}  // namespace
+
+SNIPPET("9-2-format") {
+  std::ostringstream general_9;
+  general_9 << std::setprecision(9);
+  std::ostringstream general_15;
+  general_15 << std::setprecision(15);
+  std::ostringstream scientific_10;
+  scientific_10 << std::fixed << std::scientific << std::setprecision(10);
+
+  std::cout << "ostream, then format_float:\n";
+  same_as_stream(general_9, 0.33333333333f, true);
+  same_as_stream(general_15, 8.3642343534322323232322, true);
+  same_as_stream(scientific_10, std::numeric_limits<float>::min(), true);
+  same_as_stream(scientific_10, std::numeric_limits<double>::lowest(), true);
+  same_as_stream(scientific_10, std::numeric_limits<long double>::max(), true);
+
+  // random magnitudes over most of the exponent range, both signs, plus
+  // zeros, infinities, NaN and the limits
+  std::mt19937_64 generator{8};
+  std::lognormal_distribution<double> distribution{0.0, 60.0};
+  std::vector<double> doubles{0.0, -0.0, std::numeric_limits<double>::infinity(),
+                              -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+                              std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min(),
+                              std::numeric_limits<double>::max(), 0.5, 1.05, 9.5, 99.5, 1e15, 1e16};
+  for (int i{0}; i < 100000; ++i)
+    doubles.push_back(i % 2 ? distribution(generator) : -distribution(generator));
+  // floats from a narrower spread, or most would overflow or underflow
+  std::lognormal_distribution<float> float_distribution{0.0f, 15.0f};
+  std::vector<float> floats;
+  std::vector<long double> long_doubles;
+  for (std::size_t i{0}; i < doubles.size(); ++i) {
+    floats.push_back(i % 2 ? float_distribution(generator) : -float_distribution(generator));
+    long_doubles.push_back(static_cast<long double>(doubles[i]) * 1.000000000000000001L);
+  }
+
+  std::size_t mismatches{0};
+  for (std::ostringstream* stream : {&general_9, &general_15, &scientific_10})
+    mismatches += count_mismatches(*stream, floats) + count_mismatches(*stream, doubles) +
+                  count_mismatches(*stream, long_doubles);
+  std::cout << "Mismatches in " << 3 * 3 * doubles.size() << " values: " << mismatches << '\n';  // 0
+}
+
+//==============
+//======== 10-1
+//==============
+SNIPPET("10-1") {
+  bool is_today_sunny{true};
+  bool is_today_cloudy{false};
+  std::cout << is_today_sunny << '\n';   // 1
+  std::cout << is_today_cloudy << '\n';  // 0
+}
+
+//==============
+//======== 10-2
+//==============
+SNIPPET("10-2") {
+  bool is_today_sunny{true};
+  bool is_today_cloudy{false};
+  std::cout << std::boolalpha << is_today_sunny << '\n';   // true
+  std::cout << std::boolalpha << true << '\n';             // true
+  std::cout << std::noboolalpha << true << '\n';           // 1
+  std::cout << std::boolalpha << is_today_cloudy << '\n';  // false
+  std::cout << std::boolalpha << false << '\n';            // false
+  std::cout << std::noboolalpha << false << '\n';          // 0
+}
+
+//==============
+//======== 11
+//==============
+SNIPPET("11") {
   double num1 = 1.5;
   int num2 = num1;                                  // 1.5 converted to 1
   std::cout << "Value of num1 : " << num1 << '\n';  // 1.5
   std::cout << "Type of num1 : " << typeid(num1).name() << '\n';  // double
   std::cout << "Value of num2 : " << num2 << '\n';
+}
+
+//==============
+//======== 12-1
+//==============
+SNIPPET("12-1") {
+  [[maybe_unused]] double num1{5.0};   // no promotion necessary
+  [[maybe_unused]] double num2{4.0f};  // float promoted to double
+}
+
+//==============
+//======== 12-2
+//==============
+SNIPPET("12-2") {
+  short s = 1;
+  int num1 = s;                    // short promoted to int
+  int num2 = 'a';                  // char promoted to int
+  int num3 = true;                 // bool promoted to int
+  std::cout << num1 << '\n';       // 1
+  std::cout << num2 << '\n';       // 97
+  std::cout << num3 << '\n';       // 1
+  std::cout << sizeof(s) << '\n';  // 2
+}
+
+//==============
+//======== 13
+//==============
+SNIPPET("13") {
+  int b = static_cast<int> (3.2);
+  std::cout << b << '\n';
+  int c(static_cast<int> (1.3));
+  std::cout << c << '\n';
+  int d{static_cast<int> (3.5)};
+  std::cout << d << '\n';
+}
+
+//=====================
+// The same with to_int() (see convert.hpp): a choice of rounding, and a
+// defined result for values that do not fit, where static_cast is
+// undefined behavior
+SNIPPET("13-convert") {
+  const std::vector<double> values{3.2, 1.3, 3.5, -2.5, 300.0, 1e10, std::numeric_limits<double>::quiet_NaN()};
+  std::vector<std::int8_t> truncated(values.size());
+  std::vector<std::int8_t> rounded(values.size());
+  std::vector<std::int32_t> saturated(values.size());
+  week2::to_int(values.data(), truncated.data(), values.size(),
+                {week2::Rounding::kTruncate, week2::Overflow::kSaturate});
+  week2::to_int(values.data(), rounded.data(), values.size(),
+                {week2::Rounding::kNearestEven, week2::Overflow::kSaturate});
+  week2::to_int(values.data(), saturated.data(), values.size(),
+                {week2::Rounding::kNearestEven, week2::Overflow::kSaturate});
+  // int8 truncated, int8 rounded, int32 rounded (all three saturated), then
+  // int32 truncated with the default Overflow::kMinValue
+  for (std::size_t i{0}; i < values.size(); ++i)
+    std::cout << values[i] << ": " << int{truncated[i]} << ' ' << int{rounded[i]} << ' ' << saturated[i] << ' '
+              << week2::to_int<std::int32_t>(values[i]) << '\n';
+}
+
+//==============
+//======== 14
+//==============
+SNIPPET("14") {
+  int i{42};
+  double d{3.14};
+
+  std::cout << "Type of result: " << typeid(i + d).name() << '\n';  // double
+  std::cout << "Value of result: " << i + d << '\n';                // 45.14
+
+  unsigned int ui{100};
+  long l{5000};
+
+  std::cout << "Type of result: " << typeid(ui + l).name() << '\n';  // long
+  std::cout << "Value of result: " << ui + l << '\n';                // 5100
+
+  unsigned short us{10};
+  unsigned long ul{700000};
+
+  std::cout << "Type of result: " << typeid(us + ul).name() << '\n';  // unsigned long
+  std::cout << "Value of result: " << us + ul << '\n';                // 700010
+}
+
+//==============
+//======== 15
+//==============
+SNIPPET("15") {
+  short s1{100};
+  char c{50};
+  std::cout << "Type of result: " << typeid(s1 + c).name() << '\n'; // int
+  std::cout << "Value of result: " << s1 + c << '\n'; // 150
+
+  unsigned char uc{200};
+  bool b1{true};
+  std::cout << "Type of result: " << typeid(uc + b1).name() << '\n'; // int
+  std::cout << "Value of result: " << uc + b1 << '\n'; // 201
+
+  bool b2{false};
+  short s2{32767};
+  std::cout << "Type of result: " << typeid(b2 + s2).name() << '\n'; // int
+  std::cout << "Value of result: " << b2 + s2 << '\n'; // 32767
+}
+
+//==============
+//======== 16
+//==============
+// const double pi;
+
+//=====================
+// const double pi{3.141598};
+// pi = 3.14;
+
+//==============
+//======== 17
+//==============
+SNIPPET("17") {
+  std::cout << "pi: " << PI << '\n';  // preprocessor replaces PI with 3.14159
+}
+
+//==============
+//======== 18
+//==============
+SNIPPET("18") {
+  int a = 5;
+  double result = SQUARE(a);
+  std::cout << result << '\n';
 
-  //==============
-  //======== 12-1
-  //==============
-  // double num1{5.0};   // no promotion necessary
-  // double num2{4.0f};  // float promoted to double
-
-  //==============
-  //======== 12-2
-  //==============
-  // short s = 1;
-  // int num1 = s;                    // short promoted to int
-  // int num2 = 'a';                  // char promoted to int
-  // int num3 = true;                 // bool promoted to int
-  // std::cout << num1 << '\n';       // 1
-  // std::cout << num2 << '\n';       // 97
-  // std::cout << num3 << '\n';       // 1
-  // std::cout << sizeof(s) << '\n';  // 2
-
-  //==============
-  //======== 13
-  //==============
-  // int b = static_cast<int> (3.2);
-  // std::cout << b << '\n';
-  // int c(static_cast<int> (1.3));
-  // std::cout << c << '\n';
-  // int d{static_cast<int> (3.5)};
-  // std::cout << d << '\n';
-
-  //==============
-  //======== 14
-  //==============
-  // int i{42};
-  // double d{3.14};
-
-  // std::cout << "Type of result: " << typeid(i + d).name() << '\n';  // double
-  // std::cout << "Value of result: " << i + d << '\n';                // 45.14
-
-  // unsigned int ui{100};
-  // long l{5000};
-
-  // std::cout << "Type of result: " << typeid(ui + l).name() << '\n';  // long
-  // std::cout << "Value of result: " << ui + l << '\n';                // 5100
-
-  // unsigned short us{10};
-  // unsigned long ul{700000};
-
-  // std::cout << "Type of result: " << typeid(us + ul).name() << '\n';  //
-  // unsigned long std::cout << "Value of result: " << us + ul << '\n'; //
-  // 700010
-
-  //==============
-  //======== 15
-  //==============
-  // short s1{100};
-  // char c{50};
-  // std::cout << "Type of result: " << typeid(s1 + c).name() << '\n'; // int
-  // std::cout << "Value of result: " << s1 + c << '\n'; // 150
-
-  // unsigned char uc{200};
-  // bool b1{true};
-  // std::cout << "Type of result: " << typeid(uc + b1).name() << '\n'; // int
-  // std::cout << "Value of result: " << uc + b1 << '\n'; // 201
-
-  // bool b2{false};
-  // short s2{32767};
-  // std::cout << "Type of result: " << typeid(b2 + s2).name() << '\n'; // int
-  // std::cout << "Value of result: " << b2 + s2 << '\n'; // 32767
-
-  //==============
-  //======== 16
-  //==============
-  // const double pi;
-
-  //=====================
-  // const double pi{3.141598};
-  // pi = 3.14;
-
-  //==============
-  //======== 17
-  //==============
-  // std::cout << "pi: " << PI << '\n';  // preprocessor replaces PI
-  // with 3.14159
-
-  //==============
-  //======== 18
-  //==============
-  // int a = 5;
-  // double result = SQUARE(a);
-  // std::cout << result << '\n';
-
-  //=====================
-  // double area = PI * 10 * 10;
-  // std::cout << area << '\n';
-
-  //</> 19
-  //=====================
-  // const int a{1};              // a is a compile-time const
-  // const int b{2};              // b is a compile-time const
-  // std::cout << a + b << '\n';  // a + b is a compile-time expression
-
-  //=====================
-  // std::cout << "Enter an integer: ";
-  // int input{};
-  // std::cin >> input;
-  // const int a{1};              // a is a compile-time const
-  // const int b{input};          // b is a run-time const
-  // std::cout << a + b << '\n';  // a + b is a run-time expression
-
-  //</> 20
-  //=====================
-  // constexpr int a{1};  // OK: a is a compile-time const
-  // constexpr int b{2};  // OK: b is a compile-time const
-  // std::cout << "Enter an integer: ";
-  // int input{};
-  // std::cin >> input;
-  // constexpr int c{input};  // error
-
-  //</> 21
-  //=====================
-  // auto a{3.0};    // 3.0 is a double literal, so variable a will be type
-  // double std::cout << "Type of a: " << typeid(a).name() << '\n'; // double
-  // auto b{1 + 2};  // 1 + 2 evaluates to an int, so b will be type int
-  // std::cout << "Type of b: " << typeid(b).name() << '\n';  // int
-  // auto c{b};      // variable b is an int, so c will be type int
-  // std::cout << "Type of c: " << typeid(c).name() << '\n';  // int
-
-  //</> 22
-  //=====================
-  // const int a{5};  // a is const
-  // auto b{a};       // b is int (const is dropped)
-  // b = 1;           // OK
-
-  //=====================
-  // constexpr int a{5};   // a is const int
-  // constexpr auto b{a};  // b is const int
-  // b = 1;                // error: assignment of read-only variable 'b'
-
-  //</> 23
-  //=====================
-  // int a{};
-  // {  // start nested block 1
-  //     int b{};
-  //     {  // start nested block 2
-  //         int c{};
-  //     }  // end nested block 2
-  // }  // end nested block 1
-
-  //</> 24
-  //=====================
-  // int a{1};
-  // {
-  //     int b{2};
-  //     std::cout << a << '\n';  // 1
-  //     std::cout << b << '\n';  // 2
-  // }  // b goes out of scope here.
-  // // std::cout << b << '\n';  // error: b is out of scope
-  // int c{3};
-
-  //</> 25
-  //=====================
-  // std::cout << global_var << '\n';  // 1
-  // global_var++;                     // 2
-  // my_function();                    // 3
-  // std::cout << global_var << '\n';  // 3
-
-  //</> 26
-  //=====================
-  // std::cout << &global_x << '\n';
-  // std::cout << &global_y << '\n';
-
-  //</> 27
-  //=====================
-  // std::cout << MyNamespace::x << '\n';  // 3
-  // std::cout << MyNamespace::y << '\n';  // 4
-
-  //</> 28
-  //=====================
-  // std::cout << x << '\n';  // no need to use MyNamespace::x
-  // std::cout << y << '\n';  // no need to use MyNamespace::y
-
-  //</> 29
-  //=====================
-  // std::cout << x << '\n';  // no need to use MyNamespace::x
-  // std::cout << y << '\n';  // error: ‘y’ was not declared in this scope
-
-  //</> 30
-  //=====================
-  // cout << cout << '\n';
-
-  //</> 31
   //=====================
-  // Use the custom types
-  // Integer a{10};
-  // Float b{20.5f};
-  // uint age{30};
-
-  // std::cout << "Integer: " << a << '\n';
-  // std::cout << "Float: " << b << '\n';
-  // std::cout << "Age: " << age << '\n';
-}
\ No newline at end of file
+  double area = PI * 10 * 10;
+  std::cout << area << '\n';
+}
+
+//=====================
+// The same with functions (see power.hpp): typed, and the argument is
+// evaluated once
+constexpr std::array<double, 3> kQuadratic{1.0, 2.0, 1.0};  // 1 + 2x + x^2
+
+SNIPPET("18-ipow") {
+  int calls{0};
+  auto next = [&calls] { return ++calls; };
+  int with_macro = SQUARE(next());           // next() runs twice: 1 * 2
+  calls = 0;
+  int with_function{week2::square(next())};  // next() runs once: 1 * 1
+  std::cout << with_macro << ' ' << with_function << '\n';                  // 2 1
+  std::cout << week2::ipow<10>(2) << ' ' << week2::ipow<3>(1.5) << '\n';  // 1024 3.375
+  std::cout << week2::poly<kQuadratic>(PI) << ' ' << week2::square(PI + 1) << '\n';
+
+  std::vector<double> values{1.0, 2.0, 3.0, 4.0, 5.0};
+  week2::ipow_batch<3>(values.data(), values.data(), values.size());  // vectorized, in place
+  for (double value : values)
+    std::cout << value << ' ';  // 1 8 27 64 125
+  std::cout << '\n';
+}
+
+//</> 19
+//=====================
+SNIPPET("19-1") {
+  const int a{1};              // a is a compile-time const
+  const int b{2};              // b is a compile-time const
+  std::cout << a + b << '\n';  // a + b is a compile-time expression
+}
+
+//=====================
+SNIPPET("19-2", kSnippetInteractive) {
+  std::cout << "Enter an integer: ";
+  int input{};
+  std::cin >> input;
+  const int a{1};              // a is a compile-time const
+  const int b{input};          // b is a run-time const
+  std::cout << a + b << '\n';  // a + b is a run-time expression
+}
+
+//</> 20
+//=====================
+// constexpr int a{1};  // OK: a is a compile-time const
+// constexpr int b{2};  // OK: b is a compile-time const
+// std::cout << "Enter an integer: ";
+// int input{};
+// std::cin >> input;
+// constexpr int c{input};  // error
+
+//=====================
+// A whole table can be constexpr as well (see constexpr_tables.hpp)
+SNIPPET("20-tables") {
+  constexpr std::uint32_t crc{week2::crc32("hello, world")};  // computed by the compiler
+  static_assert(week2::crc32("123456789") == 0xCBF43926);     // checked by the compiler
+  constexpr std::int16_t sin45{week2::sin_q15(week2::kAngleSteps / 8)};  // an eighth of a turn
+  std::cout << std::hex << crc << std::dec << '\n';
+  std::cout << sin45 / 32767.0 << ' ' << week2::table_sin(PI / 4) << '\n';  // 0.707114 twice (Q15)
+  std::cout << week2::power<10>(6) << ' ' << week2::popcount(0xFF) << '\n';  // 1000000 8
+}
+
+//</> 21
+//=====================
+SNIPPET("21") {
+  auto a{3.0};    // 3.0 is a double literal, so variable a will be type double
+  std::cout << "Type of a: " << typeid(a).name() << '\n';  // double
+  auto b{1 + 2};  // 1 + 2 evaluates to an int, so b will be type int
+  std::cout << "Type of b: " << typeid(b).name() << '\n';  // int
+  auto c{b};      // variable b is an int, so c will be type int
+  std::cout << "Type of c: " << typeid(c).name() << '\n';  // int
+}
+
+//</> 22
+//=====================
+SNIPPET("22") {
+  const int a{5};  // a is const
+  [[maybe_unused]] auto b{a};  // b is int (const is dropped)
+  b = 1;           // OK
+}
+
+//=====================
+// constexpr int a{5};   // a is const int
+// constexpr auto b{a};  // b is const int
+// b = 1;                // error: assignment of read-only variable 'b'
+
+//</> 23
+//=====================
+SNIPPET("23") {
+  [[maybe_unused]] int a{};
+  {  // start nested block 1
+      [[maybe_unused]] int b{};
+      {  // start nested block 2
+          [[maybe_unused]] int c{};
+      }  // end nested block 2
+  }  // end nested block 1
+}
+
+//</> 24
+//=====================
+SNIPPET("24") {
+  int a{1};
+  {
+      int b{2};
+      std::cout << a << '\n';  // 1
+      std::cout << b << '\n';  // 2
+  }  // b goes out of scope here.
+  // std::cout << b << '\n';  // error: b is out of scope
+  [[maybe_unused]] int c{3};
+}
+
+// Snippets 25 to 29 use the declarations shown on the slides and 30 does not
+// compile on purpose, so they stay commented out.
+
+//</> 25
+//=====================
+// std::cout << global_var << '\n';  // 1
+// global_var++;                     // 2
+// my_function();                    // 3
+// std::cout << global_var << '\n';  // 3
+
+//</> 26
+//=====================
+// std::cout << &global_x << '\n';
+// std::cout << &global_y << '\n';
+
+//</> 27
+//=====================
+// std::cout << MyNamespace::x << '\n';  // 3
+// std::cout << MyNamespace::y << '\n';  // 4
+
+//</> 28
+//=====================
+// std::cout << x << '\n';  // no need to use MyNamespace::x
+// std::cout << y << '\n';  // no need to use MyNamespace::y
+
+//</> 29
+//=====================
+// std::cout << x << '\n';  // no need to use MyNamespace::x
+// std::cout << y << '\n';  // error: ‘y’ was not declared in this scope
+
+//</> 30
+//=====================
+// cout << cout << '\n';
+
+//</> 31
+//=====================
+// Use the custom types
+// Integer a{10};
+// Float b{20.5f};
+// uint age{30};
+
+// std::cout << "Integer: " << a << '\n';
+// std::cout << "Float: " << b << '\n';
+// std::cout << "Age: " << age << '\n';
+
+int main(int argc, char* argv[]) {
+  return enpm702::run_snippets(argc, argv, "11");
+}
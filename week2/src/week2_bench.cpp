@@ -0,0 +1,601 @@
+/**
+ * @file week2_bench.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Microbenchmarks for the lecture 2 snippets
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "constexpr_tables.hpp"
+#include "convert.hpp"
+#include "float_format.hpp"
+#include "power.hpp"
+#define SQUARE(x) ((x) * (x))
+#define PI 3.14159
+
+using enpm702::bench::do_not_optimize;
+
+constexpr double square(double x) { return x * x; }
+
+//======== 18: SQUARE(a) against a constexpr function and std::pow
+BENCHMARK("square/macro") {
+  int a{5};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(a);  // a is unknown to the compiler at each iteration
+    double result = SQUARE(a);
+    do_not_optimize(result);
+  }
+}
+
+BENCHMARK("square/constexpr_function") {
+  int a{5};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(a);
+    double result{square(a)};
+    do_not_optimize(result);
+  }
+}
+
+BENCHMARK("square/std_pow") {
+  int a{5};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(a);
+    double result{std::pow(a, 2)};
+    do_not_optimize(result);
+  }
+}
+
+BENCHMARK("square/compile_time") {
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    constexpr double result{square(5)};  // folded by the compiler
+    do_not_optimize(result);
+  }
+}
+
+//======== 18: area with the PI macro
+BENCHMARK("area/pi_macro") {
+  double radius{10.0};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(radius);
+    double area = PI * radius * radius;
+    do_not_optimize(area);
+  }
+}
+
+//======== 11/13: double to int conversion
+BENCHMARK("convert/double_to_int") {
+  double num1{1.5};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(num1);
+    int num2{static_cast<int>(num1)};
+    do_not_optimize(num2);
+  }
+}
+
+//======== 8-1/9-2: formatting doubles as std::cout does
+namespace {
+
+const std::vector<double>& table_values() {
+  static const std::vector<double> values{[] {
+    std::mt19937_64 generator{42};
+    std::lognormal_distribution<double> distribution{0.0, 8.0};
+    std::vector<double> values(4096);
+    for (auto& value : values)
+      value = generator() % 2 ? distribution(generator) : -distribution(generator);
+    return values;
+  }()};
+  return values;
+}
+
+}  // namespace
+
+BENCHMARK("float_format/ostream_scientific_10") {
+  const auto& values{table_values()};
+  std::ostringstream out;
+  out << std::scientific << std::setprecision(10);
+  state.set_items_per_iteration(values.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    out.str("");
+    for (double value : values)
+      out << value << '\n';
+    do_not_optimize(out);
+  }
+}
+
+BENCHMARK("float_format/snprintf_scientific_10") {
+  const auto& values{table_values()};
+  std::vector<char> out(values.size() * 32);
+  state.set_items_per_iteration(values.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    char* end{out.data()};
+    for (double value : values) {
+      end += std::snprintf(end, 32, "%.10e", value);
+      *end++ = '\n';
+    }
+    do_not_optimize(end);
+  }
+}
+
+BENCHMARK("float_format/format_float_scientific_10") {
+  const auto& values{table_values()};
+  std::vector<char> out(values.size() * 32);
+  state.set_items_per_iteration(values.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    char* end{out.data()};
+    for (double value : values) {
+      end = week2::format_float(end, end + 31, value, week2::FloatStyle::kScientific, 10);
+      *end++ = '\n';
+    }
+    do_not_optimize(end);
+  }
+}
+
+// Round-trip output: %.17g against the shortest representation
+BENCHMARK("float_format/snprintf_round_trip_17g") {
+  const auto& values{table_values()};
+  std::vector<char> out(values.size() * 32);
+  state.set_items_per_iteration(values.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    char* end{out.data()};
+    for (double value : values) {
+      end += std::snprintf(end, 32, "%.17g", value);
+      *end++ = '\n';
+    }
+    do_not_optimize(end);
+  }
+}
+
+BENCHMARK("float_format/format_float_shortest") {
+  const auto& values{table_values()};
+  std::vector<char> out(values.size() * 32);
+  state.set_items_per_iteration(values.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    char* end{out.data()};
+    for (double value : values) {
+      end = week2::format_float(end, end + 31, value, week2::FloatStyle::kShortest);
+      *end++ = '\n';
+    }
+    do_not_optimize(end);
+  }
+}
+
+//======== 19/20: constexpr tables (constexpr_tables.hpp) against run time
+// The tables of constexpr_tables.hpp cost nothing at startup. tables/init/*
+// is what filling the same tables at run time costs, once per process when
+// done by a static initializer. The other benchmarks compare a lookup with
+// computing the value.
+namespace {
+
+constexpr std::size_t kLookups{4096};
+
+std::vector<double> runtime_sin_table() {
+  std::vector<double> table(week2::kAngleSteps);
+  for (std::size_t i{0}; i < table.size(); ++i)
+    table[i] = std::sin(2.0 * week2::kPi * static_cast<double>(i) / week2::kAngleSteps);
+  return table;
+}
+
+std::uint32_t crc32_byte(std::uint32_t crc) {
+  for (int bit{0}; bit < 8; ++bit)
+    crc = (crc >> 1) ^ ((crc & 1u) != 0 ? 0xEDB88320u : 0u);
+  return crc;
+}
+
+std::vector<std::uint32_t> runtime_crc32_table() {
+  std::vector<std::uint32_t> table(256);
+  for (std::uint32_t byte{0}; byte < 256; ++byte)
+    table[byte] = crc32_byte(byte);
+  return table;
+}
+
+std::vector<std::uint32_t> lookup_keys(std::uint32_t bound) {
+  std::mt19937 generator{7};
+  std::uniform_int_distribution<std::uint32_t> distribution{0, bound - 1};
+  std::vector<std::uint32_t> keys(kLookups);
+  for (auto& key : keys)
+    key = distribution(generator);
+  return keys;
+}
+
+std::vector<double> lookup_angles() {
+  std::mt19937 generator{7};
+  std::uniform_real_distribution<double> distribution{0.0, 2.0 * week2::kPi};
+  std::vector<double> angles(kLookups);
+  for (auto& angle : angles)
+    angle = distribution(generator);
+  return angles;
+}
+
+std::vector<std::uint64_t> lookup_words() {
+  std::mt19937_64 generator{7};
+  std::vector<std::uint64_t> words(kLookups);
+  for (auto& word : words)
+    word = generator();
+  return words;
+}
+
+std::string_view crc_input() {
+  static const std::string buffer{[] {
+    std::mt19937 generator{7};
+    std::string bytes(4096, '\0');
+    for (auto& byte : bytes)
+      byte = static_cast<char>(generator());
+    return bytes;
+  }()};
+  return buffer;
+}
+
+template <typename Lookup>
+void sum_lookups(enpm702::bench::State& state, const std::vector<std::uint32_t>& keys, Lookup lookup) {
+  state.set_items_per_iteration(keys.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    std::uint64_t sum{0};
+    for (std::uint32_t key : keys)
+      sum += lookup(key);
+    do_not_optimize(sum);
+  }
+}
+
+}  // namespace
+
+BENCHMARK("tables/init/runtime_squares") {
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    std::vector<std::uint32_t> table(week2::kSquareCount);
+    for (std::uint32_t x{0}; x < table.size(); ++x)
+      table[x] = x * x;
+    do_not_optimize(table.data());
+  }
+}
+
+BENCHMARK("tables/init/runtime_sin") {
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    std::vector<double> table{runtime_sin_table()};
+    do_not_optimize(table.data());
+  }
+}
+
+BENCHMARK("tables/init/runtime_crc32") {
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    std::vector<std::uint32_t> table{runtime_crc32_table()};
+    do_not_optimize(table.data());
+  }
+}
+
+BENCHMARK("square/table") {
+  const std::vector<std::uint32_t> keys{lookup_keys(week2::kSquareCount)};
+  sum_lookups(state, keys, [](std::uint32_t x) { return week2::square_of(x); });
+}
+
+BENCHMARK("square/multiply") {
+  const std::vector<std::uint32_t> keys{lookup_keys(week2::kSquareCount)};
+  sum_lookups(state, keys, [](std::uint32_t x) { return SQUARE(x); });
+}
+
+BENCHMARK("pow10/table") {
+  const std::vector<std::uint32_t> keys{lookup_keys(23)};
+  state.set_items_per_iteration(keys.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    double sum{0};
+    for (std::uint32_t key : keys)
+      sum += week2::pow10(static_cast<int>(key));
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("pow10/std_pow") {
+  const std::vector<std::uint32_t> keys{lookup_keys(23)};
+  state.set_items_per_iteration(keys.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    double sum{0};
+    for (std::uint32_t key : keys)
+      sum += std::pow(10.0, static_cast<int>(key));
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("sin/table_q15") {
+  const std::vector<double> angles{lookup_angles()};
+  state.set_items_per_iteration(angles.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    double sum{0};
+    for (double angle : angles)
+      sum += week2::table_sin(angle);
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("sin/std_sin") {
+  const std::vector<double> angles{lookup_angles()};
+  state.set_items_per_iteration(angles.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    double sum{0};
+    for (double angle : angles)
+      sum += std::sin(angle);
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("crc32/table") {
+  const std::string_view bytes{crc_input()};
+  state.set_bytes_per_iteration(bytes.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i)
+    do_not_optimize(week2::crc32(bytes));
+}
+
+BENCHMARK("crc32/bitwise") {
+  const std::string_view bytes{crc_input()};
+  state.set_bytes_per_iteration(bytes.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    std::uint32_t crc{~0u};
+    for (char c : bytes)
+      crc = crc32_byte(crc ^ static_cast<unsigned char>(c));
+    do_not_optimize(~crc);
+  }
+}
+
+BENCHMARK("popcount/table") {
+  const std::vector<std::uint64_t> words{lookup_words()};
+  state.set_items_per_iteration(words.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    int sum{0};
+    for (std::uint64_t word : words)
+      sum += week2::popcount(word);
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("popcount/builtin") {
+  const std::vector<std::uint64_t> words{lookup_words()};
+  state.set_items_per_iteration(words.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    int sum{0};
+    for (std::uint64_t word : words)
+      sum += __builtin_popcountll(word);  // a libgcc call without -mpopcnt
+    do_not_optimize(sum);
+  }
+}
+
+BENCHMARK("popcount/clear_lowest_bit") {
+  const std::vector<std::uint64_t> words{lookup_words()};
+  state.set_items_per_iteration(words.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    int sum{0};
+    for (std::uint64_t word : words) {
+      for (; word != 0; word &= word - 1)
+        ++sum;
+    }
+    do_not_optimize(sum);
+  }
+}
+
+//======== 18: SQUARE(x) against ipow<N> and poly<> on arrays (power.hpp)
+// power/<N>/<size>/<how> computes out[i] = in[i]^N and poly/7/<size>/<how>
+// a degree-7 polynomial, for 10^8 doubles (1.6 GB of input and output,
+// bound by memory bandwidth) and for 4096 doubles (in L1, bound by the
+// arithmetic). batch_<isa> is ipow_batch<N>() or poly_batch<>() at that
+// level.
+namespace {
+
+inline constexpr std::array<double, 8> kDegree7{1.0, -0.5, 0.25, 2.0, -1.5, 0.125, 0.75, -0.0625};
+
+// Input and output arrays of each size, allocated on first use
+std::pair<const std::vector<double>*, std::vector<double>*> feature_arrays(std::size_t size) {
+  static std::map<std::size_t, std::pair<std::vector<double>, std::vector<double>>> arrays;
+  auto& [in, out]{arrays[size]};
+  if (in.size() != size) {
+    std::mt19937_64 generator{3};
+    std::uniform_real_distribution<double> distribution{-2.0, 2.0};
+    in.resize(size);
+    for (auto& x : in)
+      x = distribution(generator);
+    out.assign(size, 0.0);
+  }
+  return {&in, &out};
+}
+
+template <typename Transform>
+void transform_each(enpm702::bench::State& state, std::size_t size, Transform transform) {
+  const auto [in, out]{feature_arrays(size)};
+  state.set_items_per_iteration(size);
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    for (std::size_t j{0}; j < size; ++j)
+      (*out)[j] = transform((*in)[j]);
+    do_not_optimize(out->data());
+    enpm702::bench::clobber_memory();
+  }
+}
+
+template <typename Batch>
+void transform_batch(enpm702::bench::State& state, std::size_t size, Batch batch) {
+  const auto [in, out]{feature_arrays(size)};
+  state.set_items_per_iteration(size);
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    batch(in->data(), out->data(), size);
+    do_not_optimize(out->data());
+    enpm702::bench::clobber_memory();
+  }
+}
+
+// The batch_* benchmarks of the levels this CPU has
+template <typename Batch>
+void register_batches(const std::string& prefix, std::size_t size, Batch batch) {
+  using enpm702::SimdLevel;
+  for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+    if (enpm702::resolve(level) != level)
+      continue;
+    enpm702::bench::register_benchmark(prefix + "batch_" + enpm702::to_string(level),
+                                       [size, level, batch](auto& state) {
+                                         transform_batch(state, size, [level, batch](const double* in,
+                                                                                     double* out, std::size_t n) {
+                                           batch(in, out, n, level);
+                                         });
+                                       });
+  }
+}
+
+[[maybe_unused]] const bool power_registered{[] {
+  using enpm702::bench::register_benchmark;
+  for (const auto& [name, size] : {std::pair<std::string, std::size_t>{"1e8", 100'000'000},
+                                   std::pair<std::string, std::size_t>{"4k", 4096}}) {
+    const std::string square{"power/2/" + name + '/'};
+    register_benchmark(square + "macro", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return SQUARE(x); });
+    });
+    register_benchmark(square + "std_pow", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return std::pow(x, 2); });
+    });
+    register_benchmark(square + "ipow", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return week2::ipow<2>(x); });
+    });
+    register_batches(square, size, [](const double* in, double* out, std::size_t n, enpm702::SimdLevel level) {
+      week2::ipow_batch<2>(in, out, n, level);
+    });
+
+    const std::string seventh{"power/7/" + name + '/'};
+    register_benchmark(seventh + "std_pow", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return std::pow(x, 7); });
+    });
+    register_benchmark(seventh + "ipow", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return week2::ipow<7>(x); });
+    });
+    register_batches(seventh, size, [](const double* in, double* out, std::size_t n, enpm702::SimdLevel level) {
+      week2::ipow_batch<7>(in, out, n, level);
+    });
+
+    const std::string polynomial{"poly/7/" + name + '/'};
+    register_benchmark(polynomial + "horner", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return week2::poly<kDegree7>(x); });
+    });
+    register_benchmark(polynomial + "estrin", [size = size](auto& state) {
+      transform_each(state, size, [](double x) { return week2::poly_estrin<kDegree7>(x); });
+    });
+    register_batches(polynomial, size, [](const double* in, double* out, std::size_t n, enpm702::SimdLevel level) {
+      week2::poly_batch<kDegree7>(in, out, n, level);
+    });
+  }
+  return true;
+}()};
+
+}  // namespace
+
+//======== 11/13: static_cast against to_int() and to_float() on arrays
+// convert/array/<from>_to_<to>/<mode>/<how> converts 65536 values (in L2)
+// that are all in range, so that the static_cast loop is defined too.
+// batch_<isa> is to_int() or to_float() at that level.
+namespace {
+
+constexpr std::size_t kConvertCount{65536};
+
+template <typename T>
+const std::vector<T>& convert_input(double low, double high) {
+  static std::map<std::pair<double, double>, std::vector<T>> arrays;
+  std::vector<T>& values{arrays[{low, high}]};
+  if (values.empty()) {
+    std::mt19937_64 generator{5};
+    std::uniform_real_distribution<double> distribution{low, high};
+    values.resize(kConvertCount);
+    for (auto& x : values)
+      x = static_cast<T>(distribution(generator));
+  }
+  return values;
+}
+
+template <typename From, typename To, typename Convert>
+void convert_each(enpm702::bench::State& state, double low, double high, Convert convert) {
+  const std::vector<From>& in{convert_input<From>(low, high)};
+  std::vector<To> out(in.size());
+  state.set_items_per_iteration(in.size());
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    for (std::size_t j{0}; j < in.size(); ++j)
+      out[j] = convert(in[j]);
+    do_not_optimize(out.data());
+    enpm702::bench::clobber_memory();
+  }
+}
+
+// static_cast, then batch_<isa> for the levels this CPU has
+template <typename From, typename To, typename Cast, typename Batch>
+void register_conversion(const std::string& prefix, double low, double high, Cast cast, Batch batch) {
+  using enpm702::SimdLevel;
+  enpm702::bench::register_benchmark(prefix + "static_cast", [low, high, cast](auto& state) {
+    convert_each<From, To>(state, low, high, cast);
+  });
+  for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+    if (enpm702::resolve(level) != level)
+      continue;
+    enpm702::bench::register_benchmark(
+        prefix + "batch_" + enpm702::to_string(level), [low, high, level, batch](auto& state) {
+          const std::vector<From>& in{convert_input<From>(low, high)};
+          std::vector<To> out(in.size());
+          state.set_items_per_iteration(in.size());
+          for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+            batch(in.data(), out.data(), in.size(), level);
+            do_not_optimize(out.data());
+            enpm702::bench::clobber_memory();
+          }
+        });
+  }
+}
+
+[[maybe_unused]] const bool convert_registered{[] {
+  using week2::Overflow;
+  using week2::Rounding;
+  using enpm702::SimdLevel;
+  register_conversion<double, std::int32_t>(
+      "convert/array/double_to_int32/truncate/", -1e9, 1e9, [](double x) { return static_cast<std::int32_t>(x); },
+      [](const double* in, std::int32_t* out, std::size_t n, SimdLevel level) {
+        week2::to_int(in, out, n, {}, level);
+      });
+  // the static_cast version clamps first, and is wrong for NaN
+  register_conversion<double, std::int32_t>(
+      "convert/array/double_to_int32/nearest_saturate/", -1e9, 1e9,
+      [](double x) { return static_cast<std::int32_t>(std::nearbyint(std::clamp(x, -2147483648.0, 2147483647.0))); },
+      [](const double* in, std::int32_t* out, std::size_t n, SimdLevel level) {
+        week2::to_int(in, out, n, {Rounding::kNearestEven, Overflow::kSaturate}, level);
+      });
+  register_conversion<float, std::int8_t>(
+      "convert/array/float_to_int8/saturate/", -100.0, 100.0,
+      [](float x) { return static_cast<std::int8_t>(std::clamp(x, -128.0f, 127.0f)); },
+      [](const float* in, std::int8_t* out, std::size_t n, SimdLevel level) {
+        week2::to_int(in, out, n, {Rounding::kTruncate, Overflow::kSaturate}, level);
+      });
+  register_conversion<double, std::int64_t>(
+      "convert/array/double_to_int64/truncate/", -1e18, 1e18, [](double x) { return static_cast<std::int64_t>(x); },
+      [](const double* in, std::int64_t* out, std::size_t n, SimdLevel level) {
+        week2::to_int(in, out, n, {}, level);
+      });
+  register_conversion<std::int32_t, double>(
+      "convert/array/int32_to_double/", -1e9, 1e9, [](std::int32_t x) { return static_cast<double>(x); },
+      [](const std::int32_t* in, double* out, std::size_t n, SimdLevel level) {
+        week2::to_float(in, out, n, level);
+      });
+  register_conversion<std::int8_t, float>(
+      "convert/array/int8_to_float/", -128.0, 127.0, [](std::int8_t x) { return static_cast<float>(x); },
+      [](const std::int8_t* in, float* out, std::size_t n, SimdLevel level) {
+        week2::to_float(in, out, n, level);
+      });
+  return true;
+}()};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  return enpm702::bench::run_benchmarks(argc, argv);
+}
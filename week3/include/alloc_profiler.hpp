@@ -0,0 +1,68 @@
+/**
+ * @file alloc_profiler.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief In-process allocation profiler hooked into operator new/delete
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Linking the week3_alloc_profiler object library (or configuring with
+ * `-DWEEK3_OPERATOR_NEW=profiler`) replaces the global operator new/delete
+ * of an executable with a thin layer over malloc that:
+ *
+ * - counts live bytes and live blocks exactly, in per-thread counters;
+ * - samples on average one allocation per WEEK3_PROFILER_SAMPLE_BYTES
+ *   allocated bytes (default 64 KiB, 1 samples everything) and records its
+ *   call stack, so live bytes and blocks are estimated per call site;
+ * - prints the blocks still allocated at exit, e.g. the 100000 `int`s lost
+ *   by snippet 16, with the call sites that allocated them;
+ * - writes a heap profile to heap.<pid>.<n>.prof on SIGUSR1 (or the signal
+ *   number in WEEK3_PROFILER_SIGNAL) without stopping the program.
+ *
+ * Each block carries a 16-byte header; the unsampled path costs one malloc,
+ * a few unlocked updates of the calling thread's counters and no stack
+ * walk, which keeps it cheap enough for performance runs. Set
+ * WEEK3_PROFILER_QUIET=1 to skip the report at exit.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace week3::profiler {
+
+/**
+ * @brief Process-wide allocation counters
+ */
+struct HeapStats {
+  std::int64_t live_bytes;
+  std::int64_t live_blocks;
+  std::uint64_t total_bytes;
+  std::uint64_t total_blocks;
+};
+
+/**
+ * @brief Read the current counters
+ */
+HeapStats heap_stats();
+
+/**
+ * @brief Write the per-site heap profile to a file descriptor
+ *
+ * Only calls async-signal-safe functions, so it is also used by the signal
+ * handler. Addresses are printed raw and followed by /proc/self/maps so the
+ * profile can be symbolized offline (e.g. with addr2line).
+ *
+ * @param fd Destination file descriptor
+ */
+void dump_heap_profile(int fd);
+
+/**
+ * @brief Write the leak report (live blocks and their call sites)
+ *
+ * @param fd Destination file descriptor
+ */
+void report_leaks(int fd);
+
+}  // namespace week3::profiler
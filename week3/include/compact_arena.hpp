@@ -0,0 +1,227 @@
+/**
+ * @file compact_arena.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief 32-bit pointers into an arena, for pointer-heavy data structures
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippet 6 of week3.cpp shows that every pointer takes 8 bytes on x86-64,
+ * so a tree node holding two children and an int is 24 bytes, two thirds of
+ * it pointers. OffsetPtr<T> stores a 32-bit byte offset from the base of a
+ * CompactArena instead, the way JVMs compress their object references:
+ *
+ * @code
+ * struct Node {
+ *   week3::OffsetPtr<Node> left, right;
+ *   int value;
+ * };  // 12 bytes instead of 24
+ *
+ * week3::CompactArena arena;
+ * week3::OffsetPtr<Node> root{arena.make<Node>(nullptr, nullptr, 1)};
+ * root->left = arena.make<Node>(nullptr, nullptr, 0);
+ * @endcode
+ *
+ * OffsetPtr converts from and to T* and otherwise behaves like one
+ * (dereference, arithmetic, comparisons, null). Decoding is one add to a
+ * base kept in a global, so only one CompactArena may exist at a time; the
+ * constructor throws std::logic_error while another one is alive.
+ *
+ * The arena reserves just under 4 GiB of address space without committing it and
+ * bump-allocates from it; pages become resident when first written. Memory
+ * is returned all at once by reset() or the destructor.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace week3 {
+
+/**
+ * @brief Bump allocator over one reserved region of just under 4 GiB
+ */
+class CompactArena {
+ public:
+  // a page short of 4 GiB, so that one past the last byte is still a
+  // nonzero 32-bit offset and never reads as null
+  static constexpr std::size_t kMaxCapacity{(std::size_t{1} << 32) - 4096};
+
+  /**
+   * @brief Reserve @p capacity bytes of address space
+   *
+   * @throw std::logic_error if another CompactArena is alive
+   * @throw std::bad_alloc if the region cannot be reserved
+   */
+  explicit CompactArena(std::size_t capacity = kMaxCapacity)
+      : capacity_{capacity < kMaxCapacity ? capacity : kMaxCapacity} {
+    // checked in release builds too: a second base would silently redirect
+    // every OffsetPtr into the first arena
+    if (base_ != nullptr)
+      throw std::logic_error{"only one CompactArena may exist at a time"};
+    void* region{::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+    if (region == MAP_FAILED)
+      throw std::bad_alloc{};
+    base_ = static_cast<std::byte*>(region);
+  }
+
+  CompactArena(const CompactArena&) = delete;
+  CompactArena& operator=(const CompactArena&) = delete;
+
+  ~CompactArena() {
+    ::munmap(base_, capacity_);
+    base_ = nullptr;
+  }
+
+  /**
+   * @brief Allocate @p size bytes aligned to @p alignment
+   *
+   * @throw std::bad_alloc when the region is full
+   */
+  void* allocate(std::size_t size, std::size_t alignment) {
+    std::size_t offset{(used_ + alignment - 1) & ~(alignment - 1)};
+    if (offset + size > capacity_)
+      throw std::bad_alloc{};
+    used_ = offset + size;
+    return base_ + offset;
+  }
+
+  /**
+   * @brief Construct a T in the arena
+   *
+   * Its destructor never runs, hence the restriction to trivially
+   * destructible types.
+   */
+  template <typename T, typename... Args>
+  T* make(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "the arena never runs destructors");
+    return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+  }
+
+  /**
+   * @brief Free everything and give the pages back to the system
+   */
+  void reset() {
+    ::madvise(base_, capacity_, MADV_DONTNEED);
+    used_ = kFirstOffset;
+  }
+
+  std::size_t bytes_used() const { return used_; }
+
+  /**
+   * @brief Base of the live arena, which OffsetPtr decodes against
+   */
+  static std::byte* base() { return base_; }
+
+ private:
+  // offset 0 encodes the null pointer, so nothing is allocated there
+  static constexpr std::size_t kFirstOffset{alignof(std::max_align_t)};
+
+  inline static std::byte* base_{nullptr};
+  std::size_t capacity_;
+  std::size_t used_{kFirstOffset};
+};
+
+/**
+ * @brief Pointer to a T inside the CompactArena, stored in 32 bits
+ */
+template <typename T>
+class OffsetPtr {
+ public:
+  using element_type = T;
+  using difference_type = std::ptrdiff_t;
+
+  OffsetPtr() = default;
+  OffsetPtr(std::nullptr_t) {}
+
+  /**
+   * @brief Encode @p pointer, which must be null or point into the arena
+   */
+  OffsetPtr(T* pointer) : offset_{encode(pointer)} {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  OffsetPtr(OffsetPtr<U> other) : OffsetPtr{static_cast<T*>(other.get())} {}
+
+  T* get() const {
+    return offset_ == 0 ? nullptr
+                        : reinterpret_cast<T*>(CompactArena::base() + offset_);
+  }
+  operator T*() const { return get(); }
+
+  T& operator*() const { return *get(); }
+  T* operator->() const { return get(); }
+  T& operator[](std::ptrdiff_t index) const { return get()[index]; }
+
+  explicit operator bool() const { return offset_ != 0; }
+
+  OffsetPtr& operator+=(std::ptrdiff_t count) {
+    offset_ = static_cast<std::uint32_t>(offset_ + count * std::ptrdiff_t{sizeof(T)});
+    return *this;
+  }
+  OffsetPtr& operator-=(std::ptrdiff_t count) { return *this += -count; }
+  OffsetPtr& operator++() { return *this += 1; }
+  OffsetPtr& operator--() { return *this -= 1; }
+  OffsetPtr operator++(int) {
+    OffsetPtr old{*this};
+    ++*this;
+    return old;
+  }
+  OffsetPtr operator--(int) {
+    OffsetPtr old{*this};
+    --*this;
+    return old;
+  }
+
+  friend OffsetPtr operator+(OffsetPtr p, std::ptrdiff_t count) { return p += count; }
+  friend OffsetPtr operator+(std::ptrdiff_t count, OffsetPtr p) { return p += count; }
+  friend OffsetPtr operator-(OffsetPtr p, std::ptrdiff_t count) { return p -= count; }
+  friend std::ptrdiff_t operator-(OffsetPtr a, OffsetPtr b) {
+    return (std::ptrdiff_t{a.offset_} - std::ptrdiff_t{b.offset_}) /
+           std::ptrdiff_t{sizeof(T)};
+  }
+
+  friend bool operator==(OffsetPtr a, OffsetPtr b) { return a.offset_ == b.offset_; }
+  friend bool operator!=(OffsetPtr a, OffsetPtr b) { return a.offset_ != b.offset_; }
+  friend bool operator<(OffsetPtr a, OffsetPtr b) { return a.offset_ < b.offset_; }
+  friend bool operator==(OffsetPtr a, std::nullptr_t) { return a.offset_ == 0; }
+  friend bool operator!=(OffsetPtr a, std::nullptr_t) { return a.offset_ != 0; }
+  friend bool operator==(std::nullptr_t, OffsetPtr b) { return b.offset_ == 0; }
+  friend bool operator!=(std::nullptr_t, OffsetPtr b) { return b.offset_ != 0; }
+
+  // without these, p == raw is ambiguous between the overload above and the
+  // built-in T* comparison through operator T*()
+  friend bool operator==(OffsetPtr a, T* b) { return a.get() == b; }
+  friend bool operator!=(OffsetPtr a, T* b) { return a.get() != b; }
+  friend bool operator==(T* a, OffsetPtr b) { return a == b.get(); }
+  friend bool operator!=(T* a, OffsetPtr b) { return a != b.get(); }
+
+  /**
+   * @brief Raw offset from the arena base (0 for null)
+   */
+  std::uint32_t offset() const { return offset_; }
+
+ private:
+  static std::uint32_t encode(T* pointer) {
+    if (!pointer)
+      return 0;
+    auto offset{reinterpret_cast<const std::byte*>(pointer) - CompactArena::base()};
+    assert(offset > 0 && offset < std::ptrdiff_t{1} << 32 &&
+           "OffsetPtr must point into the CompactArena");
+    return static_cast<std::uint32_t>(offset);
+  }
+
+  std::uint32_t offset_{0};
+};
+
+}  // namespace week3
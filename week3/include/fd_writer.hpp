@@ -0,0 +1,99 @@
+/**
+ * @file fd_writer.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Buffered text output to a file descriptor, safe in signal handlers
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Used by the allocation profiler and the guard-page allocator, which report
+ * from signal handlers and from inside operator new/delete, where neither
+ * iostreams nor printf may be used.
+ */
+
+#pragma once
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace week3 {
+
+/**
+ * @brief Buffered writer that only uses write(2)
+ */
+class FdWriter {
+ public:
+  explicit FdWriter(int fd) : fd_{fd} {}
+  ~FdWriter() { flush(); }
+
+  FdWriter& operator<<(char c) {
+    put(c);
+    return *this;
+  }
+
+  FdWriter& operator<<(const char* text) {
+    while (*text)
+      put(*text++);
+    return *this;
+  }
+
+  FdWriter& operator<<(std::int64_t value) {
+    if (value >= 0)
+      return *this << static_cast<std::uint64_t>(value);
+    put('-');
+    return *this << static_cast<std::uint64_t>(-(value + 1)) + 1;
+  }
+
+  FdWriter& operator<<(std::uint64_t value) {
+    char digits[20];
+    int count{0};
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (count > 0)
+      put(digits[--count]);
+    return *this;
+  }
+
+  FdWriter& operator<<(const void* pointer) {
+    auto value{reinterpret_cast<std::uintptr_t>(pointer)};
+    *this << "0x";
+    bool leading{true};
+    for (int shift{60}; shift >= 0; shift -= 4) {
+      auto nibble{static_cast<unsigned>((value >> shift) & 0xf)};
+      if (nibble == 0 && leading && shift != 0)
+        continue;
+      leading = false;
+      put("0123456789abcdef"[nibble]);
+    }
+    return *this;
+  }
+
+  void flush() {
+    std::size_t done{0};
+    while (done < used_) {
+      ssize_t written{::write(fd_, buffer_ + done, used_ - done)};
+      if (written <= 0)
+        break;
+      done += static_cast<std::size_t>(written);
+    }
+    used_ = 0;
+  }
+
+ private:
+  void put(char c) {
+    if (used_ == sizeof(buffer_))
+      flush();
+    buffer_[used_++] = c;
+  }
+
+  int fd_;
+  char buffer_[512];
+  std::size_t used_{0};
+};
+
+}  // namespace week3
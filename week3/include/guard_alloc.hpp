@@ -0,0 +1,67 @@
+/**
+ * @file guard_alloc.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Guard-page allocator that catches use-after-free as it happens
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Linking the week3_guard_new object library (or configuring with
+ * `-DWEEK3_OPERATOR_NEW=guard`) replaces the global operator new/delete
+ * with an electric-fence style allocator:
+ *
+ * - every block gets its own pages, placed right before an inaccessible
+ *   guard page, so reading past its end faults immediately;
+ * - delete makes the pages inaccessible (mprotect) and keeps the block in a
+ *   bounded quarantine, so a dangling pointer such as the one of snippet 14
+ *   faults on its first use instead of reading stale or reused memory;
+ * - addresses are never handed out twice, so blocks that left the
+ *   quarantine (their memory is returned to the system) still fault;
+ * - deleting a block twice (exercise 6) or deleting a pointer that new did
+ *   not return (snippet 12) is reported on the spot.
+ *
+ * The SIGSEGV handler explains the fault (use-after-free, overflow, null
+ * pointer) with the call stacks of the allocation and of the delete, then
+ * lets the program die with the signal.
+ *
+ * Environment variables:
+ * - WEEK3_GUARD_QUARANTINE: blocks kept in quarantine (default 4096)
+ * - WEEK3_GUARD_PROTECT_BELOW=1: put the guard page before the block to
+ *   catch underflows instead of overflows
+ *
+ * Allocations and frees cost a system call each, while loads and stores run
+ * at full speed. Each live block takes two memory mappings, and Linux limits
+ * a process to about 65000 of them (vm.max_map_count); past that, or when
+ * the reserved region is used up, new falls back to unguarded malloc and
+ * says so once on stderr.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace week3::guard {
+
+/**
+ * @brief Allocate @p size bytes on their own pages
+ *
+ * @param size Requested size
+ * @param alignment Alignment of the returned pointer (power of two)
+ * @return void* The block, or nullptr if the system is out of memory
+ */
+void* allocate(std::size_t size, std::size_t alignment) noexcept;
+
+/**
+ * @brief Free a block returned by allocate(), reporting invalid frees
+ *
+ * @param pointer Block to free; nullptr is ignored
+ */
+void deallocate(void* pointer) noexcept;
+
+/**
+ * @brief Whether @p pointer lies in the guarded region
+ */
+bool owns(const void* pointer) noexcept;
+
+}  // namespace week3::guard
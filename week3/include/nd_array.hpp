@@ -0,0 +1,377 @@
+/**
+ * @file nd_array.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Contiguous N-dimensional arrays and strided views
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Exercise 2-2 of week3_exercise.cpp chains `int*`, `int**` and `int***`.
+ * Multi-dimensional data allocated that way (an array of pointers to arrays
+ * of pointers to rows) costs one dependent load, and often one cache miss,
+ * per dimension. NdArray keeps all elements in one allocation and computes
+ * the position of `a(i, j, k)` arithmetically, in the spirit of C++23
+ * std::mdspan:
+ *
+ * @code
+ * week3::NdArray<float, 3> a{4, 5, 6};                    // row-major
+ * week3::NdArray<float, 2, week3::LayoutLeft> m{100, 100}; // column-major
+ * week3::FixedNdArray<int, week3::LayoutRight, 3, 3> r;    // static extents
+ * a(1, 2, 3) = 1.0f;
+ * auto every_other{a.view().slice(2, 0, 6, 2)};  // no copy
+ * auto plane{a.view().fix(0, 1)};                 // 2-D view of a[1]
+ * @endcode
+ *
+ * Extents may be known at compile time (then the index arithmetic folds
+ * into constants) or given at run time. Storage is aligned to 64 bytes so
+ * that rows can be processed with aligned SIMD loads.
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace week3 {
+
+inline constexpr std::size_t dynamic_extent{static_cast<std::size_t>(-1)};
+
+/**
+ * @brief Sizes of the dimensions, each either static or dynamic_extent
+ */
+template <std::size_t... Static>
+class Extents {
+ public:
+  static constexpr std::size_t kRank{sizeof...(Static)};
+  static_assert(kRank > 0, "arrays have at least one dimension");
+  static constexpr std::array<std::size_t, kRank> kStatic{Static...};
+
+  /**
+   * @brief Static extents, with the dynamic ones set to 0
+   */
+  constexpr Extents() {
+    for (std::size_t d{0}; d < kRank; ++d)
+      sizes_[d] = static_extent(d) == dynamic_extent ? 0 : static_extent(d);
+  }
+
+  /**
+   * @brief All kRank extents; the static ones must match
+   */
+  template <typename... Sizes,
+            typename = std::enable_if_t<sizeof...(Sizes) == kRank &&
+                                        (std::is_integral_v<Sizes> && ...)>>
+  constexpr explicit Extents(Sizes... sizes)
+      : sizes_{static_cast<std::size_t>(sizes)...} {
+    for (std::size_t d{0}; d < kRank; ++d)
+      assert(static_extent(d) == dynamic_extent || static_extent(d) == sizes_[d]);
+  }
+
+  static constexpr std::size_t static_extent(std::size_t d) { return kStatic[d]; }
+
+  constexpr std::size_t extent(std::size_t d) const {
+    return static_extent(d) == dynamic_extent ? sizes_[d] : static_extent(d);
+  }
+
+  constexpr std::size_t size() const {
+    std::size_t count{1};
+    for (std::size_t d{0}; d < kRank; ++d)
+      count *= extent(d);
+    return count;
+  }
+
+ private:
+  std::array<std::size_t, kRank> sizes_{};
+};
+
+namespace detail {
+
+template <std::size_t>
+inline constexpr std::size_t kAlwaysDynamic{dynamic_extent};
+
+template <std::size_t Rank, typename = std::make_index_sequence<Rank>>
+struct DynamicExtents;
+
+template <std::size_t Rank, std::size_t... I>
+struct DynamicExtents<Rank, std::index_sequence<I...>> {
+  using type = Extents<kAlwaysDynamic<I>...>;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Extents of @p Rank dimensions, all given at run time
+ */
+template <std::size_t Rank>
+using DynamicExtents = typename detail::DynamicExtents<Rank>::type;
+
+/**
+ * @brief Row-major layout: the last index is contiguous (C arrays)
+ */
+struct LayoutRight {
+  // the folds unroll the dimensions, so that static extents become constants
+  template <typename E>
+  static constexpr std::size_t offset(const E& extents,
+                                      const std::array<std::size_t, E::kRank>& index) {
+    return offset(extents, index, std::make_index_sequence<E::kRank>{});
+  }
+
+  template <typename E>
+  static constexpr std::array<std::ptrdiff_t, E::kRank> strides(const E& extents) {
+    std::array<std::ptrdiff_t, E::kRank> result{};
+    std::ptrdiff_t stride{1};
+    for (std::size_t d{E::kRank}; d-- > 0;) {
+      result[d] = stride;
+      stride *= static_cast<std::ptrdiff_t>(extents.extent(d));
+    }
+    return result;
+  }
+
+ private:
+  template <typename E, std::size_t... D>
+  static constexpr std::size_t offset(const E& extents,
+                                      const std::array<std::size_t, E::kRank>& index,
+                                      std::index_sequence<D...>) {
+    std::size_t position{0};
+    ((position = position * extents.extent(D) + index[D]), ...);
+    return position;
+  }
+};
+
+/**
+ * @brief Column-major layout: the first index is contiguous (Fortran, BLAS)
+ */
+struct LayoutLeft {
+  template <typename E>
+  static constexpr std::size_t offset(const E& extents,
+                                      const std::array<std::size_t, E::kRank>& index) {
+    return offset(extents, index, std::make_index_sequence<E::kRank>{});
+  }
+
+  template <typename E>
+  static constexpr std::array<std::ptrdiff_t, E::kRank> strides(const E& extents) {
+    std::array<std::ptrdiff_t, E::kRank> result{};
+    std::ptrdiff_t stride{1};
+    for (std::size_t d{0}; d < E::kRank; ++d) {
+      result[d] = stride;
+      stride *= static_cast<std::ptrdiff_t>(extents.extent(d));
+    }
+    return result;
+  }
+
+ private:
+  template <typename E, std::size_t... D>
+  static constexpr std::size_t offset(const E& extents,
+                                      const std::array<std::size_t, E::kRank>& index,
+                                      std::index_sequence<D...>) {
+    constexpr std::size_t kLast{E::kRank - 1};
+    std::size_t position{0};
+    ((position = position * extents.extent(kLast - D) + index[kLast - D]), ...);
+    return position;
+  }
+};
+
+/**
+ * @brief Non-owning view with arbitrary strides (in elements)
+ *
+ * Views are cheap to copy; slicing or fixing an index returns a new view of
+ * the same elements.
+ */
+template <typename T, std::size_t Rank>
+class NdView {
+ public:
+  NdView(T* data, const std::array<std::size_t, Rank>& extents,
+         const std::array<std::ptrdiff_t, Rank>& strides)
+      : data_{data}, extents_{extents}, strides_{strides} {}
+
+  template <typename... Indices>
+  T& operator()(Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "one index per dimension");
+    return data_[position(std::make_index_sequence<Rank>{},
+                          static_cast<std::ptrdiff_t>(indices)...)];
+  }
+
+  /**
+   * @brief Indices first, first + step, ... below last of dimension @p dim
+   */
+  NdView slice(std::size_t dim, std::size_t first, std::size_t last,
+               std::size_t step = 1) const {
+    assert(first <= last && last <= extents_[dim] && step > 0);
+    NdView view{*this};
+    view.data_ += static_cast<std::ptrdiff_t>(first) * strides_[dim];
+    view.extents_[dim] = (last - first + step - 1) / step;
+    view.strides_[dim] *= static_cast<std::ptrdiff_t>(step);
+    return view;
+  }
+
+  /**
+   * @brief View of the elements whose index in dimension @p dim is @p index
+   */
+  NdView<T, Rank - 1> fix(std::size_t dim, std::size_t index) const {
+    static_assert(Rank > 1, "a view has at least one dimension");
+    assert(index < extents_[dim]);
+    std::array<std::size_t, Rank - 1> extents{};
+    std::array<std::ptrdiff_t, Rank - 1> strides{};
+    for (std::size_t d{0}, out{0}; d < Rank; ++d) {
+      if (d == dim)
+        continue;
+      extents[out] = extents_[d];
+      strides[out++] = strides_[d];
+    }
+    return NdView<T, Rank - 1>{data_ + static_cast<std::ptrdiff_t>(index) * strides_[dim],
+                               extents, strides};
+  }
+
+  /**
+   * @brief Same elements with dimensions @p a and @p b swapped
+   */
+  NdView transpose(std::size_t a, std::size_t b) const {
+    NdView view{*this};
+    std::swap(view.extents_[a], view.extents_[b]);
+    std::swap(view.strides_[a], view.strides_[b]);
+    return view;
+  }
+
+  T* data() const { return data_; }
+  std::size_t extent(std::size_t d) const { return extents_[d]; }
+  std::ptrdiff_t stride(std::size_t d) const { return strides_[d]; }
+  std::size_t size() const {
+    std::size_t count{1};
+    for (std::size_t extent : extents_)
+      count *= extent;
+    return count;
+  }
+
+ private:
+  template <std::size_t... D, typename... Indices>
+  std::ptrdiff_t position(std::index_sequence<D...>, Indices... indices) const {
+    return ((indices * strides_[D]) + ...);
+  }
+
+  T* data_;
+  std::array<std::size_t, Rank> extents_;
+  std::array<std::ptrdiff_t, Rank> strides_;
+};
+
+/**
+ * @brief Owning N-dimensional array in one 64-byte aligned allocation
+ *
+ * @tparam T Element type
+ * @tparam E Extents<...> type
+ * @tparam Layout LayoutRight (row-major) or LayoutLeft (column-major)
+ */
+template <typename T, typename E, typename Layout = LayoutRight>
+class BasicNdArray {
+ public:
+  static constexpr std::size_t kRank{E::kRank};
+  static constexpr std::size_t kAlignment{64};
+
+  /**
+   * @brief Array with static extents only
+   */
+  BasicNdArray() : BasicNdArray{E{}} {}
+
+  /**
+   * @brief Array of the given extents, elements value-initialized
+   */
+  template <typename... Sizes,
+            typename = std::enable_if_t<sizeof...(Sizes) == kRank &&
+                                        (std::is_integral_v<Sizes> && ...)>>
+  explicit BasicNdArray(Sizes... sizes) : BasicNdArray{E{sizes...}} {}
+
+  explicit BasicNdArray(const E& extents) : extents_{extents}, data_{allocate(size())} {
+    std::uninitialized_value_construct_n(data_, size());
+  }
+
+  BasicNdArray(const BasicNdArray& other)
+      : extents_{other.extents_}, data_{allocate(other.size())} {
+    std::uninitialized_copy_n(other.data_, size(), data_);
+  }
+
+  BasicNdArray(BasicNdArray&& other) noexcept
+      : extents_{other.extents_}, data_{std::exchange(other.data_, nullptr)} {}
+
+  BasicNdArray& operator=(BasicNdArray other) noexcept {
+    std::swap(extents_, other.extents_);
+    std::swap(data_, other.data_);
+    return *this;
+  }
+
+  ~BasicNdArray() {
+    if (data_) {
+      std::destroy_n(data_, size());
+      ::operator delete(data_, std::align_val_t{kAlignment});
+    }
+  }
+
+  template <typename... Indices>
+  T& operator()(Indices... indices) {
+    return data_[position(indices...)];
+  }
+
+  template <typename... Indices>
+  const T& operator()(Indices... indices) const {
+    return data_[position(indices...)];
+  }
+
+  NdView<T, kRank> view() { return NdView<T, kRank>{data_, extents_array(), strides()}; }
+  NdView<const T, kRank> view() const {
+    return NdView<const T, kRank>{data_, extents_array(), strides()};
+  }
+
+  std::array<std::ptrdiff_t, kRank> strides() const { return Layout::strides(extents_); }
+  std::size_t extent(std::size_t d) const { return extents_.extent(d); }
+  std::size_t size() const { return extents_.size(); }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  /**
+   * @brief Elements in memory order
+   */
+  T* begin() { return data_; }
+  T* end() { return data_ + size(); }
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size(); }
+
+ private:
+  static T* allocate(std::size_t count) {
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{kAlignment}));
+  }
+
+  template <typename... Indices>
+  std::size_t position(Indices... indices) const {
+    static_assert(sizeof...(Indices) == kRank, "one index per dimension");
+    return Layout::offset(extents_, {static_cast<std::size_t>(indices)...});
+  }
+
+  std::array<std::size_t, kRank> extents_array() const {
+    std::array<std::size_t, kRank> result{};
+    for (std::size_t d{0}; d < kRank; ++d)
+      result[d] = extents_.extent(d);
+    return result;
+  }
+
+  E extents_;
+  T* data_;
+};
+
+/**
+ * @brief N-dimensional array with run-time extents
+ */
+template <typename T, std::size_t Rank, typename Layout = LayoutRight>
+using NdArray = BasicNdArray<T, DynamicExtents<Rank>, Layout>;
+
+/**
+ * @brief N-dimensional array with compile-time extents
+ */
+template <typename T, typename Layout, std::size_t... Sizes>
+using FixedNdArray = BasicNdArray<T, Extents<Sizes...>, Layout>;
+
+}  // namespace week3
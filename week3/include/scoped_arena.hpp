@@ -0,0 +1,161 @@
+/**
+ * @file scoped_arena.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Monotonic arena whose memory lives exactly as long as a scope
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippet 15 of week3.cpp shows `inner_variable` dying at the closing brace
+ * of its scope. ScopedArena gives heap-like allocations the same lifetime:
+ *
+ * @code
+ * {
+ *   week3::ScopedArena<> arena;              // 4 KiB buffer on the stack
+ *   std::pmr::vector<int> ids{&arena};       // any std::pmr container
+ *   std::pmr::string name{"request", &arena};
+ *   auto* point{arena.make<Point>(1, 2)};    // or single objects
+ *   ...
+ * }  // everything is gone here, with no individual delete
+ * @endcode
+ *
+ * Allocation bumps a pointer through the inline buffer, then through heap
+ * chunks of doubling size taken from the upstream resource. Deallocation
+ * does nothing, except that the most recent block is given back so that a
+ * growing vector reuses its old storage. The destructor returns the chunks
+ * (usually none or a few), so freeing is independent of the number of
+ * allocations.
+ *
+ * A ScopedArena is not thread-safe and cannot be copied or moved, since
+ * the containers using it keep its address.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace week3 {
+
+/**
+ * @brief std::pmr::memory_resource that bump-allocates until the scope ends
+ *
+ * @tparam InlineBytes Size of the buffer stored inside the arena object
+ */
+template <std::size_t InlineBytes = 4096>
+class ScopedArena final : public std::pmr::memory_resource {
+ public:
+  /**
+   * @brief Construct an empty arena
+   *
+   * @param upstream Where the heap chunks come from; another arena can be
+   * used to nest scopes
+   */
+  explicit ScopedArena(std::pmr::memory_resource* upstream =
+                           std::pmr::new_delete_resource()) noexcept
+      : upstream_{upstream} {}
+
+  ScopedArena(const ScopedArena&) = delete;
+  ScopedArena& operator=(const ScopedArena&) = delete;
+
+  ~ScopedArena() override { release(); }
+
+  /**
+   * @brief Construct a T in the arena
+   *
+   * Its destructor never runs, hence the restriction to trivially
+   * destructible types; use a pmr container for the others.
+   */
+  template <typename T, typename... Args>
+  T* make(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "the arena never runs destructors");
+    return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+  }
+
+  /**
+   * @brief Free every block at once and start over from the inline buffer
+   */
+  void release() noexcept {
+    while (chunks_) {
+      Chunk* next{chunks_->next};
+      upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+      chunks_ = next;
+    }
+    current_ = buffer_;
+    end_ = buffer_ + InlineBytes;
+    next_chunk_size_ = kFirstChunkSize;
+  }
+
+  /**
+   * @brief Number of heap chunks in use (0 while the inline buffer lasts)
+   */
+  std::size_t chunk_count() const noexcept {
+    std::size_t count{0};
+    for (Chunk* chunk{chunks_}; chunk; chunk = chunk->next)
+      ++count;
+    return count;
+  }
+
+ private:
+  /**
+   * @brief Header of a heap chunk, followed by its data
+   */
+  struct alignas(std::max_align_t) Chunk {
+    Chunk* next;
+    std::size_t size;
+  };
+
+  static constexpr std::size_t kFirstChunkSize{std::max<std::size_t>(2 * InlineBytes, 4096)};
+  static constexpr std::size_t kMaxChunkSize{std::size_t{1} << 24};
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    auto padding{static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(current_) &
+                                          (alignment - 1))};
+    if (padding + bytes > static_cast<std::size_t>(end_ - current_)) {
+      grow(bytes + alignment);
+      padding = -reinterpret_cast<std::uintptr_t>(current_) & (alignment - 1);
+    }
+    std::byte* block{current_ + padding};
+    current_ = block + bytes;
+    return block;
+  }
+
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t) override {
+    // only the latest block ends at current_
+    auto block{static_cast<std::byte*>(pointer)};
+    if (block + bytes == current_)
+      current_ = block;
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  /**
+   * @brief Continue in a new heap chunk of at least @p bytes
+   */
+  void grow(std::size_t bytes) {
+    std::size_t size{std::max(next_chunk_size_, bytes + sizeof(Chunk))};
+    void* memory{upstream_->allocate(size, alignof(std::max_align_t))};
+    chunks_ = new (memory) Chunk{chunks_, size};
+    current_ = reinterpret_cast<std::byte*>(chunks_ + 1);
+    end_ = reinterpret_cast<std::byte*>(chunks_) + size;
+    next_chunk_size_ = std::min(2 * next_chunk_size_, kMaxChunkSize);
+  }
+
+  std::pmr::memory_resource* upstream_;
+  Chunk* chunks_{nullptr};
+  std::byte* current_{buffer_};
+  std::byte* end_{buffer_ + InlineBytes};
+  std::size_t next_chunk_size_{kFirstChunkSize};
+  alignas(std::max_align_t) std::byte buffer_[InlineBytes];
+};
+
+}  // namespace week3
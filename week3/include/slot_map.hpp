@@ -0,0 +1,206 @@
+/**
+ * @file slot_map.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Dense container addressed by generation-checked handles
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Exercises 6 and 7 of week3_exercise.cpp keep raw pointers (and a
+ * reference) to objects after they are deleted, and nothing notices.
+ * SlotMap<T> replaces such pointers with handles:
+ *
+ * - a handle is a 32-bit slot index plus a 32-bit generation; the
+ *   generation of a slot changes each time its object is erased, so a handle
+ *   to an erased object is detected (get() returns nullptr, at() throws)
+ *   even after the slot is reused;
+ * - the objects themselves are packed in one vector, so iterating over them
+ *   is a linear scan, unlike following the pointers of a list or an object
+ *   graph allocated piecewise with new;
+ * - insert, erase and lookup are O(1): erase moves the last object into the
+ *   hole, and the slot table maps handles to positions in the packed vector.
+ *
+ * Iteration order is not insertion order, and erase invalidates references
+ * and iterators (never handles).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace week3 {
+
+/**
+ * @brief Handle to an object of a SlotMap
+ *
+ * A default-constructed handle refers to nothing.
+ */
+struct SlotHandle {
+  static constexpr std::uint32_t kNone{std::numeric_limits<std::uint32_t>::max()};
+
+  std::uint32_t index{kNone};
+  std::uint32_t generation{0};
+
+  friend bool operator==(SlotHandle a, SlotHandle b) {
+    return a.index == b.index && a.generation == b.generation;
+  }
+  friend bool operator!=(SlotHandle a, SlotHandle b) { return !(a == b); }
+};
+
+/**
+ * @brief Packed storage of T objects with stable, checked handles
+ */
+template <typename T>
+class SlotMap {
+ public:
+  using value_type = T;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  /**
+   * @brief Construct an object in place and return its handle
+   */
+  template <typename... Args>
+  SlotHandle emplace(Args&&... args) {
+    values_.emplace_back(std::forward<Args>(args)...);
+    std::uint32_t index;
+    if (free_head_ != SlotHandle::kNone) {
+      index = free_head_;
+      free_head_ = slots_[index].position;
+    } else {
+      if (slots_.size() == SlotHandle::kNone) {
+        values_.pop_back();
+        throw std::length_error{"SlotMap: too many slots"};
+      }
+      index = static_cast<std::uint32_t>(slots_.size());
+      slots_.push_back(Slot{});
+    }
+    slots_[index].position = static_cast<std::uint32_t>(values_.size() - 1);
+    owners_.push_back(index);
+    return SlotHandle{index, slots_[index].generation};
+  }
+
+  SlotHandle insert(const T& value) { return emplace(value); }
+  SlotHandle insert(T&& value) { return emplace(std::move(value)); }
+
+  /**
+   * @brief Erase the object of @p handle
+   *
+   * @return false if the handle is stale or empty
+   */
+  bool erase(SlotHandle handle) {
+    if (!contains(handle))
+      return false;
+    Slot& slot{slots_[handle.index]};
+    const std::uint32_t last{static_cast<std::uint32_t>(values_.size() - 1)};
+    if (slot.position != last) {
+      values_[slot.position] = std::move(values_[last]);
+      owners_[slot.position] = owners_[last];
+      slots_[owners_[last]].position = slot.position;
+    }
+    values_.pop_back();
+    owners_.pop_back();
+
+    // a slot whose generation would wrap around is retired, so that an old
+    // handle can never match again
+    if (++slot.generation != 0) {
+      slot.position = free_head_;
+      free_head_ = handle.index;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Whether @p handle refers to an object of this map
+   */
+  bool contains(SlotHandle handle) const {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].generation == handle.generation &&
+           slots_[handle.index].position < values_.size() &&
+           owners_[slots_[handle.index].position] == handle.index;
+  }
+
+  /**
+   * @brief Object of @p handle, or nullptr if the handle is stale
+   */
+  T* get(SlotHandle handle) {
+    return contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+  }
+  const T* get(SlotHandle handle) const {
+    return contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+  }
+
+  /**
+   * @brief Object of @p handle
+   *
+   * @throw std::out_of_range if the handle is stale
+   */
+  T& at(SlotHandle handle) {
+    if (T* value{get(handle)})
+      return *value;
+    throw std::out_of_range{"SlotMap: stale handle"};
+  }
+  const T& at(SlotHandle handle) const {
+    if (const T* value{get(handle)})
+      return *value;
+    throw std::out_of_range{"SlotMap: stale handle"};
+  }
+
+  /**
+   * @brief Handle of the object at @p position of the packed storage
+   */
+  SlotHandle handle_at(std::size_t position) const {
+    std::uint32_t index{owners_[position]};
+    return SlotHandle{index, slots_[index].generation};
+  }
+
+  /**
+   * @brief Erase every object; all handles become stale
+   */
+  void clear() {
+    while (!values_.empty())
+      erase(handle_at(values_.size() - 1));
+  }
+
+  void reserve(std::size_t count) {
+    values_.reserve(count);
+    owners_.reserve(count);
+    slots_.reserve(count);
+  }
+
+  std::size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+
+  T* data() { return values_.data(); }
+  const T* data() const { return values_.data(); }
+
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+
+ private:
+  /**
+   * @brief Entry of the slot table
+   *
+   * `position` is the index in values_ while the slot is in use, and the
+   * next free slot while it is on the free list.
+   */
+  struct Slot {
+    std::uint32_t position{SlotHandle::kNone};
+    std::uint32_t generation{0};
+  };
+
+  std::vector<T> values_;
+  std::vector<std::uint32_t> owners_;  // slot of each object of values_
+  std::vector<Slot> slots_;
+  std::uint32_t free_head_{SlotHandle::kNone};
+};
+
+}  // namespace week3
@@ -0,0 +1,427 @@
+/**
+ * @file week3.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Size-class pool allocator for small heap objects
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippets 10-16 of week3.cpp allocate one small object at a time with
+ * `new int{...}`. This header provides an allocator tuned for that pattern:
+ *
+ * - Requests up to kMaxSize bytes are rounded up to a size class (a
+ *   multiple of 16 bytes). Larger requests go to std::malloc.
+ * - Objects of a size class are carved out of 64 KiB spans taken from one
+ *   reserved virtual region, so the size class of any pointer is found from
+ *   its address alone and delete does not need the size.
+ * - Each thread keeps two magazines (small stacks of free objects) per size
+ *   class and allocates or frees without locking while they last.
+ * - Full and empty magazines are exchanged with a global depot, one mutex
+ *   per size class, so objects freed by one thread are reused by others.
+ *
+ * Memory is never returned to the operating system. Use it through
+ * week3::pool::allocate()/deallocate(), week3::PoolAllocator<T> for the
+ * standard containers, or link the week3_pool_new object library to
+ * replace the global operator new/delete.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace week3 {
+namespace pool {
+
+constexpr std::size_t kGranularity{16};  // also the alignment of objects
+constexpr std::size_t kMaxSize{256};
+constexpr std::size_t kNumClasses{kMaxSize / kGranularity};
+constexpr std::size_t kSpanSize{64 * 1024};
+constexpr std::size_t kMagazineCapacity{64};
+constexpr std::size_t kRegionSize{std::size_t{1} << 34};  // 16 GiB reserved
+constexpr std::size_t kNumSpans{kRegionSize / kSpanSize};
+
+/**
+ * @brief Size class of a request, assuming size <= kMaxSize
+ */
+constexpr std::size_t size_class(std::size_t size) {
+  return size == 0 ? 0 : (size - 1) / kGranularity;
+}
+
+/**
+ * @brief Object size of a size class
+ */
+constexpr std::size_t class_size(std::size_t cls) {
+  return (cls + 1) * kGranularity;
+}
+
+/**
+ * @brief Fixed-capacity stack of free objects of one size class
+ *
+ * Magazines are linked into the depot lists through `next`.
+ */
+struct Magazine {
+  Magazine* next{nullptr};
+  std::size_t count{0};
+  std::array<void*, kMagazineCapacity> objects{};
+
+  bool empty() const { return count == 0; }
+  bool full() const { return count == kMagazineCapacity; }
+};
+
+namespace detail {
+
+/**
+ * @brief Per-size-class state shared by all threads
+ */
+struct Depot {
+  std::mutex mutex;
+  Magazine* loaded{nullptr};  // magazines holding at least one object
+  Magazine* empty{nullptr};   // magazines holding no object
+  std::byte* span_cursor{nullptr};  // next unused object of the open span
+  std::byte* span_end{nullptr};
+};
+
+/**
+ * @brief The reserved address range and the per-class depots
+ */
+struct Region {
+  std::byte* base{nullptr};
+  std::size_t size{0};
+  std::atomic<std::size_t> next_span{0};
+  std::array<std::uint8_t, kNumSpans> span_class{};
+  std::array<Depot, kNumClasses> depots{};
+
+  Region() {
+    // MAP_NORESERVE: only pages actually touched are backed by memory.
+    for (std::size_t bytes{kRegionSize}; bytes >= 64 * kSpanSize; bytes /= 2) {
+      void* address{mmap(nullptr, bytes + kSpanSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+      if (address != MAP_FAILED) {
+        // align the base so that span boundaries are multiples of kSpanSize
+        auto raw{reinterpret_cast<std::uintptr_t>(address)};
+        auto aligned{(raw + kSpanSize - 1) & ~(kSpanSize - 1)};
+        base = reinterpret_cast<std::byte*>(aligned);
+        size = bytes;
+        break;
+      }
+    }
+  }
+};
+
+/**
+ * @brief The process-wide region, created on first use and never destroyed
+ *
+ * It is leaked on purpose: objects may still be freed by static destructors
+ * that run after a function-local static would have been destroyed.
+ */
+inline Region& region() {
+  static Region* instance{new (std::malloc(sizeof(Region))) Region{}};
+  return *instance;
+}
+
+inline Magazine* pop(Magazine*& list) {
+  Magazine* magazine{list};
+  if (magazine)
+    list = magazine->next;
+  return magazine;
+}
+
+inline void push(Magazine*& list, Magazine* magazine) {
+  magazine->next = list;
+  list = magazine;
+}
+
+inline Magazine* new_magazine() {
+  void* memory{std::malloc(sizeof(Magazine))};
+  if (!memory)
+    throw std::bad_alloc{};
+  return new (memory) Magazine{};
+}
+
+/**
+ * @brief Fill an empty magazine with fresh objects; depot.mutex is held
+ *
+ * @return false if the region is exhausted
+ */
+inline bool carve(Region& region, std::size_t cls, Magazine& magazine) {
+  Depot& depot{region.depots[cls]};
+  const std::size_t object_size{class_size(cls)};
+  while (!magazine.full()) {
+    if (depot.span_cursor + object_size > depot.span_end) {
+      std::size_t span{region.next_span.fetch_add(1, std::memory_order_relaxed)};
+      if ((span + 1) * kSpanSize > region.size)
+        return !magazine.empty();
+      region.span_class[span] = static_cast<std::uint8_t>(cls);
+      depot.span_cursor = region.base + span * kSpanSize;
+      depot.span_end = depot.span_cursor + kSpanSize;
+    }
+    magazine.objects[magazine.count++] = depot.span_cursor;
+    depot.span_cursor += object_size;
+  }
+  return true;
+}
+
+/**
+ * @brief Exchange an empty magazine for a loaded one
+ *
+ * @return Magazine* A magazine holding at least one object or nullptr
+ */
+inline Magazine* exchange_empty(std::size_t cls, Magazine* empty) {
+  Region& instance{region()};
+  Depot& depot{instance.depots[cls]};
+  std::lock_guard<std::mutex> lock{depot.mutex};
+  if (Magazine* loaded{pop(depot.loaded)}) {
+    if (empty)
+      push(depot.empty, empty);
+    return loaded;
+  }
+  Magazine* magazine{empty ? empty : pop(depot.empty)};
+  if (!magazine)
+    magazine = new_magazine();
+  if (!carve(instance, cls, *magazine)) {
+    push(depot.empty, magazine);
+    return nullptr;
+  }
+  return magazine;
+}
+
+/**
+ * @brief Exchange a full magazine for an empty one
+ */
+inline Magazine* exchange_full(std::size_t cls, Magazine* full) {
+  Depot& depot{region().depots[cls]};
+  Magazine* empty{nullptr};
+  {
+    std::lock_guard<std::mutex> lock{depot.mutex};
+    if (full)
+      push(depot.loaded, full);
+    empty = pop(depot.empty);
+  }
+  return empty ? empty : new_magazine();
+}
+
+/**
+ * @brief The two magazines a thread holds for one size class
+ *
+ * When `loaded` runs dry and `previous` is full (or the other way around on
+ * free) the two are swapped, so a thread that alternates between allocating
+ * and freeing around a magazine boundary does not hit the depot each time.
+ */
+struct ClassCache {
+  Magazine* loaded{nullptr};
+  Magazine* previous{nullptr};
+};
+
+/**
+ * @brief Per-thread caches; trivially destructible so that they stay usable
+ * while other thread_local destructors run
+ */
+struct ThreadCache {
+  std::array<ClassCache, kNumClasses> classes{};
+  bool detached{false};  // set once the magazines went back to the depot
+};
+
+inline ThreadCache& thread_cache() {
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+/**
+ * @brief Returns the magazines of the calling thread to the depot at exit
+ */
+struct ThreadCacheFlusher {
+  ~ThreadCacheFlusher() {
+    ThreadCache& cache{thread_cache()};
+    Region& instance{region()};
+    for (std::size_t cls{0}; cls < kNumClasses; ++cls) {
+      Depot& depot{instance.depots[cls]};
+      std::lock_guard<std::mutex> lock{depot.mutex};
+      for (Magazine* magazine :
+           {cache.classes[cls].loaded, cache.classes[cls].previous}) {
+        if (magazine)
+          push(magazine->empty() ? depot.empty : depot.loaded, magazine);
+      }
+      cache.classes[cls] = ClassCache{};
+    }
+    cache.detached = true;
+  }
+};
+
+inline void register_thread_flusher() {
+  static thread_local ThreadCacheFlusher flusher;
+  (void)flusher;
+}
+
+/**
+ * @brief Slow path of allocate(), taken when the loaded magazine is empty
+ */
+inline void* refill(ThreadCache& cache, std::size_t cls) {
+  if (cache.detached) {
+    // the thread is exiting: take one object and leave the magazine behind
+    Magazine* magazine{exchange_empty(cls, nullptr)};
+    if (!magazine)
+      return nullptr;
+    void* object{magazine->objects[--magazine->count]};
+    Depot& depot{region().depots[cls]};
+    std::lock_guard<std::mutex> lock{depot.mutex};
+    push(magazine->empty() ? depot.empty : depot.loaded, magazine);
+    return object;
+  }
+  ClassCache& classes{cache.classes[cls]};
+  if (!classes.loaded && !classes.previous)
+    register_thread_flusher();
+  if (classes.previous && !classes.previous->empty()) {
+    std::swap(classes.loaded, classes.previous);
+  } else {
+    Magazine* empty{classes.loaded};
+    if (!classes.previous) {
+      // keep the empty magazine for the next frees
+      classes.previous = empty;
+      empty = nullptr;
+    }
+    classes.loaded = exchange_empty(cls, empty);
+    if (!classes.loaded)
+      return nullptr;
+  }
+  return classes.loaded->objects[--classes.loaded->count];
+}
+
+/**
+ * @brief Slow path of deallocate(), taken when the loaded magazine is full
+ */
+inline void flush(ThreadCache& cache, std::size_t cls, void* object) {
+  if (cache.detached) {
+    Magazine* magazine{exchange_full(cls, nullptr)};
+    magazine->objects[magazine->count++] = object;
+    Depot& depot{region().depots[cls]};
+    std::lock_guard<std::mutex> lock{depot.mutex};
+    push(depot.loaded, magazine);
+    return;
+  }
+  ClassCache& classes{cache.classes[cls]};
+  if (!classes.loaded && !classes.previous)
+    register_thread_flusher();
+  if (classes.previous && !classes.previous->full()) {
+    std::swap(classes.loaded, classes.previous);
+  } else if (!classes.previous) {
+    // keep the full magazine for the next allocations
+    classes.previous = classes.loaded;
+    classes.loaded = exchange_full(cls, nullptr);
+  } else {
+    classes.loaded = exchange_full(cls, classes.loaded);
+  }
+  classes.loaded->objects[classes.loaded->count++] = object;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Whether @p pointer was returned by the pool (and not by malloc)
+ */
+inline bool owns(const void* pointer) {
+  const detail::Region& instance{detail::region()};
+  auto address{static_cast<const std::byte*>(pointer)};
+  return address >= instance.base && address < instance.base + instance.size;
+}
+
+/**
+ * @brief Allocate @p size bytes aligned to at least kGranularity
+ *
+ * @return void* The memory, or nullptr if the system is out of memory
+ * @throw std::bad_alloc if no magazine could be allocated
+ */
+inline void* allocate(std::size_t size) {
+  if (size > kMaxSize)
+    return std::malloc(size);
+  const std::size_t cls{size_class(size)};
+  detail::ThreadCache& cache{detail::thread_cache()};
+  Magazine* loaded{cache.classes[cls].loaded};
+  if (loaded && !loaded->empty())
+    return loaded->objects[--loaded->count];
+  if (void* object{detail::refill(cache, cls)})
+    return object;
+  return std::malloc(size);  // region exhausted
+}
+
+/**
+ * @brief Free memory returned by allocate()
+ *
+ * @param pointer Memory to free; nullptr is ignored
+ */
+inline void deallocate(void* pointer) noexcept {
+  if (!pointer)
+    return;
+  if (!owns(pointer)) {
+    std::free(pointer);
+    return;
+  }
+  detail::Region& instance{detail::region()};
+  auto offset{static_cast<std::size_t>(static_cast<std::byte*>(pointer) -
+                                       instance.base)};
+  const std::size_t cls{instance.span_class[offset / kSpanSize]};
+  detail::ThreadCache& cache{detail::thread_cache()};
+  Magazine* loaded{cache.classes[cls].loaded};
+  if (loaded && !loaded->full()) {
+    loaded->objects[loaded->count++] = pointer;
+    return;
+  }
+  detail::flush(cache, cls, pointer);
+}
+
+}  // namespace pool
+
+/**
+ * @brief Standard allocator backed by the pool, e.g.
+ * `std::list<int, week3::PoolAllocator<int>>`
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t count) {
+    if (count > static_cast<std::size_t>(-1) / sizeof(T))
+      throw std::bad_array_new_length{};
+    if constexpr (alignof(T) > pool::kGranularity) {
+      return static_cast<T*>(
+          ::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+    } else {
+      void* memory{pool::allocate(count * sizeof(T))};
+      if (!memory)
+        throw std::bad_alloc{};
+      return static_cast<T*>(memory);
+    }
+  }
+
+  void deallocate(T* pointer, std::size_t) noexcept {
+    if constexpr (alignof(T) > pool::kGranularity)
+      ::operator delete(pointer, std::align_val_t{alignof(T)});
+    else
+      pool::deallocate(pointer);
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return false;
+}
+
+}  // namespace week3
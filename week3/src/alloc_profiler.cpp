@@ -0,0 +1,556 @@
+/**
+ * @file alloc_profiler.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Sampling allocation profiler replacing operator new/delete
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * See alloc_profiler.hpp for the behavior and the environment variables.
+ * Nothing in this file allocates through operator new, and the reporting
+ * functions used by the signal handler only call write(2), open(2),
+ * read(2) and close(2).
+ */
+
+#include "alloc_profiler.hpp"
+#include "fd_writer.hpp"
+
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+using week3::FdWriter;
+
+constexpr std::size_t kHeaderSize{16};
+constexpr int kMaxFrames{16};
+// record_sample(), allocate(), allocate_or_throw() or allocate_nothrow(),
+// and operator new, which are all kept out of line
+constexpr int kSkippedFrames{4};
+constexpr std::size_t kMaxSites{4096};
+constexpr std::size_t kSlots{256};
+constexpr std::size_t kTopSites{10};
+
+/**
+ * @brief Stored right before every block handed out by operator new
+ */
+struct BlockHeader {
+  std::uint64_t size;
+  std::uint32_t site;    // 0 if the block was not sampled, else site index + 1
+  std::uint32_t offset;  // distance from the malloc'd base to the block
+};
+static_assert(sizeof(BlockHeader) == kHeaderSize);
+
+/**
+ * @brief Counters owned by one thread at a time
+ *
+ * The owner is the only writer, so it updates them with a plain load and
+ * store instead of a locked read-modify-write. Slot 0 is shared by the
+ * threads that found no free slot and is updated with fetch_add. When a
+ * thread exits its slot is released; the counters are net values, so the
+ * next owner simply keeps adding to them.
+ */
+struct alignas(64) Slot {
+  std::atomic<std::int64_t> live_bytes;
+  std::atomic<std::int64_t> live_blocks;
+  std::atomic<std::uint64_t> total_bytes;
+  std::atomic<std::uint64_t> total_blocks;
+  std::atomic<bool> in_use;
+};
+
+/**
+ * @brief A call site, identified by the hash of its call stack
+ *
+ * Estimates are scaled from the samples (see sample_weight()).
+ */
+struct Site {
+  std::atomic<std::uint64_t> key;  // 0 for a free slot
+  std::atomic<bool> ready;         // frames and depth are written
+  int depth;
+  void* frames[kMaxFrames];
+  std::atomic<std::int64_t> sampled_live_blocks;
+  std::atomic<std::int64_t> live_bytes;
+  std::atomic<std::int64_t> live_blocks;
+  std::atomic<std::int64_t> total_bytes;
+};
+
+/**
+ * @brief Per-thread state, zero-initialized so it needs no TLS constructor
+ */
+struct ThreadState {
+  std::size_t slot;  // 0 until assigned, else slot index + 1
+  std::int64_t bytes_until_sample;
+  std::uint64_t random;
+};
+
+Slot g_slots[kSlots];
+Site g_sites[kMaxSites];  // slot 0 collects the stacks that did not fit
+pthread_key_t g_slot_key;
+pthread_once_t g_slot_key_once = PTHREAD_ONCE_INIT;
+std::atomic<unsigned> g_dump_sequence{0};
+std::int64_t g_sample_bytes{64 * 1024};
+bool g_quiet{false};
+thread_local ThreadState t_state;
+
+//--------------------------------------------------------------------------
+// Sampling
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Release the slot of an exiting thread (pthread key destructor)
+ */
+void release_slot(void* value) {
+  auto index{reinterpret_cast<std::uintptr_t>(value) - 1};
+  // allocations made later during the exit go to the shared slot
+  t_state.slot = 1;
+  g_slots[index].in_use.store(false, std::memory_order_release);
+}
+
+void create_slot_key() { ::pthread_key_create(&g_slot_key, release_slot); }
+
+std::size_t claim_slot() {
+  ::pthread_once(&g_slot_key_once, create_slot_key);
+  for (std::size_t index{1}; index < kSlots; ++index) {
+    bool expected{false};
+    if (!g_slots[index].in_use.load(std::memory_order_relaxed) &&
+        g_slots[index].in_use.compare_exchange_strong(expected, true,
+                                                      std::memory_order_acquire)) {
+      ::pthread_setspecific(g_slot_key, reinterpret_cast<void*>(index + 1));
+      return index;
+    }
+  }
+  return 0;
+}
+
+ThreadState& thread_state() {
+  ThreadState& state{t_state};
+  if (state.slot == 0) {
+    state.slot = claim_slot() + 1;
+    state.random = reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state.bytes_until_sample = g_sample_bytes;
+  }
+  return state;
+}
+
+/**
+ * @brief Add to a counter of the calling thread's slot
+ */
+template <typename T>
+void add(std::atomic<T>& counter, T value, bool shared) {
+  if (shared)
+    counter.fetch_add(value, std::memory_order_relaxed);
+  else
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+}
+
+/**
+ * @brief Bytes to allocate before the next sample
+ *
+ * Exponentially distributed with mean g_sample_bytes, so that periodic
+ * allocation patterns cannot hide from the sampler.
+ */
+std::int64_t next_sample_distance(ThreadState& state) {
+  if (g_sample_bytes <= 1)
+    return 0;
+  // xorshift64
+  state.random ^= state.random << 13;
+  state.random ^= state.random >> 7;
+  state.random ^= state.random << 17;
+  double uniform{((state.random >> 11) + 0.5) * 0x1.0p-53};
+  return static_cast<std::int64_t>(-std::log(uniform) * g_sample_bytes) + 1;
+}
+
+/**
+ * @brief Number of allocations of @p size represented by one sample
+ */
+double sample_weight(std::uint64_t size) {
+  if (g_sample_bytes <= 1)
+    return 1.0;
+  double probability{1.0 - std::exp(-static_cast<double>(size) / g_sample_bytes)};
+  return probability > 0.0 ? 1.0 / probability : 1.0;
+}
+
+std::uint64_t hash_frames(void* const* frames, int depth) {
+  std::uint64_t hash{0xcbf29ce484222325ULL};
+  for (int i{0}; i < depth; ++i) {
+    hash ^= reinterpret_cast<std::uintptr_t>(frames[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash | 1;  // never 0, which marks a free slot
+}
+
+/**
+ * @brief Find or create the site of a call stack
+ *
+ * @return std::size_t Index in g_sites; 0 when the table is full
+ */
+std::size_t find_site(void* const* frames, int depth) {
+  const std::uint64_t hash{hash_frames(frames, depth)};
+  for (std::size_t probe{0}; probe < kMaxSites - 1; ++probe) {
+    std::size_t index{1 + (hash + probe) % (kMaxSites - 1)};
+    Site& site{g_sites[index]};
+    std::uint64_t key{site.key.load(std::memory_order_acquire)};
+    if (key == 0 &&
+        site.key.compare_exchange_strong(key, hash, std::memory_order_acq_rel)) {
+      std::memcpy(site.frames, frames, sizeof(void*) * depth);
+      site.depth = depth;
+      site.ready.store(true, std::memory_order_release);
+      return index;
+    }
+    if (key == hash)
+      return index;
+  }
+  return 0;
+}
+
+[[gnu::noinline]] std::uint32_t record_sample(std::uint64_t size) {
+  void* frames[kMaxFrames + kSkippedFrames];
+  int depth{::backtrace(frames, kMaxFrames + kSkippedFrames) - kSkippedFrames};
+  if (depth < 0)
+    depth = 0;
+  std::size_t index{find_site(frames + kSkippedFrames, depth)};
+  Site& site{g_sites[index]};
+  double weight{sample_weight(size)};
+  site.sampled_live_blocks.fetch_add(1, std::memory_order_relaxed);
+  site.live_blocks.fetch_add(std::llround(weight), std::memory_order_relaxed);
+  site.live_bytes.fetch_add(std::llround(weight * size), std::memory_order_relaxed);
+  site.total_bytes.fetch_add(std::llround(weight * size), std::memory_order_relaxed);
+  return static_cast<std::uint32_t>(index + 1);
+}
+
+//--------------------------------------------------------------------------
+// Allocation
+//--------------------------------------------------------------------------
+
+[[gnu::noinline]] void* allocate(std::size_t size, std::size_t alignment) {
+  // the header sits right before the block, which must stay aligned
+  std::size_t offset{std::max(kHeaderSize, alignment)};
+  if (size > static_cast<std::size_t>(-1) - offset - alignment)
+    return nullptr;
+  void* base{alignment <= alignof(std::max_align_t)
+                 ? std::malloc(offset + size)
+                 : std::aligned_alloc(alignment,
+                                      (offset + size + alignment - 1) & ~(alignment - 1))};
+  if (!base)
+    return nullptr;
+
+  ThreadState& state{thread_state()};
+  Slot& slot{g_slots[state.slot - 1]};
+  const bool shared{state.slot == 1};
+  add<std::int64_t>(slot.live_bytes, static_cast<std::int64_t>(size), shared);
+  add<std::int64_t>(slot.live_blocks, 1, shared);
+  add<std::uint64_t>(slot.total_bytes, size, shared);
+  add<std::uint64_t>(slot.total_blocks, 1, shared);
+
+  std::uint32_t site{0};
+  state.bytes_until_sample -= static_cast<std::int64_t>(std::max<std::size_t>(size, 1));
+  if (state.bytes_until_sample <= 0) {
+    state.bytes_until_sample = next_sample_distance(state);
+    site = record_sample(size);
+  }
+
+  auto block{static_cast<std::byte*>(base) + offset};
+  auto* header{reinterpret_cast<BlockHeader*>(block - kHeaderSize)};
+  header->size = size;
+  header->site = site;
+  header->offset = static_cast<std::uint32_t>(offset);
+  return block;
+}
+
+void deallocate(void* pointer) noexcept {
+  if (!pointer)
+    return;
+  auto block{static_cast<std::byte*>(pointer)};
+  const auto* header{reinterpret_cast<const BlockHeader*>(block - kHeaderSize)};
+  const std::uint64_t size{header->size};
+
+  ThreadState& state{thread_state()};
+  Slot& slot{g_slots[state.slot - 1]};
+  const bool shared{state.slot == 1};
+  add<std::int64_t>(slot.live_bytes, -static_cast<std::int64_t>(size), shared);
+  add<std::int64_t>(slot.live_blocks, -1, shared);
+
+  if (header->site != 0) {
+    Site& site{g_sites[header->site - 1]};
+    double weight{sample_weight(size)};
+    site.sampled_live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    site.live_blocks.fetch_sub(std::llround(weight), std::memory_order_relaxed);
+    site.live_bytes.fetch_sub(std::llround(weight * size), std::memory_order_relaxed);
+  }
+  std::free(block - header->offset);
+}
+
+[[gnu::noinline]] void* allocate_or_throw(std::size_t size, std::size_t alignment) {
+  void* pointer{allocate(size, alignment)};
+  if (!pointer)
+    throw std::bad_alloc{};
+  return pointer;
+}
+
+[[gnu::noinline]] void* allocate_nothrow(std::size_t size,
+                                         std::size_t alignment) noexcept {
+  return allocate(size, alignment);
+}
+
+//--------------------------------------------------------------------------
+// Reports
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Indices of the sites with the most live bytes, largest first
+ */
+std::size_t top_sites(std::array<std::size_t, kTopSites>& top) {
+  std::size_t count{0};
+  for (std::size_t index{0}; index < kMaxSites; ++index) {
+    std::int64_t bytes{g_sites[index].live_bytes.load(std::memory_order_relaxed)};
+    if (g_sites[index].sampled_live_blocks.load(std::memory_order_relaxed) <= 0)
+      continue;
+    // insertion into the sorted top list
+    std::size_t position{count};
+    while (position > 0 &&
+           g_sites[top[position - 1]].live_bytes.load(std::memory_order_relaxed) < bytes) {
+      if (position < kTopSites)
+        top[position] = top[position - 1];
+      --position;
+    }
+    if (position < kTopSites) {
+      top[position] = index;
+      count = std::min(count + 1, kTopSites);
+    }
+  }
+  return count;
+}
+
+void copy_file(const char* path, int fd) {
+  int input{::open(path, O_RDONLY)};
+  if (input < 0)
+    return;
+  char buffer[4096];
+  for (ssize_t count; (count = ::read(input, buffer, sizeof(buffer))) > 0;) {
+    if (::write(fd, buffer, static_cast<std::size_t>(count)) != count)
+      break;
+  }
+  ::close(input);
+}
+
+void signal_handler(int) {
+  int saved_errno{errno};
+  char path[64];
+  {
+    // heap.<pid>.<n>.prof, formatted without snprintf
+    char* out{path};
+    auto append{[&out](const char* text) {
+      while (*text)
+        *out++ = *text++;
+    }};
+    auto append_number{[&out](std::uint64_t value) {
+      char digits[20];
+      int count{0};
+      do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      } while (value != 0);
+      while (count > 0)
+        *out++ = digits[--count];
+    }};
+    append("heap.");
+    append_number(static_cast<std::uint64_t>(::getpid()));
+    append(".");
+    append_number(g_dump_sequence.fetch_add(1));
+    append(".prof");
+    *out = '\0';
+  }
+  int fd{::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+  if (fd >= 0) {
+    week3::profiler::dump_heap_profile(fd);
+    ::close(fd);
+    FdWriter{STDERR_FILENO} << "week3 alloc profiler: heap profile written to "
+                            << path << "\n";
+  }
+  errno = saved_errno;
+}
+
+/**
+ * @brief Read the configuration and install the signal handler
+ */
+bool install() {
+  if (const char* sample{std::getenv("WEEK3_PROFILER_SAMPLE_BYTES")})
+    g_sample_bytes = std::max<std::int64_t>(1, std::atoll(sample));
+  if (const char* quiet{std::getenv("WEEK3_PROFILER_QUIET")})
+    g_quiet = quiet[0] != '\0' && quiet[0] != '0';
+  int signal_number{SIGUSR1};
+  if (const char* number{std::getenv("WEEK3_PROFILER_SIGNAL")})
+    signal_number = std::atoi(number);
+
+  struct sigaction action {};
+  action.sa_handler = signal_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  ::sigaction(signal_number, &action, nullptr);
+  return true;
+}
+
+[[maybe_unused]] const bool g_installed{install()};
+
+/**
+ * @brief Leak report, run from .fini_array so that it comes after the
+ * destructors of static objects, which may still free memory
+ */
+[[gnu::destructor]] void report_at_exit() {
+  if (!g_quiet)
+    week3::profiler::report_leaks(STDERR_FILENO);
+}
+
+}  // namespace
+
+namespace week3::profiler {
+
+HeapStats heap_stats() {
+  HeapStats stats{};
+  for (const Slot& slot : g_slots) {
+    stats.live_bytes += slot.live_bytes.load(std::memory_order_relaxed);
+    stats.live_blocks += slot.live_blocks.load(std::memory_order_relaxed);
+    stats.total_bytes += slot.total_bytes.load(std::memory_order_relaxed);
+    stats.total_blocks += slot.total_blocks.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void dump_heap_profile(int fd) {
+  HeapStats stats{heap_stats()};
+  FdWriter out{fd};
+  out << "heap profile: live_bytes=" << stats.live_bytes
+      << " live_blocks=" << stats.live_blocks
+      << " total_bytes=" << stats.total_bytes
+      << " total_blocks=" << stats.total_blocks
+      << " sample_bytes=" << g_sample_bytes << "\n"
+      << "# est_live_bytes est_live_blocks est_total_bytes @ stack\n";
+  for (std::size_t index{0}; index < kMaxSites; ++index) {
+    const Site& site{g_sites[index]};
+    std::int64_t total{site.total_bytes.load(std::memory_order_relaxed)};
+    if (total == 0)
+      continue;
+    out << site.live_bytes.load(std::memory_order_relaxed) << ' '
+        << site.live_blocks.load(std::memory_order_relaxed) << ' ' << total
+        << " @";
+    if (index == 0 || !site.ready.load(std::memory_order_acquire))
+      out << " (unrecorded)";
+    else
+      for (int frame{0}; frame < site.depth; ++frame)
+        out << ' ' << site.frames[frame];
+    out << "\n";
+  }
+  out << "\nMAPPED_LIBRARIES:\n";
+  out.flush();
+  copy_file("/proc/self/maps", fd);
+}
+
+void report_leaks(int fd) {
+  HeapStats stats{heap_stats()};
+  if (stats.live_blocks <= 0)
+    return;
+  {
+    FdWriter out{fd};
+    out << "week3 alloc profiler: " << stats.live_blocks << " blocks ("
+        << stats.live_bytes << " bytes) still allocated at exit\n";
+    if (g_sample_bytes > 1)
+      out << "  per-site numbers are estimated from one sample every "
+          << g_sample_bytes << " bytes (WEEK3_PROFILER_SAMPLE_BYTES)\n";
+  }
+  std::array<std::size_t, kTopSites> top{};
+  std::size_t count{top_sites(top)};
+  for (std::size_t i{0}; i < count; ++i) {
+    const Site& site{g_sites[top[i]]};
+    {
+      FdWriter out{fd};
+      out << "\n  ~" << site.live_bytes.load(std::memory_order_relaxed)
+          << " bytes in ~" << site.live_blocks.load(std::memory_order_relaxed)
+          << " blocks ("
+          << site.sampled_live_blocks.load(std::memory_order_relaxed)
+          << " sampled) allocated at:\n";
+      if (top[i] == 0 || !site.ready.load(std::memory_order_acquire))
+        out << "    (call stack table full)\n";
+    }
+    if (top[i] != 0 && site.ready.load(std::memory_order_acquire))
+      ::backtrace_symbols_fd(site.frames, site.depth, fd);
+  }
+}
+
+}  // namespace week3::profiler
+
+//--------------------------------------------------------------------------
+// Replacement operator new/delete
+//--------------------------------------------------------------------------
+
+void* operator new(std::size_t size) {
+  return allocate_or_throw(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size) {
+  return allocate_or_throw(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+void operator delete(void* pointer, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
@@ -0,0 +1,493 @@
+/**
+ * @file guard_new.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Guard-page allocator replacing operator new/delete
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * See guard_alloc.hpp for the behavior and the environment variables.
+ *
+ * Layout of the reserved region (one block per row, pages shown as []):
+ *
+ *   [data][data][guard] [data][guard] ...     default
+ *   [guard][data][data] [guard][data] ...     WEEK3_GUARD_PROTECT_BELOW=1
+ *
+ * Pages are handed out with a bump pointer and never reused. The metadata
+ * of every page and block lives in separate arrays (reserved with
+ * MAP_NORESERVE, so only the parts actually used take memory), which the
+ * SIGSEGV handler can read without touching the faulting pages.
+ */
+
+#include "guard_alloc.hpp"
+#include "fd_writer.hpp"
+
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace {
+
+using week3::FdWriter;
+
+constexpr std::size_t kRegionSize{std::size_t{1} << 36};  // 64 GiB of addresses
+constexpr std::size_t kDefaultAlignment{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+constexpr int kMaxFrames{8};
+
+enum class BlockState : std::uint8_t { kLive = 1, kQuarantined, kReleased };
+
+/**
+ * @brief Metadata of one block
+ */
+struct Record {
+  std::byte* user;
+  std::size_t size;
+  std::size_t first_page;  // first data page, as an index in the region
+  std::size_t data_pages;
+  BlockState state;
+  int alloc_depth;
+  int free_depth;
+  void* alloc_frames[kMaxFrames];
+  void* free_frames[kMaxFrames];
+};
+
+/**
+ * @brief State of the allocator; zero-initialized, set up by initialize()
+ */
+struct Region {
+  std::mutex mutex;
+  bool initialized;
+  bool protect_below;
+  bool fell_back;  // some blocks came from malloc
+  std::byte* base;
+  std::size_t page_size;
+  std::size_t pages;
+  std::size_t next_page;
+  std::uint32_t* page_owner;  // record index + 1 for each page, 0 if unused
+  Record* records;
+  std::size_t max_records;
+  std::size_t next_record;
+  std::uint32_t* quarantine;  // ring of record indices
+  std::size_t quarantine_capacity;
+  std::size_t quarantine_head;
+  std::size_t quarantine_count;
+};
+
+Region g_region;
+
+void* map_metadata(std::size_t bytes) {
+  void* memory{::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+
+//--------------------------------------------------------------------------
+// Reports
+//--------------------------------------------------------------------------
+
+void print_frames(const char* title, void* const* frames, int depth) {
+  FdWriter{STDERR_FILENO} << "  " << title << ":\n";
+  if (depth > 0)
+    ::backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+}
+
+[[gnu::noinline]] void print_current_stack(const char* title, int skip) {
+  void* frames[32];
+  int depth{std::max(0, ::backtrace(frames, 32) - skip)};
+  print_frames(title, frames + skip, depth);
+}
+
+void print_block(const Record& record, const std::byte* address) {
+  {
+    FdWriter out{STDERR_FILENO};
+    out << "  " << static_cast<const void*>(address) << " is ";
+    if (address < record.user)
+      out << static_cast<std::uint64_t>(record.user - address) << " bytes before";
+    else if (address >= record.user + record.size)
+      out << static_cast<std::uint64_t>(address - (record.user + record.size))
+          << " bytes after the end of";
+    else
+      out << static_cast<std::uint64_t>(address - record.user) << " bytes inside";
+    out << " a " << static_cast<std::uint64_t>(record.size) << "-byte block at "
+        << static_cast<const void*>(record.user) << '\n';
+  }
+  if (record.state != BlockState::kLive)
+    print_frames("freed by", record.free_frames, record.free_depth);
+  print_frames("allocated by", record.alloc_frames, record.alloc_depth);
+}
+
+[[noreturn]] void report_bad_delete(const char* what, const void* pointer,
+                                    const Record* record) {
+  FdWriter{STDERR_FILENO} << "==week3 guard== " << what << " on "
+                          << pointer << '\n';
+  if (record)
+    print_block(*record, static_cast<const std::byte*>(pointer));
+  // leave out the allocator frames, up to operator delete
+  print_current_stack("deleted by", 4);
+  std::abort();
+}
+
+void warn_fallback(const char* reason) {
+  if (!g_region.fell_back) {
+    FdWriter{STDERR_FILENO} << "==week3 guard== " << reason
+                            << ", further blocks come from malloc unguarded\n";
+  }
+  g_region.fell_back = true;
+}
+
+const Record* record_of(const std::byte* address) {
+  if (!g_region.base || address < g_region.base ||
+      address >= g_region.base + g_region.pages * g_region.page_size)
+    return nullptr;
+  std::size_t page{static_cast<std::size_t>(address - g_region.base) /
+                   g_region.page_size};
+  std::uint32_t owner{g_region.page_owner[page]};
+  return owner == 0 ? nullptr : &g_region.records[owner - 1];
+}
+
+void segv_handler(int signal_number, siginfo_t* info, void* context) {
+  auto address{static_cast<const std::byte*>(info->si_addr)};
+  const char* access{"access"};
+#if defined(__x86_64__)
+  // bit 1 of the page fault error code is set for writes
+  auto* ucontext{static_cast<ucontext_t*>(context)};
+  access = (ucontext->uc_mcontext.gregs[REG_ERR] & 2) ? "WRITE" : "READ";
+#else
+  (void)context;
+#endif
+
+  {
+    FdWriter out{STDERR_FILENO};
+    out << "==week3 guard== " << (signal_number == SIGBUS ? "SIGBUS" : "SEGV")
+        << ": ";
+    const Record* record{record_of(address)};
+    if (reinterpret_cast<std::uintptr_t>(address) < 4096) {
+      out << "null pointer dereference (" << access << " of "
+          << static_cast<const void*>(address) << ")\n";
+    } else if (record && record->state != BlockState::kLive) {
+      out << "heap-use-after-free " << access << " of "
+          << static_cast<const void*>(address);
+      if (record->state == BlockState::kReleased)
+        out << " (block already left the quarantine)";
+      out << '\n';
+    } else if (record) {
+      out << (address < record->user ? "heap-buffer-underflow "
+                                     : "heap-buffer-overflow ")
+          << access << " of " << static_cast<const void*>(address) << '\n';
+    } else {
+      out << access << " of unknown address " << static_cast<const void*>(address)
+          << '\n';
+    }
+    out.flush();
+    if (record)
+      print_block(*record, address);
+  }
+  // leave out the handler frames and the signal trampoline
+  print_current_stack("faulting access", 3);
+
+  // return with the default action, so that the access faults again and
+  // the program dies with the original signal
+  struct sigaction action {};
+  action.sa_handler = SIG_DFL;
+  sigemptyset(&action.sa_mask);
+  ::sigaction(signal_number, &action, nullptr);
+}
+
+//--------------------------------------------------------------------------
+// Setup
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Reserve the region and install the handler; mutex held
+ */
+void initialize() {
+  Region& region{g_region};
+  region.initialized = true;
+  region.page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  region.pages = kRegionSize / region.page_size;
+  region.max_records = region.pages / 2;  // every block takes two pages
+  region.quarantine_capacity = 4096;
+  if (const char* value{std::getenv("WEEK3_GUARD_QUARANTINE")})
+    region.quarantine_capacity = std::max<long long>(1, std::atoll(value));
+  if (const char* value{std::getenv("WEEK3_GUARD_PROTECT_BELOW")})
+    region.protect_below = value[0] != '\0' && value[0] != '0';
+
+  void* base{::mmap(nullptr, kRegionSize, PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+  region.page_owner = static_cast<std::uint32_t*>(
+      map_metadata(region.pages * sizeof(std::uint32_t)));
+  region.records =
+      static_cast<Record*>(map_metadata(region.max_records * sizeof(Record)));
+  region.quarantine = static_cast<std::uint32_t*>(
+      map_metadata(region.quarantine_capacity * sizeof(std::uint32_t)));
+  if (base == MAP_FAILED || !region.page_owner || !region.records ||
+      !region.quarantine) {
+    warn_fallback("cannot reserve the guarded region");
+    return;
+  }
+  region.base = static_cast<std::byte*>(base);
+
+  // run the unwinder once, so that it is loaded before any fault
+  void* frames[1];
+  ::backtrace(frames, 1);
+
+  // the handler runs on its own stack in case the fault is a stack overflow
+  stack_t alternate{};
+  alternate.ss_size = 64 * 1024;
+  alternate.ss_sp = map_metadata(alternate.ss_size);
+  if (alternate.ss_sp)
+    ::sigaltstack(&alternate, nullptr);
+
+  struct sigaction action {};
+  action.sa_sigaction = segv_handler;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  ::sigaction(SIGSEGV, &action, nullptr);
+  ::sigaction(SIGBUS, &action, nullptr);
+}
+
+/**
+ * @brief Install the handler at startup, so that faults on pointers that
+ * never came from new (e.g. snippet 17's null pointer) are explained too
+ */
+bool install() {
+  std::lock_guard<std::mutex> lock{g_region.mutex};
+  if (!g_region.initialized)
+    initialize();
+  return true;
+}
+
+[[maybe_unused]] const bool g_installed{install()};
+
+//--------------------------------------------------------------------------
+// Allocation
+//--------------------------------------------------------------------------
+
+void* allocate_unguarded(std::size_t size, std::size_t alignment) {
+  if (alignment <= alignof(std::max_align_t))
+    return std::malloc(size);
+  return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+}
+
+/**
+ * @brief Allocate a guarded block
+ *
+ * @param skip Frames of the allocator itself to leave out of the call stack
+ */
+[[gnu::noinline]] void* allocate_block(std::size_t size, std::size_t alignment,
+                                       int skip) noexcept {
+  void* frames[kMaxFrames + 4];
+  int depth{std::max(0, ::backtrace(frames, kMaxFrames + skip) - skip)};
+
+  Region& region{g_region};
+  std::lock_guard<std::mutex> lock{region.mutex};
+  if (!region.initialized)
+    initialize();
+  if (!region.base)
+    return allocate_unguarded(size, alignment);
+  if (alignment > region.page_size) {
+    // the delete of this block must not be reported as a bad delete
+    warn_fallback("alignment larger than a page");
+    return allocate_unguarded(size, alignment);
+  }
+
+  const std::size_t bytes{std::max<std::size_t>(size, 1)};
+  const std::size_t data_pages{(bytes + region.page_size - 1) / region.page_size};
+  if (region.next_page + data_pages + 1 > region.pages ||
+      region.next_record == region.max_records) {
+    warn_fallback("guarded region exhausted");
+    return allocate_unguarded(size, alignment);
+  }
+
+  const std::size_t first_page{region.next_page + (region.protect_below ? 1 : 0)};
+  std::byte* data{region.base + first_page * region.page_size};
+  if (::mprotect(data, data_pages * region.page_size, PROT_READ | PROT_WRITE) != 0) {
+    warn_fallback("cannot map more guarded pages (see vm.max_map_count)");
+    return allocate_unguarded(size, alignment);
+  }
+  region.next_page += data_pages + 1;
+
+  // right-align the block against the guard page, or left-align it when the
+  // guard page is below
+  std::byte* user{data};
+  if (!region.protect_below) {
+    std::size_t rounded{(bytes + alignment - 1) & ~(alignment - 1)};
+    user = data + data_pages * region.page_size - rounded;
+  }
+
+  const std::size_t index{region.next_record++};
+  Record& record{region.records[index]};
+  record.user = user;
+  record.size = size;
+  record.first_page = first_page;
+  record.data_pages = data_pages;
+  record.state = BlockState::kLive;
+  record.alloc_depth = depth;
+  std::copy(frames + skip, frames + skip + depth, record.alloc_frames);
+
+  // the guard page belongs to the block as well, to explain overflows
+  const std::size_t guard_page{region.protect_below ? first_page - 1
+                                                    : first_page + data_pages};
+  for (std::size_t page{first_page}; page < first_page + data_pages; ++page)
+    region.page_owner[page] = static_cast<std::uint32_t>(index + 1);
+  region.page_owner[guard_page] = static_cast<std::uint32_t>(index + 1);
+  return user;
+}
+
+/**
+ * @brief Move a block out of the quarantine and give its memory back
+ */
+void release(Record& record) {
+  Region& region{g_region};
+  ::madvise(region.base + record.first_page * region.page_size,
+            record.data_pages * region.page_size, MADV_DONTNEED);
+  record.state = BlockState::kReleased;
+}
+
+[[gnu::noinline]] void deallocate_block(void* pointer, int skip) noexcept {
+  if (!pointer)
+    return;
+  Region& region{g_region};
+  auto address{static_cast<std::byte*>(pointer)};
+  if (!week3::guard::owns(pointer)) {
+    // before any fallback, every block came from the region
+    if (!region.fell_back)
+      report_bad_delete("delete of memory not allocated by new", pointer, nullptr);
+    std::free(pointer);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock{region.mutex};
+  const Record* found{record_of(address)};
+  if (!found)
+    report_bad_delete("delete of an address in no block", pointer, nullptr);
+  Record& record{const_cast<Record&>(*found)};
+  if (record.state != BlockState::kLive)
+    report_bad_delete("double delete", pointer, &record);
+  if (record.user != address)
+    report_bad_delete("delete of a pointer inside a block", pointer, &record);
+
+  void* frames[kMaxFrames + 2];
+  record.free_depth = std::max(0, ::backtrace(frames, kMaxFrames + skip) - skip);
+  std::copy(frames + skip, frames + skip + record.free_depth, record.free_frames);
+
+  ::mprotect(region.base + record.first_page * region.page_size,
+             record.data_pages * region.page_size, PROT_NONE);
+  record.state = BlockState::kQuarantined;
+
+  // bounded quarantine: the oldest block gives its memory back
+  if (region.quarantine_count == region.quarantine_capacity) {
+    release(region.records[region.quarantine[region.quarantine_head]]);
+    region.quarantine_head = (region.quarantine_head + 1) % region.quarantine_capacity;
+    --region.quarantine_count;
+  }
+  std::size_t tail{(region.quarantine_head + region.quarantine_count) %
+                   region.quarantine_capacity};
+  region.quarantine[tail] = static_cast<std::uint32_t>(&record - region.records);
+  ++region.quarantine_count;
+}
+
+[[gnu::noinline]] void* allocate_or_throw(std::size_t size, std::size_t alignment) {
+  void* pointer{allocate_block(size, alignment, 3)};
+  if (!pointer)
+    throw std::bad_alloc{};
+  return pointer;
+}
+
+[[gnu::noinline]] void* allocate_nothrow(std::size_t size,
+                                         std::size_t alignment) noexcept {
+  return allocate_block(size, alignment, 3);
+}
+
+}  // namespace
+
+namespace week3::guard {
+
+void* allocate(std::size_t size, std::size_t alignment) noexcept {
+  return allocate_block(size, alignment, 2);
+}
+
+void deallocate(void* pointer) noexcept { deallocate_block(pointer, 2); }
+
+bool owns(const void* pointer) noexcept {
+  auto address{static_cast<const std::byte*>(pointer)};
+  return g_region.base && address >= g_region.base &&
+         address < g_region.base + kRegionSize;
+}
+
+}  // namespace week3::guard
+
+//--------------------------------------------------------------------------
+// Replacement operator new/delete
+//--------------------------------------------------------------------------
+
+void* operator new(std::size_t size) {
+  return allocate_or_throw(size, kDefaultAlignment);
+}
+void* operator new[](std::size_t size) {
+  return allocate_or_throw(size, kDefaultAlignment);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, kDefaultAlignment);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, kDefaultAlignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { deallocate_block(pointer, 2); }
+void operator delete[](void* pointer) noexcept { deallocate_block(pointer, 2); }
+void operator delete(void* pointer, std::size_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete(void* pointer, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  deallocate_block(pointer, 2);
+}
+void operator delete[](void* pointer, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  deallocate_block(pointer, 2);
+}
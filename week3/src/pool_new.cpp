@@ -0,0 +1,118 @@
+/**
+ * @file pool_new.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Replace the global operator new/delete with the week3 pool
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Linked into an executable through the week3_pool_new object library, e.g.
+ * with `cmake -DWEEK3_OPERATOR_NEW=pool`. Over-aligned requests bypass the
+ * pool and use std::aligned_alloc, which pool::deallocate() hands back to
+ * std::free since the pointer is outside the pool region.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "week3.hpp"
+
+namespace {
+
+void *allocate_or_throw(std::size_t size) {
+  void *pointer{week3::pool::allocate(size)};
+  if (!pointer)
+    throw std::bad_alloc{};
+  return pointer;
+}
+
+void *allocate_aligned_or_throw(std::size_t size, std::align_val_t alignment) {
+  auto align{static_cast<std::size_t>(alignment)};
+  if (align <= week3::pool::kGranularity)
+    return allocate_or_throw(size);
+  // aligned_alloc requires the size to be a multiple of the alignment
+  void *pointer{std::aligned_alloc(align, (size + align - 1) & ~(align - 1))};
+  if (!pointer)
+    throw std::bad_alloc{};
+  return pointer;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return allocate_or_throw(size); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return allocate_or_throw(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+  return operator new(size, tag);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_aligned_or_throw(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_aligned_or_throw(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  try {
+    return allocate_aligned_or_throw(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &tag) noexcept {
+  return operator new(size, alignment, tag);
+}
+
+void operator delete(void *pointer) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete(void *pointer, std::size_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer, std::size_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer, std::size_t,
+                       std::align_val_t) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete(void *pointer, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  week3::pool::deallocate(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  week3::pool::deallocate(pointer);
+}
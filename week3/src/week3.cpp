@@ -7,177 +7,273 @@
  *
  * @copyright Copyright (c) 2025
  *
+ * Run a snippet with `week3_cpp --run <id>` (see `week3_cpp --list`).
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <typeinfo> // needed for typeid
 
-int main() {
-  // //======== 1
-  // int a{10};
-  // int *p{&a};
-  // std::cout << &a << '\n';
-  // std::cout << p << '\n';
-
-  // //======== 2
-  // int a{10};
-  // std::cout << typeid(&a).name() << '\n';
-  // // //==============
-  // int *p;
-  // std::cout << typeid(p).name() << '\n';
-
-  // //======== 3
-  // int *p1{nullptr}; // nullptr literal (from C++)
-  // int *p2{NULL};    // NULL macro (from C)
-  // int *p3{0};       // value initialization
-  // int *p4{};        // zero initialization
-
-  // //======== 4
-  // int a{3};
-  // int *p1{&a};
-  // int *p2{nullptr};
-  // if (p1 != p2)
-  //   std::cout << "p1 is not null\n";
-  // else
-  //   std::cout << "p1 is null\n";
-
-  // //======== 5
-  // int a{10};
-  // std::cout << &a << '\n';    // 0x7fffffffdb3c
-  // std::cout << *(&a) << '\n'; // What is the output?
-
-  // int *p{&a};
-  // std::cout << p << '\n';  // 0x7fffffffdb3c
-  // std::cout << *p << '\n'; // What is the output?
-
-  // //======== 6
-  // int i{10};
-  // double d{10.0};
-  // float f{10.0f};
-  // char c{'a'};
-
-  // int *p{&i};
-  // double *q{&d};
-  // float *r{&f};
-  // char *s{&c};
-
-  // std::cout << sizeof(p) << '\n';
-  // std::cout << sizeof(q) << '\n';
-  // std::cout << sizeof(r) << '\n';
-  // std::cout << sizeof(s) << '\n';
-
-  // //======== 7
-  // int a{5};
-  // double b{2.5};
-  // int *p{nullptr}; // OK
-  // p = &a;          // OK
-  // p = &b;          // Error
-
-  // //======== 8
-  // int a{2};
-  // int b{3};
-
-  // /* pointer to const */
-  // const int *p1;
-  // p1 = &a; // OK
-  // p1 = &b; // OK
-  // *p1 = 3; // Error
-
-  // /* const pointer */
-  // int *const p2{&a};
-  // *p2 = 3; // OK
-  // p2 = &b; // Error
-
-  // /* const pointer to const */
-  // const int *const p3{&a};
-  // *p3 = 3; // Error
-  // p3 = &b; // Error
-
-  // //======== 9
-  // int *p; // p is a wild pointer. It holds a garbage memory address.
-
-  // // The following line is UNDEFINED BEHAVIOR.
-  // // We are attempting to write the value 100 to an unknown memory address.
-  // *p = 100;
-  // // The program might crash here, or it might seem to continue,
-  // // having corrupted some unknown part of memory.
-  // std::cout << "This line may or may not be reached.\n";
-
-  // //======== 10
-  // int *p{new int{15}};
-  // std::cout << p << '\n'; // 0x55555556b2b0
-  // delete p;
-  // std::cout << p << '\n';  // 0x55555556b2b0
-  // std::cout << *p << '\n'; // UB
-
-  // //======== 11
-  // int *p{new int{5}}; // allocate and point to data on the heap
-  // delete p;           // free the heap memory
-  // int a{2};           // create a is on the stack
-  // p = &a;             // point to data on the stack
-  // p = new int{3};     // allocate and point to data on the heap
-  // delete p;           // free the heap memory
-  // p = nullptr;        // null pointer
-
-  // //======== 12
-  // int a{3};
-  // int *p{&a};
-  // delete p; // UB
-
-  // //======== 13
-  // int *p{nullptr};
-  // delete p; // safe to delete a null pointer
-
-  // //======== 14
-  // int *p{new int{2}};
-  // delete p;                // p is dangling
-  // *p = 5;                  // UB
-  // std::cout << *p << '\n'; // UB
-
-  // //======== 15
-  // int *p = nullptr;
-
-  // { // Inner scope starts
-  //     int inner_variable{5};
-  //     p = &inner_variable;
-  //     std::cout << "Inside scope: " << *p << '\n';
-  // } // Inner scope ends, `inner_variable` is destroyed.
-  // // UB: Accessing memory that is out of scope.
-  // std::cout << "Outside scope: " << *p << '\n';
-
-  // // ======== 16
-  // for (int i{0}; i < 100000; ++i)
-  // {
-  //     // In each iteration, we allocate a new integer.
-  //     // But we never deallocate the memory from the previous iteration.
-  //     int *p{new int(i)};
-  // }
-
-  // //======== 17
-  // int *p{nullptr};
-  // std::cout << *p << '\n'; // UB
-
-  // //======== 18
-  // int &ref{};
-
-  // //======== 19
-  // int a{10};
-  // int &ref{a};              // ref is a reference to a
-  // ref = 20;                 // a is now 20
-  // std::cout << a << '\n';   // 20
-  // a = 30;                   // ref is now 30
-  // std::cout << ref << '\n'; // 30
-
-  // //======== 20
-  // int a{10};
-  // int &ref{a};               // ref is a reference to a
-  // std::cout << &a << '\n';   // 0x7fffffffdadc
-  // std::cout << &ref << '\n'; // 0x7fffffffdadc
-
-  // //======== 21
-  // int a{10};
-  // int &ref{a};               // ref is a reference to a
-  // int b{3};
-  // ref = b; // This assigns the value of b to a
-}
\ No newline at end of file
+#include "compact_arena.hpp"
+#include "snippets.hpp"
+
+using enpm702::kSnippetUndefined;
+
+//======== 1
+SNIPPET("1") {
+  int a{10};
+  int *p{&a};
+  std::cout << &a << '\n';
+  std::cout << p << '\n';
+}
+
+//======== 2
+SNIPPET("2") {
+  int a{10};
+  std::cout << typeid(&a).name() << '\n';
+  // //==============
+  int *p;
+  std::cout << typeid(p).name() << '\n';
+}
+
+//======== 3
+SNIPPET("3") {
+  [[maybe_unused]] int *p1{nullptr}; // nullptr literal (from C++)
+  [[maybe_unused]] int *p2{NULL};    // NULL macro (from C)
+  [[maybe_unused]] int *p3{0};       // value initialization
+  [[maybe_unused]] int *p4{};        // zero initialization
+}
+
+//======== 4
+SNIPPET("4") {
+  int a{3};
+  int *p1{&a};
+  int *p2{nullptr};
+  if (p1 != p2)
+    std::cout << "p1 is not null\n";
+  else
+    std::cout << "p1 is null\n";
+}
+
+//======== 5
+SNIPPET("5") {
+  int a{10};
+  std::cout << &a << '\n';    // 0x7fffffffdb3c
+  std::cout << *(&a) << '\n'; // What is the output?
+
+  int *p{&a};
+  std::cout << p << '\n';  // 0x7fffffffdb3c
+  std::cout << *p << '\n'; // What is the output?
+}
+
+//======== 6
+SNIPPET("6") {
+  int i{10};
+  double d{10.0};
+  float f{10.0f};
+  char c{'a'};
+
+  int *p{&i};
+  double *q{&d};
+  float *r{&f};
+  char *s{&c};
+
+  std::cout << sizeof(p) << '\n';
+  std::cout << sizeof(q) << '\n';
+  std::cout << sizeof(r) << '\n';
+  std::cout << sizeof(s) << '\n';
+}
+
+//======== 6-compact
+// The pointers of snippet 6 as 32-bit offsets into a week3::CompactArena
+struct CompactNode {
+  week3::OffsetPtr<CompactNode> left;
+  week3::OffsetPtr<CompactNode> right;
+  int value;
+};
+
+SNIPPET("6-compact") {
+  week3::CompactArena arena{std::size_t{1} << 20};
+  CompactNode *raw{arena.make<CompactNode>(nullptr, nullptr, 1)};
+  week3::OffsetPtr<CompactNode> root{raw};
+  root->left = arena.make<CompactNode>(nullptr, nullptr, 0);
+
+  std::cout << sizeof(root) << '\n';        // 4
+  std::cout << sizeof(CompactNode) << '\n'; // 12
+  std::cout << (root == raw) << (raw == root) << '\n';               // 11
+  std::cout << (root->left != raw) << (raw != root->left) << '\n';   // 11
+  std::cout << (nullptr == root->right) << (nullptr != root->left) << '\n'; // 11
+}
+
+// Snippets 7 and 8 do not compile on purpose, so they stay commented out.
+
+// //======== 7
+// int a{5};
+// double b{2.5};
+// int *p{nullptr}; // OK
+// p = &a;          // OK
+// p = &b;          // Error
+
+// //======== 8
+// int a{2};
+// int b{3};
+
+// /* pointer to const */
+// const int *p1;
+// p1 = &a; // OK
+// p1 = &b; // OK
+// *p1 = 3; // Error
+
+// /* const pointer */
+// int *const p2{&a};
+// *p2 = 3; // OK
+// p2 = &b; // Error
+
+// /* const pointer to const */
+// const int *const p3{&a};
+// *p3 = 3; // Error
+// p3 = &b; // Error
+
+//======== 9
+// writes through a wild pointer on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+SNIPPET("9", kSnippetUndefined) {
+  int *p; // p is a wild pointer. It holds a garbage memory address.
+
+  // The following line is UNDEFINED BEHAVIOR.
+  // We are attempting to write the value 100 to an unknown memory address.
+  *p = 100;
+  // The program might crash here, or it might seem to continue,
+  // having corrupted some unknown part of memory.
+  std::cout << "This line may or may not be reached.\n";
+}
+#pragma GCC diagnostic pop
+
+//======== 10
+SNIPPET("10", kSnippetUndefined) {
+  int *p{new int{15}};
+  std::cout << p << '\n'; // 0x55555556b2b0
+  delete p;
+  std::cout << p << '\n';  // 0x55555556b2b0
+  std::cout << *p << '\n'; // UB
+}
+
+//======== 11
+SNIPPET("11") {
+  int *p{new int{5}}; // allocate and point to data on the heap
+  delete p;           // free the heap memory
+  int a{2};           // create a is on the stack
+  p = &a;             // point to data on the stack
+  p = new int{3};     // allocate and point to data on the heap
+  delete p;           // free the heap memory
+  p = nullptr;        // null pointer
+}
+
+//======== 12
+// deletes a stack variable on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfree-nonheap-object"
+SNIPPET("12", kSnippetUndefined) {
+  int a{3};
+  int *p{&a};
+  delete p; // UB
+}
+#pragma GCC diagnostic pop
+
+//======== 13
+SNIPPET("13") {
+  int *p{nullptr};
+  delete p; // safe to delete a null pointer
+}
+
+//======== 13-aligned
+// new and delete of a type aligned beyond a page: the guarded executables
+// hand such blocks to malloc, and must accept their delete
+struct alignas(8192) PageAligned {
+  char bytes[100];
+};
+
+SNIPPET("13-aligned") {
+  PageAligned *p{new PageAligned{}};
+  std::cout << (reinterpret_cast<std::uintptr_t>(p) % alignof(PageAligned)) << '\n'; // 0
+  delete p;
+}
+
+//======== 14
+SNIPPET("14", kSnippetUndefined) {
+  int *p{new int{2}};
+  delete p;                // p is dangling
+  *p = 5;                  // UB
+  std::cout << *p << '\n'; // UB
+}
+
+//======== 15
+// reads through a dangling pointer on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdangling-pointer"
+SNIPPET("15", kSnippetUndefined) {
+  int *p = nullptr;
+
+  { // Inner scope starts
+      int inner_variable{5};
+      p = &inner_variable;
+      std::cout << "Inside scope: " << *p << '\n';
+  } // Inner scope ends, `inner_variable` is destroyed.
+  // UB: Accessing memory that is out of scope.
+  std::cout << "Outside scope: " << *p << '\n';
+}
+#pragma GCC diagnostic pop
+
+// ======== 16
+SNIPPET("16") {
+  for (int i{0}; i < 100000; ++i)
+  {
+      // In each iteration, we allocate a new integer.
+      // But we never deallocate the memory from the previous iteration.
+      [[maybe_unused]] int *p{new int(i)};
+  }
+}
+
+//======== 17
+SNIPPET("17", kSnippetUndefined) {
+  int *p{nullptr};
+  std::cout << *p << '\n'; // UB
+}
+
+// Snippet 18 does not compile on purpose, so it stays commented out.
+
+// //======== 18
+// int &ref{};
+
+//======== 19
+SNIPPET("19") {
+  int a{10};
+  int &ref{a};              // ref is a reference to a
+  ref = 20;                 // a is now 20
+  std::cout << a << '\n';   // 20
+  a = 30;                   // ref is now 30
+  std::cout << ref << '\n'; // 30
+}
+
+//======== 20
+SNIPPET("20") {
+  int a{10};
+  int &ref{a};               // ref is a reference to a
+  std::cout << &a << '\n';   // 0x7fffffffdadc
+  std::cout << &ref << '\n'; // 0x7fffffffdadc
+}
+
+//======== 21
+SNIPPET("21") {
+  int a{10};
+  int &ref{a};               // ref is a reference to a
+  int b{3};
+  ref = b; // This assigns the value of b to a
+}
+
+int main(int argc, char *argv[]) {
+  return enpm702::run_snippets(argc, argv);
+}
@@ -0,0 +1,628 @@
+/**
+ * @file week3_bench.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Microbenchmarks for the lecture 3 snippets
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <random>
+#include <thread>
+
+#include <unistd.h>
+#include <vector>
+
+#include "bench.hpp"
+#include "compact_arena.hpp"
+#include "nd_array.hpp"
+#include "scoped_arena.hpp"
+#include "slot_map.hpp"
+#include "week3.hpp"
+
+using enpm702::bench::clobber_memory;
+using enpm702::bench::do_not_optimize;
+
+//======== 5: dereferencing a pointer to a stack variable
+BENCHMARK("pointer/dereference") {
+  int a{10};
+  int *p{&a};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    do_not_optimize(p);
+    int value{*p};
+    do_not_optimize(value);
+  }
+}
+
+//======== 11: one new/delete pair
+BENCHMARK("heap/new_delete_int") {
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    int *p{new int{5}};
+    do_not_optimize(p);
+    delete p;
+    clobber_memory();
+  }
+}
+
+//======== 16: the allocation loop, with the leak fixed so it can be repeated
+BENCHMARK("heap/snippet16_loop") {
+  constexpr int kCount{100000};
+  std::vector<int *> pointers(kCount);
+  state.set_items_per_iteration(kCount);
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    for (int i{0}; i < kCount; ++i)
+      pointers[i] = new int(i);
+    clobber_memory();
+    for (int *p : pointers)
+      delete p;
+  }
+}
+
+//======== 16: the same loop on 1, 4 and 16 threads, glibc malloc vs the pool
+namespace {
+
+template <typename Allocate, typename Deallocate>
+void snippet16_loop(std::uint64_t iterations, Allocate allocate,
+                    Deallocate deallocate) {
+  constexpr int kCount{100000};
+  std::vector<int *> pointers(kCount);
+  for (std::uint64_t n{0}; n < iterations; ++n) {
+    for (int i{0}; i < kCount; ++i)
+      pointers[i] = allocate(i);
+    clobber_memory();
+    for (int *p : pointers)
+      deallocate(p);
+  }
+}
+
+template <typename Allocate, typename Deallocate>
+void run_on_threads(enpm702::bench::State &state, int threads,
+                    Allocate allocate, Deallocate deallocate) {
+  state.set_items_per_iteration(100000.0 * threads);
+  std::vector<std::thread> workers;
+  for (int t{0}; t < threads; ++t) {
+    workers.emplace_back([&state, allocate, deallocate] {
+      snippet16_loop(state.iterations(), allocate, deallocate);
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+}
+
+[[maybe_unused]] const bool threaded_benchmarks_registered{[] {
+  for (int threads : {1, 4, 16}) {
+    std::string suffix{"/threads:" + std::to_string(threads)};
+    enpm702::bench::register_benchmark(
+        "heap/snippet16_malloc" + suffix, [threads](auto &state) {
+          run_on_threads(
+              state, threads, [](int i) { return new int(i); },
+              [](int *p) { delete p; });
+        });
+    enpm702::bench::register_benchmark(
+        "heap/snippet16_pool" + suffix, [threads](auto &state) {
+          run_on_threads(
+              state, threads,
+              [](int i) {
+                return new (week3::pool::allocate(sizeof(int))) int(i);
+              },
+              [](int *p) { week3::pool::deallocate(p); });
+        });
+  }
+  return true;
+}()};
+
+} // namespace
+
+//======== 16: a node-based container on the pool
+BENCHMARK("heap/list_push_pop_std_allocator") {
+  std::list<int> values;
+  state.set_items_per_iteration(1000);
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    for (int i{0}; i < 1000; ++i)
+      values.push_back(i);
+    values.clear();
+  }
+}
+
+BENCHMARK("heap/list_push_pop_pool_allocator") {
+  std::list<int, week3::PoolAllocator<int>> values;
+  state.set_items_per_iteration(1000);
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    for (int i{0}; i < 1000; ++i)
+      values.push_back(i);
+    values.clear();
+  }
+}
+
+//======== 15: per-request temporaries with the lifetime of a scope
+namespace {
+
+/**
+ * @brief Work of one request: a list of @p items nodes, a vector grown one
+ * element at a time and a few strings, all dropped at the end
+ */
+template <template <typename> typename Allocator, typename... Resource>
+void handle_request(int items, Resource *...resource) {
+  std::list<int, Allocator<int>> nodes{Allocator<int>{resource...}};
+  std::vector<int, Allocator<int>> values{Allocator<int>{resource...}};
+  using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+  std::vector<String, Allocator<String>> names{Allocator<String>{resource...}};
+  for (int i{0}; i < items; ++i) {
+    nodes.push_back(i);
+    values.push_back(i);
+    if (i % 16 == 0)
+      names.emplace_back("a name longer than the small-string buffer");
+  }
+  do_not_optimize(nodes.back());
+  do_not_optimize(values.back());
+}
+
+[[maybe_unused]] const bool arena_benchmarks_registered{[] {
+  for (int items : {32, 1024}) {
+    std::string suffix{"/items:" + std::to_string(items)};
+    enpm702::bench::register_benchmark(
+        "arena/new_delete" + suffix, [items](auto &state) {
+          for (std::uint64_t n{0}; n < state.iterations(); ++n)
+            handle_request<std::allocator>(items);
+        });
+    enpm702::bench::register_benchmark(
+        "arena/monotonic_buffer_resource" + suffix, [items](auto &state) {
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            alignas(std::max_align_t) std::byte buffer[4096];
+            std::pmr::monotonic_buffer_resource resource{buffer, sizeof(buffer)};
+            handle_request<std::pmr::polymorphic_allocator>(items, &resource);
+          }
+        });
+    enpm702::bench::register_benchmark(
+        "arena/scoped_arena" + suffix, [items](auto &state) {
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            week3::ScopedArena<4096> arena;
+            handle_request<std::pmr::polymorphic_allocator>(items, &arena);
+          }
+        });
+  }
+  return true;
+}()};
+
+} // namespace
+
+//======== exercises 6-7: objects reached through pointers vs slot map handles
+namespace {
+
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+};
+
+Particle make_particle(int i) {
+  auto f{static_cast<float>(i)};
+  return Particle{f, f, f, 1.0f, 0.5f, 0.25f};
+}
+
+void advance(Particle &p) {
+  p.x += p.vx;
+  p.y += p.vy;
+  p.z += p.vz;
+}
+
+/**
+ * @brief Objects allocated one by one, owned through pointers visited in a
+ * shuffled order, as in an object graph built over time
+ */
+struct PointerLayout {
+  explicit PointerLayout(int count) {
+    for (int i{0}; i < count; ++i)
+      objects.push_back(new Particle{make_particle(i)});
+    std::shuffle(objects.begin(), objects.end(), std::mt19937{42});
+  }
+  ~PointerLayout() {
+    for (Particle *p : objects)
+      delete p;
+  }
+  std::vector<Particle *> objects;
+};
+
+/**
+ * @brief std::list whose node order was shuffled after allocation
+ */
+std::list<Particle> make_shuffled_list(int count) {
+  std::list<Particle> built;
+  std::vector<std::list<Particle>::iterator> nodes;
+  for (int i{0}; i < count; ++i)
+    nodes.push_back(built.insert(built.end(), make_particle(i)));
+  std::shuffle(nodes.begin(), nodes.end(), std::mt19937{42});
+  std::list<Particle> shuffled;
+  for (auto node : nodes)
+    shuffled.splice(shuffled.end(), built, node);
+  return shuffled;
+}
+
+/**
+ * @brief Slot map that went through erase/insert churn, so that slots,
+ * handles and packed positions no longer line up
+ */
+week3::SlotMap<Particle> make_slot_map(int count,
+                                       std::vector<week3::SlotHandle> &handles) {
+  week3::SlotMap<Particle> map;
+  for (int i{0}; i < count; ++i)
+    handles.push_back(map.insert(make_particle(i)));
+  std::mt19937 generator{42};
+  for (int i{0}; i < count / 2; ++i) {
+    auto &handle{handles[generator() % handles.size()]};
+    map.erase(handle);
+    handle = map.insert(make_particle(i));
+  }
+  std::shuffle(handles.begin(), handles.end(), generator);
+  return map;
+}
+
+[[maybe_unused]] const bool slot_map_benchmarks_registered{[] {
+  for (int count : {10000, 1000000}) {
+    std::string suffix{"/objects:" + std::to_string(count)};
+    enpm702::bench::register_benchmark(
+        "objects/iterate_list" + suffix, [count](auto &state) {
+          state.pause_timing();
+          auto objects{make_shuffled_list(count)};
+          state.resume_timing();
+          state.set_items_per_iteration(count);
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            for (auto &p : objects)
+              advance(p);
+            clobber_memory();
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "objects/iterate_pointers" + suffix, [count](auto &state) {
+          state.pause_timing();
+          PointerLayout layout{count};
+          state.resume_timing();
+          state.set_items_per_iteration(count);
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            for (Particle *p : layout.objects)
+              advance(*p);
+            clobber_memory();
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "objects/iterate_slot_map" + suffix, [count](auto &state) {
+          state.pause_timing();
+          std::vector<week3::SlotHandle> handles;
+          auto map{make_slot_map(count, handles)};
+          state.resume_timing();
+          state.set_items_per_iteration(count);
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            for (auto &p : map)
+              advance(p);
+            clobber_memory();
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "objects/lookup_slot_map_handles" + suffix, [count](auto &state) {
+          state.pause_timing();
+          std::vector<week3::SlotHandle> handles;
+          auto map{make_slot_map(count, handles)};
+          state.resume_timing();
+          state.set_items_per_iteration(count);
+          for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+            for (auto handle : handles)
+              advance(*map.get(handle));
+            clobber_memory();
+          }
+          state.pause_timing();
+        });
+  }
+  return true;
+}()};
+
+} // namespace
+
+//======== 6: 8-byte pointers vs 32-bit offsets in a pointer-heavy tree
+namespace {
+
+struct RawNode {
+  RawNode *left;
+  RawNode *right;
+  int value;
+};
+
+struct CompactNode {
+  week3::OffsetPtr<CompactNode> left;
+  week3::OffsetPtr<CompactNode> right;
+  int value;
+};
+
+static_assert(sizeof(CompactNode) == 12, "two 32-bit offsets and an int");
+
+/**
+ * @brief Resident memory of the process, in bytes
+ */
+double resident_bytes() {
+  long pages[2]{};
+  if (FILE *file{std::fopen("/proc/self/statm", "r")}) {
+    if (std::fscanf(file, "%ld %ld", &pages[0], &pages[1]) != 2)
+      pages[1] = 0;
+    std::fclose(file);
+  }
+  return static_cast<double>(pages[1]) * static_cast<double>(::sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * @brief Binary search tree of shuffled keys, so that allocation order and
+ * traversal order differ as in a tree built over time
+ */
+template <typename Node, typename Make>
+Node *build_tree(const std::vector<int> &keys, Make make) {
+  Node *root{nullptr};
+  for (int key : keys) {
+    Node *node{make(key)};
+    if (!root) {
+      root = node;
+      continue;
+    }
+    Node *parent{root};
+    while (true) {
+      auto &child{key < parent->value ? parent->left : parent->right};
+      if (!child) {
+        child = node;
+        break;
+      }
+      parent = child;
+    }
+  }
+  return root;
+}
+
+template <typename Node>
+std::int64_t sum_tree(const Node *node) {
+  std::int64_t sum{0};
+  while (node) {
+    sum += node->value + sum_tree<Node>(node->left);
+    node = node->right;
+  }
+  return sum;
+}
+
+/**
+ * @brief A tree built once per process, with the memory it made resident
+ */
+template <typename Node>
+struct TreeFixture {
+  Node *root;
+  double resident;
+};
+
+constexpr int kTreeNodes{1 << 20};
+
+const std::vector<int> &shuffled_keys() {
+  static const std::vector<int> keys{[] {
+    std::vector<int> keys(kTreeNodes);
+    for (int i{0}; i < kTreeNodes; ++i)
+      keys[i] = i;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+    return keys;
+  }()};
+  return keys;
+}
+
+template <typename Node>
+void traverse(enpm702::bench::State &state, const TreeFixture<Node> &tree) {
+  state.set_items_per_iteration(kTreeNodes);
+  state.set_counter("resident_MiB", tree.resident / (1024.0 * 1024.0));
+  state.set_counter("bytes/node", tree.resident / kTreeNodes);
+  for (std::uint64_t n{0}; n < state.iterations(); ++n)
+    do_not_optimize(sum_tree(tree.root));
+}
+
+const TreeFixture<RawNode> &raw_tree() {
+  static const TreeFixture<RawNode> tree{[] {
+    const auto &keys{shuffled_keys()};
+    double before{resident_bytes()};
+    RawNode *root{build_tree<RawNode>(
+        keys, [](int key) { return new RawNode{nullptr, nullptr, key}; })};
+    return TreeFixture<RawNode>{root, resident_bytes() - before};
+  }()};
+  return tree;
+}
+
+const TreeFixture<CompactNode> &compact_tree() {
+  static week3::CompactArena arena;
+  static const TreeFixture<CompactNode> tree{[] {
+    const auto &keys{shuffled_keys()};
+    double before{resident_bytes()};
+    CompactNode *root{build_tree<CompactNode>(keys, [](int key) {
+      return arena.make<CompactNode>(nullptr, nullptr, key);
+    })};
+    return TreeFixture<CompactNode>{root, resident_bytes() - before};
+  }()};
+  return tree;
+}
+
+} // namespace
+
+BENCHMARK("tree/traverse_raw_pointers_new") {
+  state.pause_timing();
+  const auto &tree{raw_tree()};
+  state.resume_timing();
+  traverse(state, tree);
+}
+
+BENCHMARK("tree/traverse_offset_pointers_arena") {
+  state.pause_timing();
+  const auto &tree{compact_tree()};
+  state.resume_timing();
+  traverse(state, tree);
+}
+
+//======== exercise 2-2: int*** chains vs one contiguous 3-D array
+namespace {
+
+/**
+ * @brief n x n x n ints allocated as an array of pointers to arrays of
+ * pointers to rows, each level with its own new[]
+ */
+struct JaggedArray3 {
+  explicit JaggedArray3(int n) : n{n}, data{new int **[n]} {
+    for (int i{0}; i < n; ++i) {
+      data[i] = new int *[n];
+      for (int j{0}; j < n; ++j) {
+        data[i][j] = new int[n];
+        for (int k{0}; k < n; ++k)
+          data[i][j][k] = i + j + k;
+      }
+    }
+  }
+  ~JaggedArray3() {
+    for (int i{0}; i < n; ++i) {
+      for (int j{0}; j < n; ++j)
+        delete[] data[i][j];
+      delete[] data[i];
+    }
+    delete[] data;
+  }
+  int n;
+  int ***data;
+};
+
+template <typename Layout>
+week3::NdArray<int, 3, Layout> make_flat_array(int n) {
+  week3::NdArray<int, 3, Layout> array(n, n, n);
+  for (int i{0}; i < n; ++i)
+    for (int j{0}; j < n; ++j)
+      for (int k{0}; k < n; ++k)
+        array(i, j, k) = i + j + k;
+  return array;
+}
+
+std::vector<std::array<int, 3>> random_indices(int n) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> index{0, n - 1};
+  std::vector<std::array<int, 3>> indices(1 << 16);
+  for (auto &triple : indices)
+    triple = {index(generator), index(generator), index(generator)};
+  return indices;
+}
+
+[[maybe_unused]] const bool nd_array_benchmarks_registered{[] {
+  for (int n : {16, 256}) {
+    std::string suffix{"/n:" + std::to_string(n)};
+    const double items{static_cast<double>(n) * n * n};
+    enpm702::bench::register_benchmark(
+        "ndarray/sweep_jagged_int3ptr" + suffix, [n, items](auto &state) {
+          state.pause_timing();
+          JaggedArray3 array{n};
+          state.resume_timing();
+          state.set_items_per_iteration(items);
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (int i{0}; i < n; ++i)
+              for (int j{0}; j < n; ++j)
+                for (int k{0}; k < n; ++k)
+                  sum += array.data[i][j][k];
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "ndarray/sweep_flat_row_major" + suffix, [n, items](auto &state) {
+          state.pause_timing();
+          auto array{make_flat_array<week3::LayoutRight>(n)};
+          state.resume_timing();
+          state.set_items_per_iteration(items);
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (int i{0}; i < n; ++i)
+              for (int j{0}; j < n; ++j)
+                for (int k{0}; k < n; ++k)
+                  sum += array(i, j, k);
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+    // the same i-j-k loop over a column-major array walks memory with
+    // stride n*n, which shows why the layout must match the loop order
+    enpm702::bench::register_benchmark(
+        "ndarray/sweep_flat_column_major_ijk" + suffix, [n, items](auto &state) {
+          state.pause_timing();
+          auto array{make_flat_array<week3::LayoutLeft>(n)};
+          state.resume_timing();
+          state.set_items_per_iteration(items);
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (int i{0}; i < n; ++i)
+              for (int j{0}; j < n; ++j)
+                for (int k{0}; k < n; ++k)
+                  sum += array(i, j, k);
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+    // random accesses, where each level of the jagged array is one more
+    // dependent load that cannot be hoisted out of the loop
+    enpm702::bench::register_benchmark(
+        "ndarray/gather_random_jagged_int3ptr" + suffix, [n](auto &state) {
+          state.pause_timing();
+          JaggedArray3 array{n};
+          auto indices{random_indices(n)};
+          state.resume_timing();
+          state.set_items_per_iteration(static_cast<double>(indices.size()));
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (const auto &index : indices)
+              sum += array.data[index[0]][index[1]][index[2]];
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "ndarray/gather_random_flat_row_major" + suffix, [n](auto &state) {
+          state.pause_timing();
+          auto array{make_flat_array<week3::LayoutRight>(n)};
+          auto indices{random_indices(n)};
+          state.resume_timing();
+          state.set_items_per_iteration(static_cast<double>(indices.size()));
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (const auto &index : indices)
+              sum += array(index[0], index[1], index[2]);
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+    enpm702::bench::register_benchmark(
+        "ndarray/sweep_strided_view_every_other" + suffix, [n](auto &state) {
+          state.pause_timing();
+          auto array{make_flat_array<week3::LayoutRight>(n)};
+          state.resume_timing();
+          auto view{array.view().slice(0, 0, n, 2).slice(1, 0, n, 2).slice(2, 0, n, 2)};
+          state.set_items_per_iteration(static_cast<double>(view.size()));
+          for (std::uint64_t it{0}; it < state.iterations(); ++it) {
+            long sum{0};
+            for (std::size_t i{0}; i < view.extent(0); ++i)
+              for (std::size_t j{0}; j < view.extent(1); ++j)
+                for (std::size_t k{0}; k < view.extent(2); ++k)
+                  sum += view(i, j, k);
+            do_not_optimize(sum);
+          }
+          state.pause_timing();
+        });
+  }
+  return true;
+}()};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  return enpm702::bench::run_benchmarks(argc, argv);
+}
@@ -7,15 +7,19 @@
  *
  * @copyright Copyright (c) 2025
  *
+ * Run an exercise with `week3_exercise --run <id>` (see `--list`).
  */
 
 #include <iomanip>
 #include <iostream>
 #include <typeinfo> // needed for typeid
 
-int main() {
+#include "snippets.hpp"
 
-  //======== 1
+using enpm702::kSnippetUndefined;
+
+//======== 1
+SNIPPET("1") {
   int a{10};
   int *p{&a};
 
@@ -24,85 +28,103 @@ int main() {
 
   std::cout << a << '\n';  // 20
   std::cout << *p << '\n'; // 20
+}
+
+//======== 2-1
+SNIPPET("2-1") {
+  int a{10};
+  int *p{&a};
+
+  *p *= 2;
 
-  // //======== 2-1
-  // int a{10};
-  // int *p{&a};
-
-  // *p *= 2;
-
-  // std::cout << a << '\n';
-  // std::cout << *p << '\n';
-
-  // //======== 2-2
-  // int a{2};
-  // int *p{&a};
-  // int **q{&p};
-  // int ***r{&q};
-
-  // std::cout << *p << '\n';
-  // std::cout << **q << '\n';
-  // std::cout << ***r << '\n';
-
-  // //======== 3
-  // int a{5};
-  // int b{5};
-
-  // int *p1{&a}; // p1 points to a
-  // int *p2{&b}; // p2 points to b
-  // int *p3{&a}; // p3 points to a
-
-  // std::cout << std::boolalpha; // print bools as true/false
-  // std::cout << (p1 == p2) << '\n';
-  // std::cout << (p1 == p3) << '\n';
-
-  // //======== 4
-  // int a{10};
-  // int b{20};
-
-  // int *p1{&a};
-  // int *p2{&b};
-  // int *p3{&a};
-
-  // std::cout << std::boolalpha; // print bools as true/false
-  // std::cout << (*p1 == *p2) << '\n';
-  // std::cout << (*p1 == *p3) << '\n';
-  // std::cout << (*p1 > *p2) << '\n';
-  // std::cout << (*p1 >= *p2) << '\n';
-  // std::cout << (*p1 < *p2) << '\n';
-  // std::cout << (*p1 <= *p2) << '\n';
-  // std::cout << (*p1 != *p2) << '\n';
-
-  // //======== 5
-  // int a{10};
-  // int b{20};
-
-  // int *p1{&a};
-  // int *p2{&b};
-  // int *p3{&a};
-
-  // // write your code here
-
-  // //======== 6
-  // int *p1{new int{2}};
-  // int *p2{p1};
-
-  // delete p1;
-  // p1 = nullptr;
-
-  // delete p2; // UB
-
-  // //======== 7
-  // int *p1{new int(10)};
-  // int *p2{new int(20)};
-  // int &ref{*p1};
-
-  // ref = *p2;
-  // *p2 = 30;
-  // p1 = new int(40);
-  // delete p2;
-  // *p1 = *p2;
-  // int *p3{p2};
-  // ref = 50;
-  // delete p3;
-}
\ No newline at end of file
+  std::cout << a << '\n';
+  std::cout << *p << '\n';
+}
+
+//======== 2-2
+SNIPPET("2-2") {
+  int a{2};
+  int *p{&a};
+  int **q{&p};
+  int ***r{&q};
+
+  std::cout << *p << '\n';
+  std::cout << **q << '\n';
+  std::cout << ***r << '\n';
+}
+
+//======== 3
+SNIPPET("3") {
+  int a{5};
+  int b{5};
+
+  int *p1{&a}; // p1 points to a
+  int *p2{&b}; // p2 points to b
+  int *p3{&a}; // p3 points to a
+
+  std::cout << std::boolalpha; // print bools as true/false
+  std::cout << (p1 == p2) << '\n';
+  std::cout << (p1 == p3) << '\n';
+}
+
+//======== 4
+SNIPPET("4") {
+  int a{10};
+  int b{20};
+
+  int *p1{&a};
+  int *p2{&b};
+  int *p3{&a};
+
+  std::cout << std::boolalpha; // print bools as true/false
+  std::cout << (*p1 == *p2) << '\n';
+  std::cout << (*p1 == *p3) << '\n';
+  std::cout << (*p1 > *p2) << '\n';
+  std::cout << (*p1 >= *p2) << '\n';
+  std::cout << (*p1 < *p2) << '\n';
+  std::cout << (*p1 <= *p2) << '\n';
+  std::cout << (*p1 != *p2) << '\n';
+}
+
+//======== 5
+SNIPPET("5") {
+  int a{10};
+  int b{20};
+
+  [[maybe_unused]] int *p1{&a};
+  [[maybe_unused]] int *p2{&b};
+  [[maybe_unused]] int *p3{&a};
+
+  // write your code here
+}
+
+//======== 6
+SNIPPET("6", kSnippetUndefined) {
+  int *p1{new int{2}};
+  int *p2{p1};
+
+  delete p1;
+  p1 = nullptr;
+
+  delete p2; // UB
+}
+
+//======== 7
+SNIPPET("7", kSnippetUndefined) {
+  int *p1{new int(10)};
+  int *p2{new int(20)};
+  int &ref{*p1};
+
+  ref = *p2;
+  *p2 = 30;
+  p1 = new int(40);
+  delete p2;
+  *p1 = *p2;
+  int *p3{p2};
+  ref = 50;
+  delete p3;
+}
+
+int main(int argc, char *argv[]) {
+  return enpm702::run_snippets(argc, argv, "1");
+}
@@ -0,0 +1,277 @@
+/**
+ * @file week3_latency.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief What one dereference costs, from L1 to DRAM
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Snippets 1-5 of week3.cpp and `***r` in exercise 2-2 dereference
+ * pointers whose targets sit in L1. Here the targets are spread over
+ * working sets from 4 KiB to 1 GiB:
+ *
+ * - latency/chase: a random cyclic chain of pointers, one per cache line;
+ *   every load depends on the previous one, so ns/iter is the load latency
+ *   of the level the working set fits in;
+ * - latency/chase_hugepages: the same chain on 2 MiB pages, which removes
+ *   most TLB misses from the large sizes;
+ * - latency/gather and latency/gather_prefetch: the same random lines read
+ *   through an index array instead, so the loads are independent and the
+ *   prefetch variant asks for the line 16 accesses ahead;
+ * - bandwidth/read, bandwidth/write: sequential streams over the working
+ *   set, reported as bytes per second.
+ *
+ * Use --filter to pick sizes, e.g. `week3_latency --filter size:64MiB`.
+ */
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+using enpm702::bench::clobber_memory;
+using enpm702::bench::do_not_optimize;
+
+namespace {
+
+constexpr std::size_t kLine{64};
+constexpr std::size_t kHugePage{std::size_t{2} << 20};
+constexpr int kPrefetchDistance{16};
+
+std::string size_name(std::size_t size) {
+  if (size >= (std::size_t{1} << 30))
+    return std::to_string(size >> 30) + "GiB";
+  if (size >= (std::size_t{1} << 20))
+    return std::to_string(size >> 20) + "MiB";
+  return std::to_string(size >> 10) + "KiB";
+}
+
+/**
+ * @brief Anonymous memory backed by 4 KiB or 2 MiB pages
+ *
+ * 2 MiB pages come from the hugetlbfs pool when it has some
+ * (vm.nr_hugepages), else from transparent huge pages.
+ */
+class Buffer {
+ public:
+  /**
+   * @throw std::bad_alloc if the memory cannot be mapped, e.g. under a
+   * memory limit or strict overcommit
+   */
+  Buffer(std::size_t size, bool huge_pages) : size_{size} {
+    if (huge_pages) {
+      size_ = (size + kHugePage - 1) / kHugePage * kHugePage;
+      data_ = map(MAP_HUGETLB);
+      hugetlb_ = data_ != nullptr;
+    }
+    if (!data_)
+      data_ = map(0);
+    if (!data_)
+      throw std::bad_alloc{};
+    if (!hugetlb_)
+      ::madvise(data_, size_, huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+    std::memset(data_, 0, size_);  // fault the pages in before timing
+  }
+
+  Buffer(const Buffer &) = delete;
+  Buffer &operator=(const Buffer &) = delete;
+
+  ~Buffer() {
+    if (data_)
+      ::munmap(data_, size_);
+  }
+
+  std::byte *data() const { return static_cast<std::byte *>(data_); }
+  bool hugetlb() const { return hugetlb_; }
+
+ private:
+  void *map(int flags) const {
+    void *memory{::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0)};
+    return memory == MAP_FAILED ? nullptr : memory;
+  }
+
+  std::size_t size_;
+  void *data_{nullptr};
+  bool hugetlb_{false};
+};
+
+/**
+ * @brief One pointer per cache line, linked into a single random cycle
+ */
+struct Chain {
+  Chain(std::size_t size, bool huge_pages)
+      : buffer{size, huge_pages}, lines{size / kLine}, order(lines) {
+    // Sattolo's algorithm: a random permutation with exactly one cycle
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+    std::mt19937_64 generator{42};
+    for (std::size_t i{lines - 1}; i > 0; --i)
+      std::swap(order[i], order[generator() % i]);
+    for (std::size_t i{0}; i < lines; ++i)
+      *reinterpret_cast<void **>(line(i)) = line(order[i]);
+  }
+
+  std::byte *line(std::size_t index) const { return buffer.data() + index * kLine; }
+
+  Buffer buffer;
+  std::size_t lines;
+  std::vector<std::uint32_t> order;  // order[i] is the line after line i
+};
+
+/**
+ * @brief Construct a T over @p size bytes, or skip the benchmark when the
+ * memory is not available
+ *
+ * @return std::unique_ptr<T> Null after State::skip()
+ */
+template <typename T>
+std::unique_ptr<T> make_or_skip(enpm702::bench::State &state, std::size_t size,
+                                bool huge_pages) {
+  try {
+    return std::make_unique<T>(size, huge_pages);
+  } catch (const std::bad_alloc &) {
+    state.skip("cannot allocate a working set of " + size_name(size));
+    return nullptr;
+  }
+}
+
+/**
+ * @brief The chain of the last benchmark, reused while the size matches
+ *
+ * Building a 1 GiB chain takes seconds, and the harness calls each body
+ * several times; only one chain is kept to bound the memory used.
+ *
+ * @return const Chain* Null after State::skip()
+ */
+const Chain *chain(enpm702::bench::State &state, std::size_t size,
+                   bool huge_pages) {
+  static std::unique_ptr<Chain> cached;
+  static std::size_t cached_size{0};
+  static bool cached_huge_pages{false};
+  if (!cached || cached_size != size || cached_huge_pages != huge_pages) {
+    cached.reset();
+    cached = make_or_skip<Chain>(state, size, huge_pages);
+    cached_size = size;
+    cached_huge_pages = huge_pages;
+  }
+  return cached.get();
+}
+
+void chase(enpm702::bench::State &state, std::size_t size, bool huge_pages) {
+  state.pause_timing();
+  const Chain *chain_or_null{chain(state, size, huge_pages)};
+  if (!chain_or_null)
+    return;
+  const Chain &links{*chain_or_null};
+  state.resume_timing();
+  state.set_counter("hugetlb", links.buffer.hugetlb() ? 1.0 : 0.0);
+  void *p{links.line(0)};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i)
+    p = *static_cast<void **>(p);
+  do_not_optimize(p);
+}
+
+template <bool Prefetch>
+void gather(enpm702::bench::State &state, std::size_t size) {
+  state.pause_timing();
+  const Chain *chain_or_null{chain(state, size, false)};
+  if (!chain_or_null)
+    return;
+  const Chain &links{*chain_or_null};
+  state.resume_timing();
+  const std::uint32_t *order{links.order.data()};
+  const std::size_t lines{links.lines};
+  std::uintptr_t sum{0};
+  std::size_t index{0};
+  for (std::uint64_t i{0}; i < state.iterations(); ++i) {
+    if constexpr (Prefetch) {
+      std::size_t ahead{index + kPrefetchDistance};
+      if (ahead >= lines)
+        ahead -= lines;
+      __builtin_prefetch(links.line(order[ahead]));
+    }
+    sum += *reinterpret_cast<const std::uintptr_t *>(links.line(order[index]));
+    if (++index == lines)
+      index = 0;
+  }
+  do_not_optimize(sum);
+}
+
+void read_bandwidth(enpm702::bench::State &state, std::size_t size) {
+  state.pause_timing();
+  std::unique_ptr<Buffer> buffer_or_null{make_or_skip<Buffer>(state, size, false)};
+  if (!buffer_or_null)
+    return;
+  const Buffer &buffer{*buffer_or_null};
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(size));
+  const auto *words{reinterpret_cast<const std::uint64_t *>(buffer.data())};
+  const std::size_t count{size / sizeof(std::uint64_t)};
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    // four independent sums, so the adds do not limit the stream
+    std::uint64_t sums[4]{};
+    for (std::size_t i{0}; i < count; i += 4) {
+      sums[0] += words[i];
+      sums[1] += words[i + 1];
+      sums[2] += words[i + 2];
+      sums[3] += words[i + 3];
+    }
+    do_not_optimize(sums);
+  }
+  state.pause_timing();
+}
+
+void write_bandwidth(enpm702::bench::State &state, std::size_t size) {
+  state.pause_timing();
+  std::unique_ptr<Buffer> buffer_or_null{make_or_skip<Buffer>(state, size, false)};
+  if (!buffer_or_null)
+    return;
+  const Buffer &buffer{*buffer_or_null};
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(size));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::memset(buffer.data(), static_cast<int>(n), size);
+    clobber_memory();
+  }
+  state.pause_timing();
+}
+
+[[maybe_unused]] const bool registered{[] {
+  using enpm702::bench::register_benchmark;
+  for (std::size_t size{4096}; size <= (std::size_t{1} << 30); size *= 4) {
+    std::string suffix{"/size:" + size_name(size)};
+    register_benchmark("latency/chase" + suffix,
+                       [size](auto &state) { chase(state, size, false); });
+    register_benchmark("latency/gather" + suffix,
+                       [size](auto &state) { gather<false>(state, size); });
+    register_benchmark("latency/gather_prefetch" + suffix,
+                       [size](auto &state) { gather<true>(state, size); });
+    // last, so that the three above share one chain
+    register_benchmark("latency/chase_hugepages" + suffix,
+                       [size](auto &state) { chase(state, size, true); });
+  }
+  for (std::size_t size{4096}; size <= (std::size_t{1} << 30); size *= 4) {
+    std::string suffix{"/size:" + size_name(size)};
+    register_benchmark("bandwidth/read" + suffix,
+                       [size](auto &state) { read_bandwidth(state, size); });
+    register_benchmark("bandwidth/write" + suffix,
+                       [size](auto &state) { write_bandwidth(state, size); });
+  }
+  return true;
+}()};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  return enpm702::bench::run_benchmarks(argc, argv);
+}
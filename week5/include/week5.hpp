@@ -0,0 +1,493 @@
+/**
+ * @file week5.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Bounded lock-free queues and a read -> parse -> aggregate pipeline
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Three bounded queues with the same try_push()/try_pop() interface:
+ *
+ * - SpscRing<T>: one producer thread, one consumer thread. Each side owns
+ *   one index on its own cache line and keeps a cached copy of the other
+ *   side's index, so most operations touch no shared cache line at all;
+ * - MpmcRing<T>: any number of producers and consumers (Dmitry Vyukov's
+ *   bounded queue). Every cell carries a sequence number that tells a
+ *   producer the cell is free and a consumer it is full; a thread claims a
+ *   cell with one compare-and-swap on the shared position;
+ * - MutexQueue<T>: std::queue under a std::mutex, the baseline.
+ *
+ * run_pipeline() wires them into the snippet-28 loop of reading_material
+ * at scale: a reader thread cuts the input into blocks, parser threads turn
+ * blocks into integers, and an aggregator thread keeps the running count,
+ * sum, min and max.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace week5 {
+
+constexpr std::size_t kCacheLine{64};
+
+/**
+ * @brief Smallest power of two >= @p n (and >= 2)
+ */
+constexpr std::size_t round_up_pow2(std::size_t n) {
+  std::size_t size{2};
+  while (size < n)
+    size *= 2;
+  return size;
+}
+
+/**
+ * @brief Bounded single-producer single-consumer ring
+ *
+ * push and pop may run concurrently on one thread each. T must be default
+ * constructible and move assignable.
+ */
+template <typename T>
+class SpscRing {
+ public:
+  /**
+   * @param capacity Rounded up to a power of two
+   */
+  explicit SpscRing(std::size_t capacity)
+      : mask_{round_up_pow2(capacity) - 1}, slots_{std::make_unique<T[]>(mask_ + 1)} {}
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /**
+   * @brief Append @p value unless the ring is full (producer only)
+   */
+  template <typename U>
+  bool try_push(U&& value) {
+    const std::size_t tail{producer_.tail.load(std::memory_order_relaxed)};
+    if (tail - producer_.cached_head > mask_) {
+      // looks full: read the consumer's real position
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.cached_head > mask_)
+        return false;
+    }
+    slots_[tail & mask_] = std::forward<U>(value);
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Move the oldest value into @p value unless the ring is empty
+   * (consumer only)
+   */
+  bool try_pop(T& value) {
+    const std::size_t head{consumer_.head.load(std::memory_order_relaxed)};
+    if (head == consumer_.cached_tail) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cached_tail)
+        return false;
+    }
+    value = std::move(slots_[head & mask_]);
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct alignas(kCacheLine) Producer {
+    std::atomic<std::size_t> tail{0};
+    std::size_t cached_head{0};
+  };
+  struct alignas(kCacheLine) Consumer {
+    std::atomic<std::size_t> head{0};
+    std::size_t cached_tail{0};
+  };
+
+  const std::size_t mask_;
+  std::unique_ptr<T[]> slots_;
+  Producer producer_;
+  Consumer consumer_;
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer ring (Vyukov)
+ *
+ * Cell i of lap k has sequence i + k * capacity while free for a producer
+ * and i + k * capacity + 1 while full for a consumer.
+ */
+template <typename T>
+class MpmcRing {
+ public:
+  explicit MpmcRing(std::size_t capacity)
+      : mask_{round_up_pow2(capacity) - 1}, cells_{std::make_unique<Cell[]>(mask_ + 1)} {
+    for (std::size_t i{0}; i <= mask_; ++i)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  MpmcRing(const MpmcRing&) = delete;
+  MpmcRing& operator=(const MpmcRing&) = delete;
+
+  template <typename U>
+  bool try_push(U&& value) {
+    std::size_t position{enqueue_.position.load(std::memory_order_relaxed)};
+    while (true) {
+      Cell& cell{cells_[position & mask_]};
+      const std::size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+      const auto lag{static_cast<std::ptrdiff_t>(sequence - position)};
+      if (lag == 0) {
+        if (enqueue_.position.compare_exchange_weak(position, position + 1,
+                                                    std::memory_order_relaxed)) {
+          cell.value = std::forward<U>(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // the cell still holds last lap's value: full
+      } else {
+        position = enqueue_.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool try_pop(T& value) {
+    std::size_t position{dequeue_.position.load(std::memory_order_relaxed)};
+    while (true) {
+      Cell& cell{cells_[position & mask_]};
+      const std::size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+      const auto lag{static_cast<std::ptrdiff_t>(sequence - (position + 1))};
+      if (lag == 0) {
+        if (dequeue_.position.compare_exchange_weak(position, position + 1,
+                                                    std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;  // not written yet: empty
+      } else {
+        position = dequeue_.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+  struct alignas(kCacheLine) Position {
+    std::atomic<std::size_t> position{0};
+  };
+
+  const std::size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  Position enqueue_;
+  Position dequeue_;
+};
+
+/**
+ * @brief std::queue under a mutex, bounded like the rings
+ */
+template <typename T>
+class MutexQueue {
+ public:
+  explicit MutexQueue(std::size_t capacity) : capacity_{capacity} {}
+
+  template <typename U>
+  bool try_push(U&& value) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (queue_.size() >= capacity_)
+      return false;
+    queue_.push(std::forward<U>(value));
+    return true;
+  }
+
+  bool try_pop(T& value) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (queue_.empty())
+      return false;
+    value = std::move(queue_.front());
+    queue_.pop();
+    return true;
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+ private:
+  std::mutex mutex_;
+  std::queue<T> queue_;
+  std::size_t capacity_;
+};
+
+/**
+ * @brief Waiting strategy of the blocking helpers: spin briefly, then
+ * give the core away
+ *
+ * Yielding matters whenever the threads outnumber the cores, where pure
+ * spinning would burn the other side's time slice.
+ */
+class Backoff {
+ public:
+  void wait() {
+    if (spins_ < 64) {
+      ++spins_;
+#if defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#endif
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  int spins_{0};
+};
+
+/**
+ * @brief Push, waiting while the queue is full
+ */
+template <typename Queue, typename U>
+void push(Queue& queue, U&& value) {
+  Backoff backoff;
+  while (!queue.try_push(std::forward<U>(value)))
+    backoff.wait();
+}
+
+/**
+ * @brief Pop, waiting while the queue is empty
+ */
+template <typename Queue, typename T>
+void pop(Queue& queue, T& value) {
+  Backoff backoff;
+  while (!queue.try_pop(value))
+    backoff.wait();
+}
+
+/**
+ * @brief Queue used between the pipeline stages
+ */
+enum class QueueKind {
+  kSpsc,   ///< one SpscRing per parser on each side
+  kMpmc,   ///< one MpmcRing shared by the parsers on each side
+  kMutex,  ///< one MutexQueue shared by the parsers on each side
+};
+
+/**
+ * @brief What the aggregator computed, and how long blocks took
+ */
+struct PipelineResult {
+  std::uint64_t count{0};
+  long long sum{0};
+  int min{INT_MAX};
+  int max{INT_MIN};
+  bool error{false};                         ///< a token was not an int
+  std::uint64_t blocks{0};
+  std::chrono::nanoseconds total_latency{0};  ///< read -> aggregated, all blocks
+  std::chrono::nanoseconds max_latency{0};
+};
+
+/**
+ * @brief Settings of run_pipeline()
+ */
+struct PipelineOptions {
+  QueueKind queue{QueueKind::kMpmc};
+  unsigned parsers{2};
+  std::size_t block_size{64 * 1024};  ///< bytes read at a time
+  std::size_t queue_capacity{64};     ///< blocks or batches per queue
+};
+
+namespace detail {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Input text cut at whitespace, so that no number is split; an
+ * empty block ends the stream
+ */
+struct Block {
+  std::string text;
+  Clock::time_point read_at{};
+};
+
+/**
+ * @brief The integers of one block
+ */
+struct Batch {
+  std::vector<int> values;
+  Clock::time_point read_at{};
+  bool last{false};  ///< the parser that sent it has finished
+  bool error{false};
+};
+
+inline bool is_space(char c) { return static_cast<unsigned char>(c) <= ' '; }
+
+inline void parse_block(const Block& block, Batch& batch) {
+  batch.values.clear();
+  batch.read_at = block.read_at;
+  const char* p{block.text.data()};
+  const char* last{p + block.text.size()};
+  while (true) {
+    while (p != last && is_space(*p))
+      ++p;
+    if (p == last)
+      return;
+    int value{};
+    auto [end, ec]{std::from_chars(p, last, value)};
+    if (ec != std::errc{} || (end != last && !is_space(*end))) {
+      batch.error = true;
+      return;
+    }
+    batch.values.push_back(value);
+    p = end;
+  }
+}
+
+/**
+ * @brief The three stages over one queue family
+ *
+ * With SpscRing the reader deals blocks round-robin to one ring per parser
+ * and the aggregator polls one ring per parser; the other queues are
+ * shared by all parsers.
+ */
+template <template <typename> class Queue, bool kPerParser>
+PipelineResult run_pipeline(std::istream& in, const PipelineOptions& options) {
+  const unsigned parsers{std::max(1u, options.parsers)};
+  const std::size_t lanes{kPerParser ? parsers : 1};
+  std::vector<std::unique_ptr<Queue<Block>>> blocks;
+  std::vector<std::unique_ptr<Queue<Batch>>> batches;
+  for (std::size_t i{0}; i < lanes; ++i) {
+    blocks.push_back(std::make_unique<Queue<Block>>(options.queue_capacity));
+    batches.push_back(std::make_unique<Queue<Batch>>(options.queue_capacity));
+  }
+
+  std::thread reader{[&] {
+    std::string carry;  // the start of a number cut by the end of a read
+    std::size_t lane{0};
+    auto send{[&](Block&& block) {
+      push(*blocks[lane], std::move(block));
+      lane = lane + 1 == lanes ? 0 : lane + 1;
+    }};
+    while (in) {
+      Block block;
+      block.text = std::move(carry);
+      carry.clear();
+      const std::size_t kept{block.text.size()};
+      block.text.resize(kept + options.block_size);
+      in.read(block.text.data() + kept, static_cast<std::streamsize>(options.block_size));
+      block.text.resize(kept + static_cast<std::size_t>(in.gcount()));
+      if (in) {
+        std::size_t cut{block.text.size()};
+        while (cut > 0 && !is_space(block.text[cut - 1]))
+          --cut;
+        carry.assign(block.text, cut, std::string::npos);
+        block.text.resize(cut);
+      }
+      if (block.text.empty())
+        continue;
+      block.read_at = Clock::now();
+      send(std::move(block));
+    }
+    for (unsigned i{0}; i < parsers; ++i)
+      send(Block{});  // one end marker for each parser
+  }};
+
+  std::vector<std::thread> parser_threads;
+  for (unsigned p{0}; p < parsers; ++p) {
+    parser_threads.emplace_back([&, p] {
+      Queue<Block>& input{*blocks[kPerParser ? p : 0]};
+      Queue<Batch>& output{*batches[kPerParser ? p : 0]};
+      Block block;
+      while (true) {
+        pop(input, block);
+        Batch batch;
+        if (block.text.empty()) {
+          batch.last = true;
+          push(output, std::move(batch));
+          return;
+        }
+        parse_block(block, batch);
+        push(output, std::move(batch));
+      }
+    });
+  }
+
+  PipelineResult result;
+  unsigned finished{0};
+  Batch batch;
+  Backoff backoff;
+  std::size_t lane{0};
+  while (finished < parsers) {
+    if (!batches[lane]->try_pop(batch)) {
+      lane = lane + 1 == lanes ? 0 : lane + 1;
+      backoff.wait();
+      continue;
+    }
+    backoff = Backoff{};
+    if (batch.last) {
+      ++finished;
+      continue;
+    }
+    result.error |= batch.error;
+    for (int value : batch.values) {
+      result.sum += value;
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+    }
+    result.count += batch.values.size();
+    const auto latency{Clock::now() - batch.read_at};
+    ++result.blocks;
+    result.total_latency += latency;
+    result.max_latency = std::max<std::chrono::nanoseconds>(result.max_latency, latency);
+  }
+
+  reader.join();
+  for (auto& thread : parser_threads)
+    thread.join();
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Count, sum, min and max of the whitespace-separated integers of
+ * @p in, read, parsed and aggregated on separate threads
+ *
+ * The blocks reach the aggregator in any order, which does not change the
+ * result. A token that is not an int sets error; the rest of its block is
+ * skipped.
+ */
+inline PipelineResult run_pipeline(std::istream& in, const PipelineOptions& options = {}) {
+  switch (options.queue) {
+    case QueueKind::kSpsc:
+      return detail::run_pipeline<SpscRing, true>(in, options);
+    case QueueKind::kMpmc:
+      return detail::run_pipeline<MpmcRing, false>(in, options);
+    case QueueKind::kMutex:
+      break;
+  }
+  return detail::run_pipeline<MutexQueue, false>(in, options);
+}
+
+}  // namespace week5
@@ -0,0 +1,132 @@
+/**
+ * @file week5.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Code snippets for lecture 5 on passing data between threads
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Run a snippet with `week5_cpp --run <id>` (see `week5_cpp --list`).
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "snippets.hpp"
+#include "week5.hpp"
+
+using enpm702::kSnippetInteractive;
+
+//======== 1
+// One producer, one consumer: the consumer sees every value, in order
+SNIPPET("1") {
+  week5::SpscRing<int> ring{1024};
+  constexpr int kCount{1000000};
+  std::thread producer{[&ring] {
+    for (int i{1}; i <= kCount; ++i)
+      week5::push(ring, i);
+  }};
+  long long sum{0};
+  bool in_order{true};
+  for (int expected{1}; expected <= kCount; ++expected) {
+    int value{};
+    week5::pop(ring, value);
+    in_order &= value == expected;
+    sum += value;
+  }
+  producer.join();
+  std::cout << "sum: " << sum << ", in order: " << std::boolalpha << in_order << '\n';
+}
+
+//======== 2
+// Four producers, four consumers sharing one MPMC ring: every value is
+// consumed exactly once
+SNIPPET("2") {
+  week5::MpmcRing<int> ring{1024};
+  constexpr int kThreads{4};
+  constexpr int kPerProducer{250000};
+  std::vector<long long> sums(kThreads);
+  std::vector<std::thread> threads;
+  for (int t{0}; t < kThreads; ++t) {
+    threads.emplace_back([&ring, t] {
+      for (int i{1}; i <= kPerProducer; ++i)
+        week5::push(ring, t * kPerProducer + i);
+    });
+    threads.emplace_back([&ring, &sums, t] {
+      for (int i{0}; i < kPerProducer; ++i) {
+        int value{};
+        week5::pop(ring, value);
+        sums[t] += value;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  long long sum{0};
+  for (long long partial : sums)
+    sum += partial;
+  const long long n{kThreads * kPerProducer};
+  std::cout << "sum: " << sum << " (expected " << n * (n + 1) / 2 << ")\n";
+}
+
+namespace {
+void print_result(const char* name, const week5::PipelineResult& result) {
+  std::cout << name << ": " << result.count << " numbers";
+  if (result.count > 0)
+    std::cout << ", sum " << result.sum << ", min " << result.min << ", max " << result.max;
+  if (result.blocks > 0)
+    std::cout << ", mean block latency "
+              << result.total_latency.count() / static_cast<long long>(result.blocks) / 1000 << " us";
+  if (result.error)
+    std::cout << " (stopped a block at a token that is not an int)";
+  std::cout << '\n';
+}
+}  // namespace
+
+//======== 3
+// The read -> parse -> aggregate pipeline on 10^6 generated numbers, with
+// each kind of queue
+SNIPPET("3") {
+  std::ostringstream text;
+  for (int i{0}; i < 1000000; ++i)
+    text << (i * 7919LL % 2001) - 1000 << (i % 10 == 9 ? '\n' : ' ');
+  const std::string numbers{text.str()};
+  const std::pair<const char*, week5::QueueKind> kinds[]{
+      {"spsc", week5::QueueKind::kSpsc},
+      {"mpmc", week5::QueueKind::kMpmc},
+      {"mutex", week5::QueueKind::kMutex},
+  };
+  for (const auto& [name, kind] : kinds) {
+    std::istringstream in{numbers};
+    week5::PipelineOptions options;
+    options.queue = kind;
+    print_result(name, week5::run_pipeline(in, options));
+  }
+}
+
+//======== 3-input
+// The pipeline on the numbers of `--input <file>`, or of stdin
+SNIPPET("3-input", kSnippetInteractive) {
+  week5::PipelineOptions options;
+  options.parsers = std::max(1u, std::thread::hardware_concurrency());
+  if (enpm702::snippet_input().empty()) {
+    print_result("stdin", week5::run_pipeline(std::cin, options));
+    return;
+  }
+  std::ifstream in{std::string{enpm702::snippet_input()}, std::ios::binary};
+  if (!in) {
+    std::cerr << "Cannot read " << enpm702::snippet_input() << '\n';
+    return;
+  }
+  print_result("input", week5::run_pipeline(in, options));
+}
+
+int main(int argc, char* argv[]) {
+  return enpm702::run_snippets(argc, argv);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file week5_bench.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Throughput and latency of the week5 queues and pipeline
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * - queue/<kind>/1p1c: items per second from one producer to one consumer;
+ * - queue/<kind>/4p4c: the same with four of each (MPMC and mutex only);
+ * - queue/<kind>/round_trip: one item sent back and forth through two
+ *   queues; time per iteration is two hand-offs;
+ * - pipeline/<kind>/parsers:N: bytes per second of run_pipeline() over
+ *   8 MB of integers, with the mean block latency as a counter.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "week5.hpp"
+
+using enpm702::bench::do_not_optimize;
+
+namespace {
+
+constexpr std::size_t kCapacity{1024};
+
+template <typename Queue>
+void one_to_one(enpm702::bench::State& state) {
+  state.pause_timing();
+  Queue queue{kCapacity};
+  const auto count{static_cast<long long>(state.iterations())};
+  state.resume_timing();
+  std::thread producer{[&queue, count] {
+    for (long long i{0}; i < count; ++i)
+      week5::push(queue, i);
+  }};
+  long long sum{0};
+  for (long long i{0}; i < count; ++i) {
+    long long value{};
+    week5::pop(queue, value);
+    sum += value;
+  }
+  producer.join();
+  do_not_optimize(sum);
+}
+
+template <typename Queue>
+void many_to_many(enpm702::bench::State& state) {
+  constexpr int kThreads{4};
+  state.pause_timing();
+  Queue queue{kCapacity};
+  const auto per_thread{static_cast<long long>(std::max<std::uint64_t>(1, state.iterations() / kThreads))};
+  state.resume_timing();
+  std::vector<std::thread> threads;
+  for (int t{0}; t < kThreads; ++t) {
+    threads.emplace_back([&queue, per_thread] {
+      for (long long i{0}; i < per_thread; ++i)
+        week5::push(queue, i);
+    });
+    threads.emplace_back([&queue, per_thread] {
+      long long sum{0};
+      for (long long i{0}; i < per_thread; ++i) {
+        long long value{};
+        week5::pop(queue, value);
+        sum += value;
+      }
+      do_not_optimize(sum);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+}
+
+template <typename Queue>
+void round_trip(enpm702::bench::State& state) {
+  state.pause_timing();
+  Queue ping{kCapacity};
+  Queue pong{kCapacity};
+  const auto count{static_cast<long long>(state.iterations())};
+  state.resume_timing();
+  std::thread echo{[&] {
+    long long value{};
+    for (long long i{0}; i < count; ++i) {
+      week5::pop(ping, value);
+      week5::push(pong, value);
+    }
+  }};
+  long long value{0};
+  for (long long i{0}; i < count; ++i) {
+    week5::push(ping, value);
+    week5::pop(pong, value);
+  }
+  echo.join();
+  do_not_optimize(value);
+}
+
+const std::string& pipeline_text() {
+  static const std::string text{[] {
+    std::ostringstream out;
+    for (int i{0}; i < 1200000; ++i)
+      out << (i * 7919LL % 2000001) - 1000000 << (i % 10 == 9 ? '\n' : ' ');
+    return out.str();
+  }()};
+  return text;
+}
+
+void pipeline(enpm702::bench::State& state, week5::QueueKind kind, unsigned parsers) {
+  state.pause_timing();
+  const std::string& text{pipeline_text()};
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(text.size()));
+  week5::PipelineOptions options;
+  options.queue = kind;
+  options.parsers = parsers;
+  double latency_us{0.0};
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    state.pause_timing();
+    std::istringstream in{text};
+    state.resume_timing();
+    week5::PipelineResult result{week5::run_pipeline(in, options)};
+    do_not_optimize(result.sum);
+    latency_us = static_cast<double>(result.total_latency.count()) / 1e3 /
+                 static_cast<double>(std::max<std::uint64_t>(1, result.blocks));
+  }
+  state.set_counter("block_latency_us", latency_us);
+}
+
+[[maybe_unused]] const bool registered{[] {
+  using enpm702::bench::register_benchmark;
+  register_benchmark("queue/spsc/1p1c", [](auto& state) { one_to_one<week5::SpscRing<long long>>(state); });
+  register_benchmark("queue/mpmc/1p1c", [](auto& state) { one_to_one<week5::MpmcRing<long long>>(state); });
+  register_benchmark("queue/mutex/1p1c", [](auto& state) { one_to_one<week5::MutexQueue<long long>>(state); });
+  register_benchmark("queue/mpmc/4p4c", [](auto& state) { many_to_many<week5::MpmcRing<long long>>(state); });
+  register_benchmark("queue/mutex/4p4c", [](auto& state) { many_to_many<week5::MutexQueue<long long>>(state); });
+  register_benchmark("queue/spsc/round_trip", [](auto& state) { round_trip<week5::SpscRing<long long>>(state); });
+  register_benchmark("queue/mpmc/round_trip", [](auto& state) { round_trip<week5::MpmcRing<long long>>(state); });
+  register_benchmark("queue/mutex/round_trip",
+                     [](auto& state) { round_trip<week5::MutexQueue<long long>>(state); });
+
+  const std::pair<const char*, week5::QueueKind> kinds[]{
+      {"spsc", week5::QueueKind::kSpsc},
+      {"mpmc", week5::QueueKind::kMpmc},
+      {"mutex", week5::QueueKind::kMutex},
+  };
+  std::vector<unsigned> parser_counts{1, 2};
+  const unsigned hardware{std::thread::hardware_concurrency()};
+  if (hardware > 2)
+    parser_counts.push_back(hardware);
+  for (const auto& [name, kind] : kinds) {
+    for (unsigned parsers : parser_counts) {
+      register_benchmark(std::string{"pipeline/"} + name + "/parsers:" + std::to_string(parsers),
+                         [kind = kind, parsers](auto& state) { pipeline(state, kind, parsers); });
+    }
+  }
+  return true;
+}()};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  return enpm702::bench::run_benchmarks(argc, argv);
+}
@@ -0,0 +1,513 @@
+/**
+ * @file week6.hpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Work-stealing thread pool with fork/join, parallel_for and
+ * parallel_reduce
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Starting one std::thread per task costs tens of microseconds and leaves
+ * the load balancing to the operating system. ThreadPool starts its
+ * threads once and balances the load itself:
+ *
+ * - every worker owns a Chase-Lev deque: it pushes and pops the tasks it
+ *   spawns at the bottom, without locks, so the most recent (and
+ *   cache-warm) task runs next;
+ * - an idle worker steals the oldest task from the top of a randomly
+ *   chosen victim's deque; in divide-and-conquer code the oldest task is
+ *   the largest piece of work left, so few steals are needed;
+ * - TaskGroup::spawn()/sync() is fork/join: sync() does not block, it runs
+ *   other tasks (its own first) until the group's tasks are done;
+ * - parallel_for() and parallel_reduce() split a range in halves down to a
+ *   grain size, by default range / (8 * threads).
+ *
+ * @code
+ * week6::ThreadPool pool;                      // one thread per core
+ * std::vector<int> table(n * n);
+ * week6::parallel_for(pool, 0, n * n, [&](std::size_t k) {
+ *   table[k] = static_cast<int>((k / n + 1) * (k % n + 1));
+ * });
+ * @endcode
+ *
+ * Threads that are not workers (main()) may spawn and sync too; their
+ * tasks go through one shared queue, and they help run tasks while they
+ * wait, so ThreadPool{n} uses exactly n threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace week6 {
+
+/**
+ * @brief Lock-free work-stealing deque (Chase and Lev, with the memory
+ * orders of Le, Pop, Cohen and Zappa Nardelli)
+ *
+ * The owner thread calls push() and pop(); any thread may call steal().
+ * The array grows when full; old arrays are kept until the deque is
+ * destroyed because a thief may still be reading one.
+ */
+template <typename T>
+class ChaseLevDeque {
+ public:
+  explicit ChaseLevDeque(std::size_t capacity = 256) {
+    arrays_.push_back(std::make_unique<Array>(capacity));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  ChaseLevDeque(const ChaseLevDeque&) = delete;
+  ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+  /**
+   * @brief Add @p item at the bottom (owner only)
+   */
+  void push(T* item) {
+    const std::int64_t bottom{bottom_.load(std::memory_order_relaxed)};
+    const std::int64_t top{top_.load(std::memory_order_acquire)};
+    Array* array{array_.load(std::memory_order_relaxed)};
+    if (bottom - top > static_cast<std::int64_t>(array->mask)) {
+      arrays_.push_back(array->grow(top, bottom));
+      array = arrays_.back().get();
+      array_.store(array, std::memory_order_release);
+    }
+    array->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Take the newest item, or nullptr (owner only)
+   */
+  T* pop() {
+    const std::int64_t bottom{bottom_.load(std::memory_order_relaxed) - 1};
+    Array* array{array_.load(std::memory_order_relaxed)};
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top{top_.load(std::memory_order_relaxed)};
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);  // was empty
+      return nullptr;
+    }
+    T* item{array->get(bottom)};
+    if (top == bottom) {
+      // the last item: race the thieves for it
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        item = nullptr;
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /**
+   * @brief Take the oldest item, or nullptr if the deque is empty or
+   * another thread took it first (any thread)
+   */
+  T* steal() {
+    std::int64_t top{top_.load(std::memory_order_acquire)};
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom{bottom_.load(std::memory_order_acquire)};
+    if (top >= bottom)
+      return nullptr;
+    Array* array{array_.load(std::memory_order_acquire)};
+    T* item{array->get(top)};
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return item;
+  }
+
+  /**
+   * @brief Whether the deque looked empty (a hint)
+   */
+  bool empty() const {
+    return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Array {
+    explicit Array(std::size_t capacity)
+        : mask{capacity - 1}, items{std::make_unique<std::atomic<T*>[]>(capacity)} {}
+
+    T* get(std::int64_t index) const {
+      return items[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+    }
+    void put(std::int64_t index, T* item) {
+      items[static_cast<std::size_t>(index) & mask].store(item, std::memory_order_relaxed);
+    }
+    std::unique_ptr<Array> grow(std::int64_t top, std::int64_t bottom) const {
+      auto bigger{std::make_unique<Array>(2 * (mask + 1))};
+      for (std::int64_t i{top}; i < bottom; ++i)
+        bigger->put(i, get(i));
+      return bigger;
+    }
+
+    std::size_t mask;  // capacity - 1, capacity a power of two
+    std::unique_ptr<std::atomic<T*>[]> items;
+  };
+
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<Array*> array_;
+  std::vector<std::unique_ptr<Array>> arrays_;  // touched by the owner only
+};
+
+class ThreadPool;
+class TaskGroup;
+
+namespace detail {
+
+/**
+ * @brief A spawned function and the group waiting for it
+ */
+struct Task {
+  virtual ~Task() = default;
+  virtual void run() = 0;
+  TaskGroup* group{nullptr};
+};
+
+template <typename F>
+struct FunctionTask final : Task {
+  explicit FunctionTask(F&& f) : function{std::move(f)} {}
+  void run() override { function(); }
+  F function;
+};
+
+/**
+ * @brief The pool and worker index of the calling thread, if it is a worker
+ */
+struct WorkerIdentity {
+  const ThreadPool* pool{nullptr};
+  std::size_t index{0};
+};
+
+inline thread_local WorkerIdentity current_worker;
+
+}  // namespace detail
+
+/**
+ * @brief Fixed set of worker threads that steal work from one another
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param threads Threads that run tasks, counting a thread that waits in
+   * TaskGroup::sync(); 0 means one per core
+   */
+  explicit ThreadPool(unsigned threads = 0)
+      : threads_{threads ? threads : std::max(1u, std::thread::hardware_concurrency())},
+        deques_(threads_ - 1) {
+    for (auto& deque : deques_)
+      deque = std::make_unique<ChaseLevDeque<detail::Task>>();
+    for (std::size_t i{0}; i < deques_.size(); ++i)
+      workers_.emplace_back([this, i] { work(i); });
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{sleep_mutex_};
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_)
+      worker.join();
+  }
+
+  unsigned thread_count() const { return threads_; }
+
+  /**
+   * @brief Tasks taken from another thread's deque since construction
+   */
+  std::uint64_t steal_count() const { return steals_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class TaskGroup;
+
+  /**
+   * @brief Queue @p task on the calling worker's deque, or on the shared
+   * queue for other threads
+   */
+  void submit(detail::Task* task) {
+    const detail::WorkerIdentity& self{detail::current_worker};
+    if (self.pool == this) {
+      deques_[self.index]->push(task);
+    } else {
+      std::lock_guard<std::mutex> lock{injected_mutex_};
+      injected_.push_back(task);
+      injected_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock{sleep_mutex_};
+      wake_.notify_one();
+    }
+  }
+
+  /**
+   * @brief A task for the calling thread: its own newest, else a stolen one
+   */
+  detail::Task* find_task() {
+    const detail::WorkerIdentity& self{detail::current_worker};
+    const bool is_worker{self.pool == this};
+    detail::Task* task{nullptr};
+    if (is_worker)
+      task = deques_[self.index]->pop();
+    if (!task && !deques_.empty()) {
+      // random victims, then the shared queue
+      thread_local std::uint64_t state{
+          0x9e3779b97f4a7c15ULL ^ reinterpret_cast<std::uintptr_t>(&state)};
+      for (std::size_t attempt{0}; attempt < deques_.size() && !task; ++attempt) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const std::size_t victim{static_cast<std::size_t>(state % deques_.size())};
+        if (is_worker && victim == self.index)
+          continue;
+        task = deques_[victim]->steal();
+        if (task)
+          steals_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (!task && injected_size_.load(std::memory_order_relaxed) > 0) {
+      // workers take the oldest task like a thief; other threads take the
+      // newest, as a worker does from its own deque, so a thread waiting in
+      // sync() does not nest the largest tasks on its stack
+      std::lock_guard<std::mutex> lock{injected_mutex_};
+      if (!injected_.empty()) {
+        if (is_worker) {
+          task = injected_.front();
+          injected_.pop_front();
+        } else {
+          task = injected_.back();
+          injected_.pop_back();
+        }
+        injected_size_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    if (task)
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  inline void execute(detail::Task* task);
+
+  void work(std::size_t index) {
+    detail::current_worker = detail::WorkerIdentity{this, index};
+    unsigned idle{0};
+    while (true) {
+      if (detail::Task* task{find_task()}) {
+        execute(task);
+        idle = 0;
+        continue;
+      }
+      if (++idle < 64) {
+        std::this_thread::yield();
+        continue;
+      }
+      // nothing queued anywhere: sleep until submit() or the destructor
+      std::unique_lock<std::mutex> lock{sleep_mutex_};
+      sleeping_.fetch_add(1, std::memory_order_seq_cst);
+      wake_.wait(lock, [this] {
+        return stopping_ || queued_.load(std::memory_order_seq_cst) > 0;
+      });
+      sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+      if (stopping_)
+        return;
+      idle = 0;
+    }
+  }
+
+  const unsigned threads_;
+  std::vector<std::unique_ptr<ChaseLevDeque<detail::Task>>> deques_;
+  std::vector<std::thread> workers_;
+
+  std::mutex injected_mutex_;
+  std::deque<detail::Task*> injected_;
+  std::atomic<std::size_t> injected_size_{0};
+
+  std::atomic<std::int64_t> queued_{0};  // tasks submitted and not yet taken
+  std::atomic<unsigned> sleeping_{0};
+  std::atomic<std::uint64_t> steals_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_{false};
+};
+
+/**
+ * @brief Tasks spawned together and waited for together
+ *
+ * The first exception thrown by a task is rethrown by sync(). The
+ * destructor syncs (and drops the exception) if sync() was not called.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool& pool) : pool_{pool} {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  ~TaskGroup() {
+    try {
+      sync();
+    } catch (...) {
+    }
+  }
+
+  /**
+   * @brief Run @p function on any thread of the pool
+   */
+  template <typename F>
+  void spawn(F&& function) {
+    auto* task{new detail::FunctionTask<std::decay_t<F>>(std::decay_t<F>(std::forward<F>(function)))};
+    task->group = this;
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit(task);
+  }
+
+  /**
+   * @brief Wait for the spawned tasks, running queued tasks meanwhile
+   */
+  void sync() {
+    unsigned idle{0};
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      if (detail::Task* task{pool_.find_task()}) {
+        pool_.execute(task);
+        idle = 0;
+      } else if (++idle > 16) {
+        std::this_thread::yield();
+      }
+    }
+    if (error_) {
+      std::exception_ptr error{std::exchange(error_, nullptr)};
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  friend class ThreadPool;
+
+  void finished(std::exception_ptr error) {
+    if (error) {
+      std::lock_guard<std::mutex> lock{error_mutex_};
+      if (!error_)
+        error_ = error;
+    }
+    pending_.fetch_sub(1, std::memory_order_release);
+  }
+
+  ThreadPool& pool_;
+  std::atomic<std::int64_t> pending_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+inline void ThreadPool::execute(detail::Task* task) {
+  std::exception_ptr error;
+  try {
+    task->run();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  TaskGroup* group{task->group};
+  delete task;
+  group->finished(error);
+}
+
+/**
+ * @brief Grain used when none is given: about eight pieces per thread
+ */
+inline std::size_t default_grain(const ThreadPool& pool, std::size_t count) {
+  return std::max<std::size_t>(1, count / (8 * std::size_t{pool.thread_count()}));
+}
+
+namespace detail {
+
+template <typename Body>
+void parallel_for_range(ThreadPool& pool, std::size_t first, std::size_t last, std::size_t grain,
+                        const Body& body) {
+  TaskGroup group{pool};
+  // hand the upper halves to the pool, keep the lowest piece
+  while (last - first > grain) {
+    const std::size_t middle{first + (last - first) / 2};
+    group.spawn([&pool, middle, last, grain, &body] {
+      parallel_for_range(pool, middle, last, grain, body);
+    });
+    last = middle;
+  }
+  for (std::size_t i{first}; i < last; ++i)
+    body(i);
+  group.sync();
+}
+
+template <typename T, typename Map, typename Combine>
+T parallel_reduce_range(ThreadPool& pool, std::size_t first, std::size_t last, std::size_t grain,
+                        const T& identity, const Map& map, const Combine& combine) {
+  if (last - first <= grain) {
+    T result{identity};
+    for (std::size_t i{first}; i < last; ++i)
+      result = combine(std::move(result), map(i));
+    return result;
+  }
+  const std::size_t middle{first + (last - first) / 2};
+  T upper{identity};
+  TaskGroup group{pool};
+  group.spawn([&] { upper = parallel_reduce_range(pool, middle, last, grain, identity, map, combine); });
+  T lower{parallel_reduce_range(pool, first, middle, grain, identity, map, combine)};
+  group.sync();
+  return combine(std::move(lower), std::move(upper));
+}
+
+}  // namespace detail
+
+/**
+ * @brief body(i) for every i in [first, last), in parallel
+ *
+ * @param grain Indices run serially by one task; 0 picks default_grain()
+ */
+template <typename Body>
+void parallel_for(ThreadPool& pool, std::size_t first, std::size_t last, const Body& body,
+                  std::size_t grain = 0) {
+  if (first >= last)
+    return;
+  if (grain == 0)
+    grain = default_grain(pool, last - first);
+  detail::parallel_for_range(pool, first, last, grain, body);
+}
+
+/**
+ * @brief combine(... combine(identity, map(first)) ..., map(last - 1)),
+ * evaluated as a tree in parallel
+ *
+ * combine must be associative. The tree depends only on the range and the
+ * grain, not on scheduling, so a floating-point sum gives the same result
+ * on every run with the same grain.
+ */
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(ThreadPool& pool, std::size_t first, std::size_t last, T identity, const Map& map,
+                  const Combine& combine, std::size_t grain = 0) {
+  if (first >= last)
+    return identity;
+  if (grain == 0)
+    grain = default_grain(pool, last - first);
+  return detail::parallel_reduce_range(pool, first, last, grain, identity, map, combine);
+}
+
+}  // namespace week6
@@ -0,0 +1,118 @@
+/**
+ * @file week6.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Code snippets for lecture 6 on fork/join parallelism
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Run a snippet with `week6_cpp --run <id>` (see `week6_cpp --list`).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "snippets.hpp"
+#include "week6.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double milliseconds_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::uint64_t fibonacci(week6::ThreadPool& pool, unsigned n) {
+  if (n < 20) {
+    // small problems are cheaper to solve than to spawn
+    std::uint64_t a{0};
+    std::uint64_t b{1};
+    for (unsigned i{0}; i < n; ++i) {
+      std::uint64_t next{a + b};
+      a = b;
+      b = next;
+    }
+    return a;
+  }
+  std::uint64_t x{0};
+  week6::TaskGroup group{pool};
+  group.spawn([&] { x = fibonacci(pool, n - 1); });
+  std::uint64_t y{fibonacci(pool, n - 2)};
+  group.sync();
+  return x + y;
+}
+}  // namespace
+
+//======== 1
+// spawn/sync: the two recursive calls of Fibonacci run in parallel
+SNIPPET("1") {
+  week6::ThreadPool pool;
+  auto start{Clock::now()};
+  std::uint64_t f{fibonacci(pool, 40)};
+  std::cout << "fib(40) = " << f << " on " << pool.thread_count() << " threads in "
+            << milliseconds_since(start) << " ms, " << pool.steal_count() << " steals\n";
+}
+
+//======== 2
+// The multiplication table of reading_material snippet 21, 4096 x 4096,
+// one row per index of parallel_for
+SNIPPET("2") {
+  constexpr std::size_t kSize{4096};
+  std::vector<int> table(kSize * kSize);
+  week6::ThreadPool pool;
+  auto start{Clock::now()};
+  week6::parallel_for(pool, 0, kSize, [&table](std::size_t row) {
+    for (std::size_t column{0}; column < kSize; ++column)
+      table[row * kSize + column] = static_cast<int>((row + 1) * (column + 1));
+  });
+  const double parallel_ms{milliseconds_since(start)};
+  bool correct{true};
+  for (std::size_t row{0}; row < kSize; ++row) {
+    for (std::size_t column{0}; column < kSize; ++column)
+      correct &= table[row * kSize + column] == static_cast<int>((row + 1) * (column + 1));
+  }
+  std::cout << "table[4095][4095] = " << table.back() << ", correct: " << std::boolalpha << correct
+            << ", " << parallel_ms << " ms\n";
+}
+
+//======== 3
+// The nested i * j loop of reading_material snippet 25, 20000 x 20000,
+// summed with parallel_reduce
+SNIPPET("3") {
+  constexpr std::uint64_t kSize{20000};
+  week6::ThreadPool pool;
+  auto start{Clock::now()};
+  std::uint64_t sum{week6::parallel_reduce(
+      pool, 1, kSize + 1, std::uint64_t{0},
+      [](std::size_t i) {
+        std::uint64_t row{0};
+        for (std::uint64_t j{1}; j <= kSize; ++j)
+          row += i * j;
+        return row;
+      },
+      [](std::uint64_t a, std::uint64_t b) { return a + b; })};
+  const double parallel_ms{milliseconds_since(start)};
+  const std::uint64_t triangle{kSize * (kSize + 1) / 2};
+  std::cout << "sum = " << sum << " (expected " << triangle * triangle << "), " << parallel_ms << " ms\n";
+}
+
+//======== 4
+// An exception thrown by a task comes out of sync()
+SNIPPET("4") {
+  week6::ThreadPool pool;
+  week6::TaskGroup group{pool};
+  group.spawn([] { throw std::runtime_error{"task failed"}; });
+  try {
+    group.sync();
+  } catch (const std::exception& error) {
+    std::cout << "caught: " << error.what() << '\n';
+  }
+}
+
+int main(int argc, char* argv[]) {
+  return enpm702::run_snippets(argc, argv);
+}
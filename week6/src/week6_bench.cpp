@@ -0,0 +1,197 @@
+/**
+ * @file week6_bench.cpp
+ * @author Zeid Kootbally (zeidk@umd.edu)
+ * @brief Scaling of the work-stealing pool with the number of threads
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Every parallel benchmark runs with 1, 2, 4, ... threads up to the number
+ * of cores (threads:N), next to a serial version:
+ *
+ * - fork_join/fibonacci: spawn/sync recursion, fib(32) with serial leaves
+ *   below 20, which measures the cost of spawning and stealing;
+ * - nested_loop/table: the multiplication table of reading_material
+ *   snippet 21 at 4096 x 4096, one row per parallel_for index; the
+ *   std_thread_per_block variant starts one std::thread per 64 rows;
+ * - nested_loop/sum_products: the i * j loop of snippet 25 at
+ *   8192 x 8192 with parallel_reduce.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "week6.hpp"
+
+using enpm702::bench::clobber_memory;
+using enpm702::bench::do_not_optimize;
+
+namespace {
+
+constexpr unsigned kFibonacciN{32};
+constexpr unsigned kFibonacciCutoff{20};
+constexpr std::size_t kTableSize{4096};
+constexpr std::uint64_t kProductSize{8192};
+
+std::uint64_t serial_fibonacci(unsigned n) {
+  return n < 2 ? n : serial_fibonacci(n - 1) + serial_fibonacci(n - 2);
+}
+
+std::uint64_t fibonacci(week6::ThreadPool& pool, unsigned n) {
+  if (n < kFibonacciCutoff)
+    return serial_fibonacci(n);
+  std::uint64_t x{0};
+  week6::TaskGroup group{pool};
+  group.spawn([&] { x = fibonacci(pool, n - 1); });
+  std::uint64_t y{fibonacci(pool, n - 2)};
+  group.sync();
+  return x + y;
+}
+
+void fill_row(std::vector<int>& table, std::size_t row) {
+  for (std::size_t column{0}; column < kTableSize; ++column)
+    table[row * kTableSize + column] = static_cast<int>((row + 1) * (column + 1));
+}
+
+// The j of the inner loop come from memory: with a constant bound GCC
+// replaces the loop by i * n * (n + 1) / 2
+const std::vector<std::uint64_t>& columns() {
+  static const std::vector<std::uint64_t> values{[] {
+    std::vector<std::uint64_t> j(kProductSize);
+    for (std::uint64_t k{0}; k < kProductSize; ++k)
+      j[k] = k + 1;
+    return j;
+  }()};
+  return values;
+}
+
+std::uint64_t row_products(std::uint64_t i) {
+  std::uint64_t row{0};
+  for (std::uint64_t j : columns())
+    row += i * j;
+  return row;
+}
+
+void fibonacci_pool(enpm702::bench::State& state, unsigned threads) {
+  state.pause_timing();
+  week6::ThreadPool pool{threads};
+  state.resume_timing();
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::uint64_t f{fibonacci(pool, kFibonacciN)};
+    do_not_optimize(f);
+  }
+  state.pause_timing();  // joining the workers is not part of it
+  state.set_counter("steals", static_cast<double>(pool.steal_count()) / state.iterations());
+}
+
+void table_pool(enpm702::bench::State& state, unsigned threads) {
+  state.pause_timing();
+  week6::ThreadPool pool{threads};
+  std::vector<int> table(kTableSize * kTableSize);
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(table.size() * sizeof(int)));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    week6::parallel_for(pool, 0, kTableSize, [&table](std::size_t row) { fill_row(table, row); });
+    clobber_memory();
+  }
+  state.pause_timing();
+}
+
+void sum_products_pool(enpm702::bench::State& state, unsigned threads) {
+  state.pause_timing();
+  week6::ThreadPool pool{threads};
+  columns();
+  state.resume_timing();
+  state.set_items_per_iteration(static_cast<double>(kProductSize * kProductSize));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::uint64_t sum{week6::parallel_reduce(pool, 1, kProductSize + 1, std::uint64_t{0}, row_products,
+                                             [](std::uint64_t a, std::uint64_t b) { return a + b; })};
+    do_not_optimize(sum);
+  }
+  state.pause_timing();
+}
+
+[[maybe_unused]] const bool registered{[] {
+  using enpm702::bench::register_benchmark;
+  std::vector<unsigned> thread_counts;
+  const unsigned hardware{std::max(1u, std::thread::hardware_concurrency())};
+  for (unsigned threads{1}; threads < hardware; threads *= 2)
+    thread_counts.push_back(threads);
+  thread_counts.push_back(hardware);
+  for (unsigned threads : thread_counts) {
+    const std::string suffix{"/threads:" + std::to_string(threads)};
+    register_benchmark("fork_join/fibonacci" + suffix,
+                       [threads](auto& state) { fibonacci_pool(state, threads); });
+    register_benchmark("nested_loop/table" + suffix,
+                       [threads](auto& state) { table_pool(state, threads); });
+    register_benchmark("nested_loop/sum_products" + suffix,
+                       [threads](auto& state) { sum_products_pool(state, threads); });
+  }
+  return true;
+}()};
+
+}  // namespace
+
+BENCHMARK("fork_join/fibonacci/serial") {
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::uint64_t f{serial_fibonacci(kFibonacciN)};
+    do_not_optimize(f);
+  }
+}
+
+BENCHMARK("nested_loop/table/serial") {
+  state.pause_timing();
+  std::vector<int> table(kTableSize * kTableSize);
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(table.size() * sizeof(int)));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    for (std::size_t row{0}; row < kTableSize; ++row)
+      fill_row(table, row);
+    clobber_memory();
+  }
+  state.pause_timing();
+}
+
+// The baseline the pool replaces: a new thread for each block of rows
+BENCHMARK("nested_loop/table/std_thread_per_block") {
+  constexpr std::size_t kRowsPerThread{64};
+  state.pause_timing();
+  std::vector<int> table(kTableSize * kTableSize);
+  state.resume_timing();
+  state.set_bytes_per_iteration(static_cast<double>(table.size() * sizeof(int)));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::vector<std::thread> threads;
+    for (std::size_t first{0}; first < kTableSize; first += kRowsPerThread) {
+      threads.emplace_back([&table, first] {
+        for (std::size_t row{first}; row < first + kRowsPerThread; ++row)
+          fill_row(table, row);
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    clobber_memory();
+  }
+  state.pause_timing();
+}
+
+BENCHMARK("nested_loop/sum_products/serial") {
+  state.pause_timing();
+  columns();
+  state.resume_timing();
+  state.set_items_per_iteration(static_cast<double>(kProductSize * kProductSize));
+  for (std::uint64_t n{0}; n < state.iterations(); ++n) {
+    std::uint64_t sum{0};
+    for (std::uint64_t i{1}; i <= kProductSize; ++i)
+      sum += row_products(i);
+    do_not_optimize(sum);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  return enpm702::bench::run_benchmarks(argc, argv);
+}